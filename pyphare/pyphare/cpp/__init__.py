@@ -11,12 +11,67 @@ def cpp_lib(override=None):
     if _cpp_lib_override is not None:
         return importlib.import_module(_cpp_lib_override)
 
-    if not __debug__:
-        return importlib.import_module("pybindlibs.cpp")
+    simulator_lib = _simulator_lib()
+    if simulator_lib is not None:
+        return simulator_lib
+
+    for name in (["pybindlibs.cpp_dbg"] if __debug__ else []) + ["pybindlibs.cpp"]:
+        lib = _import_if_built(name)
+        if lib is not None:
+            return lib
+
+    from pyphare.pharein import global_vars
+    # with a simulation, another simulator than its own would be used by mistake
+    if global_vars.sim is None:
+        any_lib = _any_simulator_lib()
+        if any_lib is not None:
+            return any_lib
+        raise ImportError("no PHARE simulator module built in pybindlibs")
+    sim = global_vars.sim
+    raise ImportError(f"neither pybindlibs.cpp nor pybindlibs.cpp_{sim.ndim}_{sim.interp_order}"
+                      " was built")
+
+
+def _simulator_lib():
+    """
+     the module cpp_<dim>_<interp> of the current simulation, built with -DsimulatorLibs=ON
+     instead of the module cpp declaring all simulators, None if there is none
+     only this module is loaded, which is meant for a single simulation per process
+    """
+    from pyphare.pharein import global_vars
+
+    sim = global_vars.sim
+    if sim is None:
+        return None
+    return _import_if_built(f"pybindlibs.cpp_{sim.ndim}_{sim.interp_order}")
+
+
+def _any_simulator_lib():
+    """
+     the first module cpp_<dim>_<interp> built with -DsimulatorLibs=ON, None if there is none
+     for what does not depend on the simulation, e.g. mpi_rank(), before a simulation is set
+     the modules cpp_<dim>_<interp> share these types and functions, declared by cpp_etc
+    """
+    for dim in [1, 2, 3]:
+        for interp in [1, 2, 3]:
+            lib = _import_if_built(f"pybindlibs.cpp_{dim}_{interp}")
+            if lib is not None:
+                return lib
+    return None
+
+
+def _import_if_built(name):
+    """
+     the module, None if it was not built, the errors of a module that fails to import are raised
+    """
+    import importlib
+
     try:
-        return importlib.import_module("pybindlibs.cpp_dbg")
-    except ImportError as err:
-        return importlib.import_module("pybindlibs.cpp")
+        return importlib.import_module(name)
+    except ModuleNotFoundError as err:
+        if err.name != name:
+            raise
+        return None
 
 
 def cpp_etc_lib():
@@ -24,27 +24,29 @@ class DataWrangler:
     def getPatchLevel(self, lvl):
         return self.cpp.getPatchLevel(lvl)
 
-    def _lvl0FullContiguous(self, input, is_primal=True):
-        return self.cpp.sync_merge(input, is_primal)
+    # level wide arrays are assembled on all ranks, or only on the given root rank,
+    #  other ranks then getting empty arrays, which saves the memory of the other copies
+    def _lvl0FullContiguous(self, input, is_primal=True, root=None):
+        return self.cpp.sync_merge(input, is_primal, -1 if root is None else root)
 
-    def lvl0IonDensity(self):
-        return self._lvl0FullContiguous(self.getPatchLevel(0).getDensity())
+    def lvl0IonDensity(self, root=None):
+        return self._lvl0FullContiguous(self.getPatchLevel(0).getDensity(), root=root)
 
-    def lvl0BulkVelocity(self):
+    def lvl0BulkVelocity(self, root=None):
         return {
-            xyz: self._lvl0FullContiguous(bv)
+            xyz: self._lvl0FullContiguous(bv, root=root)
             for xyz, bv in self.getPatchLevel(0).getBulkVelocity().items()
         }
 
-    def lvl0PopDensity(self):
+    def lvl0PopDensity(self, root=None):
         return {
-            pop: self._lvl0FullContiguous(density)
+            pop: self._lvl0FullContiguous(density, root=root)
             for pop, density in self.getPatchLevel(0).getPopDensities().items()
         }
 
-    def lvl0PopFluxes(self):
+    def lvl0PopFluxes(self, root=None):
         return {
-            pop: {xyz: self._lvl0FullContiguous(data) for xyz, data in flux.items()}
+            pop: {xyz: self._lvl0FullContiguous(data, root=root) for xyz, data in flux.items()}
             for pop, flux in self.getPatchLevel(0).getPopFluxes().items()
         }
 
@@ -52,11 +54,11 @@ class DataWrangler:
         """ extract "Ex" from "EM_E_x"  """
         return "".join(em_xyz.split("_"))[2:]
 
-    def lvl0EM(self):
+    def lvl0EM(self, root=None):
         return {
             em: {
-                em_xyz: self.cpp.sync_merge(
-                    data, gridlayout.yee_element_is_primal(self.extract_is_primal_key_from(em_xyz))
+                em_xyz: self._lvl0FullContiguous(
+                    data, gridlayout.yee_element_is_primal(self.extract_is_primal_key_from(em_xyz)), root
                 )
                 for em_xyz, data in xyz_map.items()
             }
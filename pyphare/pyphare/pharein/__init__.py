@@ -24,10 +24,11 @@ if venv_path is not None:
     sys.path = sys.path + pythonpath
 
 
+from . import profiles
 from .uniform_model import UniformModel
 from .maxwellian_fluid_model import MaxwellianFluidModel
 from .electron_model import ElectronModel
-from .diagnostics import FluidDiagnostics, ElectromagDiagnostics, ParticleDiagnostics, MetaDiagnostics
+from .diagnostics import FluidDiagnostics, ElectromagDiagnostics, ParticleDiagnostics, MetaDiagnostics, ReducedDiagnostics
 from .simulation import Simulation, serialize as serialize_sim, deserialize as deserialize_sim
 
 
@@ -46,27 +47,72 @@ def _patch_data_ids(path):
     h5File = cpp_etc_lib().samrai_restart_file(path)
     return h5py.File(h5File, "r")["phare"]["patch"]["ids"][:]
 
-def _serialized_simulation_string(path):
+def _native_restart_file(path):
+    """
+     native restart files are single files per restart time, see src/restarts/detail/h5native.hpp
+    """
+    return os.path.join(path, "restart.h5")
+
+def _native_restart_boxes(path, tag_buffer):
+    """
+     to rebuild the hierarchy of a native restart file, the patches of each refined level
+     give the boxes of the coarser level to refine, shrunk by the tag buffer the refinement
+     adds back
+    """
+    import h5py
+    from pyphare.core.box import Box
+    boxes = {}
+    with h5py.File(_native_restart_file(path), "r") as h5File:
+        ilvl = 1
+        while f"pl{ilvl}" in h5File:
+            level = h5File[f"pl{ilvl}"]
+            boxes[f"L{ilvl-1}"] = []
+            for lower, upper in zip(level["lower"][:], level["upper"][:]):
+                lower, upper = lower // 2, upper // 2
+                shrink = np.minimum(tag_buffer, (upper - lower) // 2)
+                boxes[f"L{ilvl-1}"] += [Box(lower + shrink, upper - shrink)]
+            ilvl += 1
+    return boxes
+
+def _serialized_simulation_string(path, native=False):
     import h5py
     from pyphare.cpp import cpp_etc_lib
-    h5File = cpp_etc_lib().samrai_restart_file(path)
+    h5File = _native_restart_file(path) if native else cpp_etc_lib().samrai_restart_file(path)
     return h5py.File(h5File, "r")["phare"].attrs["serialized_simulation"]
 
 
 # converts scalars to array of expected size
 # converts lists to arrays
 class py_fn_wrapper:
+    # last results, per function and coordinates, shared by the wrappers of a function,
+    #  e.g. when vthx, vthy and vthz are the same function, or for several populations
+    cache = {}
+    cache_size = 8
+
     def __init__(self, fn):
         self.fn = fn
     def __call__(self, *xyz):
         args = []
         for i, arg in enumerate(xyz):
             args.append(np.asarray(arg))
+
+        # the function is kept with its result, so that its id is not reused while cached,
+        #  and the coordinates too, as different coordinates can have the same hash
+        key = (id(self.fn),) + tuple((arg.shape, hash(arg.tobytes())) for arg in args)
+        if key in py_fn_wrapper.cache:
+            fn, coords, ret = py_fn_wrapper.cache[key]
+            if fn is self.fn and all(np.array_equal(a, b) for a, b in zip(coords, args)):
+                return ret
+
         ret = self.fn(*args)
         if isinstance(ret, list):
             ret = np.asarray(ret)
         if is_scalar(ret):
             ret = np.full(len(args[-1]), ret)
+
+        if len(py_fn_wrapper.cache) >= py_fn_wrapper.cache_size:
+            del py_fn_wrapper.cache[next(iter(py_fn_wrapper.cache))]
+        py_fn_wrapper.cache[key] = (self.fn, [arg.copy() for arg in args], ret)
         return ret
 
 # Wrap calls to user init functions to turn C++ vectors to ndarrays,
@@ -87,6 +133,7 @@ def clearDict():
     """
     import pybindlibs.dictator as pp
     pp.stop()
+    py_fn_wrapper.cache.clear()
 
 
 def populateDict():
@@ -107,6 +154,29 @@ def populateDict():
     add_string = pp.add_string
     addInitFunction = getattr(pp, 'addInitFunction{:d}'.format(simulation.ndim)+'D')
 
+    # profiles are evaluated in C++, see src/initializer/init_profiles.hpp
+    def add_profile(path, profile):
+        add_string(path + "/name", profile.name)
+        for key, value in profile.params.items():
+            if key == "terms":
+                add_size_t(path + "/nbr_terms", len(value))
+                for term_idx, term in enumerate(value):
+                    add_profile(path + f"/terms/{term_idx}", term)
+            elif isinstance(value, str):
+                add_string(path + "/" + key, value)
+            elif isinstance(value, int):
+                add_size_t(path + "/" + key, value)
+            elif isinstance(value, list):
+                pp.add_array_as_vector(path + "/" + key, np.asarray(value, dtype=float))
+            else:
+                add_double(path + "/" + key, value)
+
+    def add_init_function(path, fn):
+        if isinstance(fn, profiles.Profile):
+            add_profile(path, fn)
+        else:
+            addInitFunction(path, fn_wrapper(fn))
+
     add_string("simulation/name", "simulation_test")
     add_int("simulation/dimension", simulation.ndim)
     add_string("simulation/boundary_types", simulation.boundary_types[0])
@@ -151,10 +221,10 @@ def populateDict():
 
 
 
-    def as_paths(rb):
-        add_int("simulation/AMR/refinement/boxes/nbr_levels/", len(rb.keys()))
+    def as_paths(rb, boxes_path="simulation/AMR/refinement/boxes/"):
+        add_int(boxes_path + "nbr_levels/", len(rb.keys()))
         for level,boxes in rb.items():
-            level_path = "simulation/AMR/refinement/boxes/"+level+"/"
+            level_path = boxes_path+level+"/"
             add_int(level_path + 'nbr_boxes/',int(len(boxes)))
             for box_i, box in enumerate(boxes):
                 box_id = "B" + str(box_i)
@@ -185,6 +255,10 @@ def populateDict():
         add_string("simulation/AMR/refinement/tagging/method","none") # integrator.h might want some looking at
 
     add_string("simulation/algo/ion_updater/pusher/name", simulation.particle_pusher)
+    add_string("simulation/algo/ion_updater/field_gather", simulation.field_gather)
+    if simulation.population_control is not None:
+        for key, ppc in simulation.population_control.items():
+            add_int("simulation/algo/ion_updater/population_control/" + key, ppc)
     add_double("simulation/algo/ohm/resistivity", simulation.resistivity)
     add_double("simulation/algo/ohm/hyper_resistivity", simulation.hyper_resistivity)
 
@@ -204,18 +278,22 @@ def populateDict():
         add_double(pop_path+"{:d}/mass".format(pop_index), d["mass"])
         add_string(partinit_path+"name", "maxwellian")
 
-        addInitFunction(partinit_path+"density", fn_wrapper(d["density"]))
-        addInitFunction(partinit_path+"bulk_velocity_x", fn_wrapper(d["vx"]))
-        addInitFunction(partinit_path+"bulk_velocity_y", fn_wrapper(d["vy"]))
-        addInitFunction(partinit_path+"bulk_velocity_z", fn_wrapper(d["vz"]))
-        addInitFunction(partinit_path+"thermal_velocity_x",fn_wrapper(d["vthx"]))
-        addInitFunction(partinit_path+"thermal_velocity_y",fn_wrapper(d["vthy"]))
-        addInitFunction(partinit_path+"thermal_velocity_z",fn_wrapper(d["vthz"]))
+        add_init_function(partinit_path+"density", d["density"])
+        add_init_function(partinit_path+"bulk_velocity_x", d["vx"])
+        add_init_function(partinit_path+"bulk_velocity_y", d["vy"])
+        add_init_function(partinit_path+"bulk_velocity_z", d["vz"])
+        add_init_function(partinit_path+"thermal_velocity_x", d["vthx"])
+        add_init_function(partinit_path+"thermal_velocity_y", d["vthy"])
+        add_init_function(partinit_path+"thermal_velocity_z", d["vthz"])
         add_int(partinit_path+"nbr_part_per_cell", d["nbrParticlesPerCell"])
         add_double(partinit_path+"charge", d["charge"])
         add_string(partinit_path+"basis", "cartesian")
         if "init" in d and "seed" in d["init"]:
             pp.add_optional_size_t(partinit_path+"init/seed", d["init"]["seed"])
+        if "init" in d and "rng" in d["init"]:
+            add_string(partinit_path+"init/rng", d["init"]["rng"])
+            add_size_t(partinit_path+"init/population", pop_index)
+            add_size_t(partinit_path+"init/threads", d["init"].get("threads", 1))
 
     add_string("simulation/electromag/name", "EM")
     add_string("simulation/electromag/electric/name", "E")
@@ -223,9 +301,9 @@ def populateDict():
 
     add_string("simulation/electromag/magnetic/name", "B")
     maginit_path = "simulation/electromag/magnetic/initializer/"
-    addInitFunction(maginit_path+"x_component", fn_wrapper(modelDict["bx"]))
-    addInitFunction(maginit_path+"y_component", fn_wrapper(modelDict["by"]))
-    addInitFunction(maginit_path+"z_component", fn_wrapper(modelDict["bz"]))
+    add_init_function(maginit_path+"x_component", modelDict["bx"])
+    add_init_function(maginit_path+"y_component", modelDict["by"])
+    add_init_function(maginit_path+"z_component", modelDict["bz"])
 
 
     #### adding diagnostics
@@ -236,6 +314,35 @@ def populateDict():
         add_string(name_path + "/" + 'type' , diag.type)
         add_string(name_path + "/" + 'quantity' , diag.quantity)
         add_size_t(name_path + "/" + "flush_every", diag.flush_every)
+        for key in ["chunk_size", "deflate", "shuffle"]:
+            if key in diag.compression:
+                add_size_t(name_path + "/" + key, int(diag.compression[key]))
+        if "lossy" in diag.compression:
+            add_string(name_path + "/" + "lossy", diag.compression["lossy"])
+            add_double(name_path + "/" + "lossy_tolerance", diag.compression["lossy_tolerance"])
+        if diag.coarsen_ratio > 1:
+            add_size_t(name_path + "/" + "coarsen_ratio", diag.coarsen_ratio)
+        if not diag.write_ghosts:
+            add_size_t(name_path + "/" + "write_ghosts", 0)
+        selection = getattr(diag, "selection", {})
+        if "stride" in selection:
+            add_size_t(name_path + "/" + "stride", int(selection["stride"]))
+        for key in ["fraction", "min_energy"]:
+            if key in selection:
+                add_double(name_path + "/" + key, float(selection[key]))
+        if "boxes" in selection:
+            add_size_t(name_path + "/" + "nbr_boxes", len(selection["boxes"]))
+            for box_idx, (lower, upper) in enumerate(selection["boxes"]):
+                for dim_idx in range(len(lower)):
+                    add_double(name_path + "/" + f"box_{box_idx}_lower_{dim_idx}", float(lower[dim_idx]))
+                    add_double(name_path + "/" + f"box_{box_idx}_upper_{dim_idx}", float(upper[dim_idx]))
+        for key, value in getattr(diag, "reduction", {}).items():
+            if isinstance(value, str):
+                add_string(name_path + "/" + key, value)
+            elif isinstance(value, int):
+                add_size_t(name_path + "/" + key, value)
+            else:
+                add_double(name_path + "/" + key, value)
         pp.add_array_as_vector(name_path + "/" + "write_timestamps", diag.write_timestamps)
         pp.add_array_as_vector(name_path + "/" + "compute_timestamps", diag.compute_timestamps)
         add_size_t(name_path + "/" + 'n_attributes' , len(diag.attributes))
@@ -244,10 +351,14 @@ def populateDict():
             add_string(name_path + "/" + f'attribute_{attr_idx}_value' , diag.attributes[attr_key])
 
     if len(simulation.diagnostics) > 0:
+        if simulation.diag_options is not None and "format" in simulation.diag_options:
+            add_string(diag_path + "format", simulation.diag_options["format"])
         if simulation.diag_options is not None and "options" in simulation.diag_options:
             add_string(diag_path + "filePath", simulation.diag_options["options"]["dir"])
             if "mode" in simulation.diag_options["options"]:
                 add_string(diag_path + "mode", simulation.diag_options["options"]["mode"])
+            if "async" in simulation.diag_options["options"]:
+                add_int(diag_path + "async", int(simulation.diag_options["options"]["async"]))
             if "fine_dump_lvl_max" in simulation.diag_options["options"]:
                 add_int(diag_path + "fine_dump_lvl_max", simulation.diag_options["options"]["fine_dump_lvl_max"])
         else:
@@ -266,6 +377,10 @@ def populateDict():
         if "dir" in restart_options:
             restart_file_path = restart_options["dir"]
 
+        native = restart_options.get("format", "samrai") == "phareh5"
+        if "format" in restart_options:
+            add_string(restarts_path + "format", restart_options["format"])
+
         if "restart_time" in restart_options:
             from pyphare.cpp import cpp_etc_lib
 
@@ -274,12 +389,19 @@ def populateDict():
 
             if not os.path.exists(restart_file_load_path):
                 raise ValueError(f"PHARE restart file not found for time {restart_time}")
+            if native and not os.path.exists(_native_restart_file(restart_file_load_path)):
+                raise ValueError(f"PHARE native restart file not found for time {restart_time}")
 
-            deserialized_simulation = deserialize_sim(_serialized_simulation_string(restart_file_load_path))
+            deserialized_simulation = deserialize_sim(_serialized_simulation_string(restart_file_load_path, native))
             if not simulation.is_restartable_compared_to(deserialized_simulation):
                 raise ValueError("deserialized Restart simulation is incompatible with configured simulation parameters")
 
-            add_vector_int(restarts_path + "restart_ids", _patch_data_ids(restart_file_load_path))
+            if native: # patches of the file are loaded on any number of ranks
+                if simulation.refinement == "tagging": # else refinement boxes rebuild the levels
+                    boxes = _native_restart_boxes(restart_file_load_path, simulation.tag_buffer)
+                    as_paths(boxes, restarts_path + "boxes/")
+            else:
+                add_vector_int(restarts_path + "restart_ids", _patch_data_ids(restart_file_load_path))
             add_string(restarts_path + "loadPath", restart_file_load_path)
             add_double(restarts_path + "restart_time", restart_time)
 
@@ -291,6 +413,16 @@ def populateDict():
 
         pp.add_array_as_vector(restarts_path + "write_timestamps", restart_options["timestamps"])
 
+        for key in ["elapsed_interval", "time_limit"]:
+            if key in restart_options:
+                add_double(restarts_path + key, restart_options[key])
+        if "keep" in restart_options:
+            add_size_t(restarts_path + "keep", restart_options["keep"])
+        if "async" in restart_options:
+            add_int(restarts_path + "async", int(restart_options["async"]))
+        if "local_dir" in restart_options:
+            add_string(restarts_path + "local_dir", restart_options["local_dir"])
+
         add_string(restarts_path + "serialized_simulation", serialize_sim(simulation))
     #### restarts added
 
@@ -16,7 +16,10 @@ def diagnostics_checker(func):
         if len(missing_mandatory_kwds) > 0:
             raise RuntimeError("Error: missing mandatory parameters : " + ', '.join(missing_mandatory_kwds))
 
-        accepted_keywords = ['path', 'compute_timestamps', 'population_name', 'flush_every']
+        accepted_keywords = ['path', 'compute_timestamps', 'population_name', 'flush_every',
+                             'compression']
+        # keywords that only apply to some diagnostic types
+        accepted_keywords += type(diagnostics_object).type_keywords
         accepted_keywords += mandatory_keywords
 
         # check that all passed keywords are in the accepted keyword list
@@ -38,6 +41,53 @@ def diagnostics_checker(func):
     return wrapper
 
 
+# compression = {"chunk_size": 4096, "deflate": 4, "shuffle": True}
+#  or {"chunk_size": 4096, "lossy": "zfp", "lossy_tolerance": 1e-6}
+#   chunk_size: number of elements of the first dimension of the dataset chunks
+#   deflate: gzip level in [1, 9], shuffle: byte shuffling before deflate
+#   lossy: lossy floating point compressor, "zfp" if PHARE was built with H5Z-ZFP
+#  with several MPI processes, all but chunk_size need the "phareh5_aggregated" format
+#   and a field diagnostic (written collectively), the simulator refuses them otherwise
+def validate_compression(clazz, **kwargs):
+    compression = kwargs.get("compression", {})
+    accepted_keywords = ["chunk_size", "deflate", "shuffle", "lossy", "lossy_tolerance"]
+    wrong_kwds = phare_utilities.not_in_keywords_list(accepted_keywords, **compression)
+    if len(wrong_kwds) > 0:
+        raise RuntimeError(f"Error: {clazz} invalid compression options - " + " ".join(wrong_kwds))
+    if not 0 <= compression.get("deflate", 0) <= 9:
+        raise RuntimeError(f"Error: {clazz} compression deflate level must be in [0, 9]")
+    if "lossy" in compression:
+        if compression["lossy"] not in ["zfp"]:
+            raise RuntimeError(f"Error: {clazz} unknown lossy compressor {compression['lossy']}")
+        if compression.get("lossy_tolerance", 0) <= 0:
+            raise RuntimeError(f"Error: {clazz} lossy compression needs a lossy_tolerance > 0")
+    return compression
+
+
+
+# selection = {"stride": 10} or {"fraction": 0.01, "boxes": [((0., 0.), (5., 5.))],
+#              "min_energy": 2.}, particle diagnostics only
+#   stride: keeps every stride-th particle of each patch
+#   fraction: keeps this fraction of the particles, selected by a hash of their state
+#   boxes: keeps the particles within one of these (lower, upper) physical boxes
+#   min_energy: keeps the particles of kinetic energy above min_energy
+def validate_selection(clazz, ndim, **kwargs):
+    selection = kwargs.get("selection", {})
+    accepted_keywords = ["stride", "fraction", "boxes", "min_energy"]
+    wrong_kwds = phare_utilities.not_in_keywords_list(accepted_keywords, **selection)
+    if len(wrong_kwds) > 0:
+        raise RuntimeError(f"Error: {clazz} invalid selection options - " + " ".join(wrong_kwds))
+    if selection.get("stride", 1) < 1:
+        raise RuntimeError(f"Error: {clazz} selection stride must be >= 1")
+    if not 0 < selection.get("fraction", 1) <= 1:
+        raise RuntimeError(f"Error: {clazz} selection fraction must be in ]0, 1]")
+    for lower, upper in selection.get("boxes", []):
+        if len(lower) != ndim or len(upper) != ndim:
+            raise RuntimeError(f"Error: {clazz} selection boxes need a coordinate per dimension")
+    return selection
+
+
+
 import numpy as np
 # ------------------------------------------------------------------------------
 def validate_timestamps(clazz, **kwargs):
@@ -74,6 +124,7 @@ class Diagnostics(object):
 
     h5_flush_never = 0
     cpp_dep_vers = try_cpp_dep_vers()
+    type_keywords = []
 
     @diagnostics_checker
     def __init__(self, name, **kwargs):
@@ -99,6 +150,13 @@ class Diagnostics(object):
 
         self._setSubTypeAttributes(**kwargs)
         self.flush_every = kwargs.get("flush_every", 1) # flushes every dump, safe, but costly
+        self.compression = validate_compression(self.__class__.__name__, **kwargs)
+
+        # field diagnostics only: physical nodes coarsened by coarsen_ratio, or without ghosts
+        self.coarsen_ratio = int(kwargs.get("coarsen_ratio", 1))
+        self.write_ghosts = bool(kwargs.get("write_ghosts", True))
+        if self.coarsen_ratio < 1:
+            raise RuntimeError(f"{self.__class__.__name__}.coarsen_ratio must be >= 1")
 
         if self.flush_every < 0:
             raise RuntimeError(f"{self.__class__.__name__,}.flush_every cannot be negative")
@@ -119,6 +177,7 @@ class Diagnostics(object):
 class ElectromagDiagnostics(Diagnostics):
 
     em_quantities = ['E', 'B']
+    type_keywords = ['coarsen_ratio', 'write_ghosts']
     type = "electromag"
 
     def __init__(self, **kwargs):
@@ -153,6 +212,7 @@ def population_in_model(population):
 class FluidDiagnostics (Diagnostics):
 
     fluid_quantities = ['density', 'flux', 'bulkVelocity']
+    type_keywords = ['coarsen_ratio', 'write_ghosts']
     type = "fluid"
 
     def __init__(self, **kwargs):
@@ -201,6 +261,7 @@ class FluidDiagnostics (Diagnostics):
 class ParticleDiagnostics(Diagnostics):
 
     particle_quantities = ['space_box', 'domain', 'levelGhost', 'patchGhost']
+    type_keywords = ['selection']
     type = "particle"
 
     def __init__(self, **kwargs):
@@ -227,6 +288,7 @@ class ParticleDiagnostics(Diagnostics):
             raise ValueError("Error: population '{}' not in simulation initial model".format(self.population_name))
 
         self.quantity = "/ions/pop/" + self.population_name + "/" + self.quantity
+        self.selection = validate_selection(self.__class__.__name__, global_vars.sim.ndim, **kwargs)
 
     def space_box(self, **kwargs):
 
@@ -279,3 +341,96 @@ class MetaDiagnostics(Diagnostics):
                 "path": self.path
                }
 
+
+
+
+# ------------------------------------------------------------------------------
+
+
+class ReducedDiagnostics(Diagnostics):
+    """
+    in situ reductions of one level, accumulated over compute_timestamps
+    and written as a single small dataset at each write timestamp
+
+      quantity="histogram"   : weight of the particles of population_name binned along
+                               axes (1 to 3 among x, y, z, vx, vy, vz, energy),
+                               e.g. axes=["vx", "vy"], bins=[64, 64], ranges=[(-4, 4), (-4, 4)]
+      quantity="box_average" : average of field over the cells within box
+      quantity="line_cut"    : field along the line parallel to cut_axis through position
+
+    field: EM_B_x, EM_E_y, density, bulkVelocity_x, <pop>_density, <pop>_flux_x, ...
+    box: (lower, upper) physical coordinates restricting histograms and box averages
+    level: the level reduced, 0 by default
+    label: name of the output file, reduced_<label>.h5, defaults to quantity + index
+    """
+
+    reduced_quantities = ['histogram', 'box_average', 'line_cut']
+    reduction_keywords = ['label', 'axes', 'bins', 'ranges', 'box', 'level', 'field',
+                          'cut_axis', 'position']
+    type_keywords = reduction_keywords
+    histogram_axes = ['x', 'y', 'z', 'vx', 'vy', 'vz', 'energy']
+    type = "reduced"
+
+    def __init__(self, **kwargs):
+        super(ReducedDiagnostics, self).__init__(ReducedDiagnostics.type \
+                                                 + str(global_vars.sim.count_diagnostics(ReducedDiagnostics.type)),
+                                                 **kwargs)
+
+
+    def _setSubTypeAttributes(self, **kwargs):
+        kind = kwargs['quantity']
+        if kind not in ReducedDiagnostics.reduced_quantities:
+            error_msg = "Error: '{}' not a valid reduced diagnostics : " + ', '.join(ReducedDiagnostics.reduced_quantities)
+            raise ValueError(error_msg.format(kind))
+
+        ndim = global_vars.sim.ndim
+        label = kwargs.get("label", kind + str(global_vars.sim.count_diagnostics(ReducedDiagnostics.type)))
+        self.quantity = "/reduced/" + label
+        self.population_name = kwargs.get("population_name", None)
+        self.reduction = {"kind": kind, "level": int(kwargs.get("level", 0))}
+
+        if kind == "histogram":
+            if self.population_name is None or not population_in_model(self.population_name):
+                raise ValueError("Error: histograms need a population_name of the initial model")
+            axes, bins, ranges = [kwargs.get(key, []) for key in ["axes", "bins", "ranges"]]
+            if not 0 < len(axes) <= 3 or not len(axes) == len(bins) == len(ranges):
+                raise ValueError("Error: histograms need 1 to 3 axes, with as many bins and ranges")
+            for axis in axes:
+                if axis not in ReducedDiagnostics.histogram_axes[:ndim] + ReducedDiagnostics.histogram_axes[3:]:
+                    raise ValueError(f"Error: invalid histogram axis {axis}")
+            self.reduction["population_name"] = self.population_name
+            self.reduction["axes"] = ",".join(axes)
+            for i, (nbr_bins, (lower, upper)) in enumerate(zip(bins, ranges)):
+                if nbr_bins <= 0 or lower >= upper:
+                    raise ValueError("Error: histogram bins must be > 0 and ranges increasing")
+                self.reduction.update({f"bins_{i}": int(nbr_bins),
+                                       f"lower_{i}": float(lower), f"upper_{i}": float(upper)})
+        else:
+            if "field" not in kwargs:
+                raise ValueError(f"Error: {kind} needs a field")
+            self.reduction["field"] = kwargs["field"]
+
+        if kind == "line_cut":
+            if kwargs.get("cut_axis", ndim) >= ndim or len(kwargs.get("position", [])) != ndim:
+                raise ValueError("Error: line_cut needs a cut_axis < ndim and a position per dimension")
+            self.reduction["cut_axis"] = int(kwargs["cut_axis"])
+            for i, x in enumerate(kwargs["position"]):
+                self.reduction[f"position_{i}"] = float(x)
+
+        if "box" in kwargs:
+            lower, upper = kwargs["box"]
+            if len(lower) != ndim or len(upper) != ndim:
+                raise ValueError("Error: box needs (lower, upper) with a coordinate per dimension")
+            for i in range(ndim):
+                self.reduction[f"box_lower_{i}"] = float(lower[i])
+                self.reduction[f"box_upper_{i}"] = float(upper[i])
+
+
+    def to_dict(self):
+        return {"name": self.name,
+                "type": ReducedDiagnostics.type,
+                "quantity": self.quantity,
+                "write_timestamps": self.write_timestamps,
+                "compute_timestamps": self.compute_timestamps,
+                "path": self.path,
+                **self.reduction}
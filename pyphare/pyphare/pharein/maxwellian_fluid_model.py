@@ -3,6 +3,7 @@
 from ..core import phare_utilities
 from ..core.gridlayout import yee_element_is_primal
 from . import global_vars
+from . import profiles
 
 
 class MaxwellianFluidModel(object):
@@ -16,12 +17,7 @@ class MaxwellianFluidModel(object):
             has_vargs = params[0].kind == inspect.Parameter.VAR_POSITIONAL
             assert param_per_dim or has_vargs
             return input
-        if self.dim == 1:
-            return lambda x:value + x*0
-        if self.dim == 2:
-            return lambda x,y:value
-        if self.dim == 3:
-            return lambda x,y,z:value
+        return profiles.uniform(value) # evaluated in C++
 
 
     def __init__(self, bx = None,
@@ -97,13 +93,24 @@ class MaxwellianFluidModel(object):
         vbulk       : bulk velocity, tuple of size 3  (default = (0,0,0))
         beta        : beta of the species, float (default = 1)
         anisotropy  : Pperp/Ppara of the species, float (default = 1)
+        init        : particle loading, dict (default = {})
+                      "seed": seed of the random numbers, random if None
+                      "rng": "mt19937" draws the particles of a patch from one generator,
+                             "philox" from counters given by the cell and particle index, so
+                             that particles do not depend on the patches or MPI processes
+                      "threads": number of threads loading a patch with "philox" (default = 1)
+
+        density, velocities and B are python functions of the coordinates, or profiles of
+        pyphare.pharein.profiles, evaluated in C++ without calling python. Defaults are uniform profiles.
         """
 
-        init_keys = ['seed']
+        init_keys = ['seed', 'rng', 'threads']
         wrong_keys = phare_utilities.not_in_keywords_list(init_keys, **init)
         if len(wrong_keys) > 0:
             raise ValueError("Model Error: invalid init arguments - " + " ".join(wrong_keys))
         init["seed"] = init["seed"] if "seed" in init else None
+        if "rng" in init and init["rng"] not in ["mt19937", "philox"]:
+            raise ValueError(f"Model Error: invalid init rng {init['rng']}, valid are mt19937, philox")
 
         density = self.defaulter(density, 1.)
 
@@ -0,0 +1,106 @@
+"""
+ closed form profiles, to use instead of python functions for the density, velocities and
+ magnetic field of a model. They are evaluated in C++ (see src/initializer/init_profiles.hpp)
+ so that initializing patches does not call python, and are also callable from python
+ with the same formula, e.g. for validation or plotting.
+
+    from pyphare.pharein import profiles
+    density = profiles.harris(axis=1, centers=[L * 0.3, L * 0.7], width=0.5, background=0.2)
+    bx      = profiles.harris(axis=1, centers=[L * 0.3, L * 0.7], width=0.5, kind="field", background=-1)
+
+ "axis" is the index of the coordinate a profile depends on, 0 for x, 1 for y, 2 for z.
+ Profiles add with +, giving a "sum" profile.
+"""
+
+import numpy as np
+
+
+class Profile:
+    def __init__(self, name, **params):
+        self.name = name
+        self.params = params
+
+    def __call__(self, *xyz):
+        xyz = [np.asarray(x, dtype=float) for x in xyz]
+        return np.broadcast_to(self.evaluate(xyz), np.broadcast(*xyz).shape).copy()
+
+    def __add__(self, other):
+        return Profile("sum", terms=_terms(self) + _terms(other))
+
+    def evaluate(self, xyz):
+        p = self.params
+        if self.name == "uniform":
+            return np.full(np.broadcast(*xyz).shape, p["value"])
+        if self.name in ["tanh", "cosh"]:
+            u = (xyz[p["axis"]] - p["center"]) / p["width"]
+            shape = np.tanh(u) if self.name == "tanh" else 1. / np.cosh(u)**2
+            return p["offset"] + p["amplitude"] * shape
+        if self.name == "harris":
+            values = np.full(np.broadcast(*xyz).shape, p["background"])
+            for i, center in enumerate(p["centers"]):
+                u = (xyz[p["axis"]] - center) / p["width"]
+                sign = 1 if i % 2 == 0 else -1
+                values = values + p["amplitude"] * (1. / np.cosh(u)**2 if p["kind"] == "density" else sign * np.tanh(u))
+            return values
+        if self.name == "gaussian":
+            exponent = sum(.5 * ((x - c) / s)**2 for x, c, s in zip(xyz, p["center"], p["sigma"]))
+            return p["offset"] + p["amplitude"] * np.exp(-exponent)
+        if self.name == "piecewise":
+            return np.asarray(p["values"])[np.searchsorted(p["bounds"], xyz[p["axis"]], side="right")]
+        if self.name == "sum":
+            return sum(term.evaluate(xyz) for term in p["terms"])
+        raise ValueError(f"unknown profile {self.name}")
+
+
+def _terms(profile):
+    if not isinstance(profile, Profile):
+        raise ValueError("profiles only add with profiles")
+    return profile.params["terms"] if profile.name == "sum" else [profile]
+
+
+def _floats(values):
+    return [float(v) for v in np.atleast_1d(values)]
+
+
+def uniform(value):
+    return Profile("uniform", value=float(value))
+
+
+def tanh(axis, center, width, amplitude=1., offset=0.):
+    """ offset + amplitude * tanh((x - center) / width) """
+    return Profile("tanh", axis=int(axis), center=float(center), width=float(width),
+                   amplitude=float(amplitude), offset=float(offset))
+
+
+def cosh(axis, center, width, amplitude=1., offset=0.):
+    """ offset + amplitude / cosh((x - center) / width)**2 """
+    return Profile("cosh", axis=int(axis), center=float(center), width=float(width),
+                   amplitude=float(amplitude), offset=float(offset))
+
+
+def harris(axis, centers, width, amplitude=1., background=0., kind="density"):
+    """
+     current sheets at centers, background + amplitude * sum of
+       1 / cosh((x - center) / width)**2 for kind "density"
+       +/- tanh((x - center) / width), of alternate signs, for kind "field"
+    """
+    if kind not in ["density", "field"]:
+        raise ValueError(f"harris kind {kind} invalid, valid are density, field")
+    return Profile("harris", axis=int(axis), centers=_floats(centers), width=float(width),
+                   amplitude=float(amplitude), background=float(background), kind=kind)
+
+
+def gaussian(center, sigma, amplitude=1., offset=0.):
+    """ offset + amplitude * exp(-sum_d (x_d - center_d)**2 / (2 sigma_d**2)), per dimension """
+    center, sigma = _floats(center), _floats(sigma)
+    if len(center) != len(sigma):
+        raise ValueError("gaussian center and sigma must have a value per dimension")
+    return Profile("gaussian", center=center, sigma=sigma, amplitude=float(amplitude), offset=float(offset))
+
+
+def piecewise(axis, bounds, values):
+    """ values[i] for bounds[i-1] <= x < bounds[i] """
+    bounds, values = _floats(bounds), _floats(values)
+    if len(values) != len(bounds) + 1 or sorted(bounds) != bounds:
+        raise ValueError("piecewise needs sorted bounds and one more value than bounds")
+    return Profile("piecewise", axis=int(axis), bounds=bounds, values=values)
@@ -1,5 +1,6 @@
 import os
 import numpy as np
+from datetime import timedelta
 
 from ..core import phare_utilities
 from . import global_vars
@@ -137,6 +138,42 @@ def check_pusher(**kwargs):
 # ------------------------------------------------------------------------------
 
 
+def check_field_gather(**kwargs):
+    field_gather = kwargs.get('field_gather', 'staggered')
+    if field_gather not in ['staggered', 'collocated']:
+        raise ValueError('Error: invalid field_gather ({})'.format(field_gather))
+    return field_gather
+
+
+# ------------------------------------------------------------------------------
+
+
+def check_population_control(**kwargs):
+    population_control = kwargs.get('population_control', None)
+    if population_control is None:
+        return None
+
+    valid_keys = ["target_ppc", "min_ppc", "max_ppc"]
+    wrong_keys = [key for key in population_control if key not in valid_keys]
+    if len(wrong_keys) > 0:
+        raise ValueError(f"Error: invalid population_control keys {wrong_keys}, valid keys are {valid_keys}")
+    if "target_ppc" not in population_control:
+        raise ValueError("Error: population_control requires a target_ppc")
+
+    target_ppc = population_control["target_ppc"]
+    min_ppc = population_control.get("min_ppc", 0)
+    max_ppc = population_control.get("max_ppc", 0)
+    if max_ppc > 0 and not 2 <= target_ppc <= max_ppc:
+        raise ValueError("Error: population_control target_ppc must be in [2, max_ppc]")
+    if min_ppc > 0 and target_ppc < min_ppc:
+        raise ValueError("Error: population_control target_ppc must be >= min_ppc")
+
+    return {"target_ppc": target_ppc, "min_ppc": min_ppc, "max_ppc": max_ppc}
+
+
+# ------------------------------------------------------------------------------
+
+
 def check_layout(**kwargs):
     layout = kwargs.get('layout', 'yee')
     if layout not in ('yee'):
@@ -194,9 +231,9 @@ valid_refined_particle_nbr = {
     3: [4, 5, 8, 9, 25]
   },
   3: {
-    1: [6, 7, 8, 9, 12, 13, 14, 15, 18, 19, 20, 21, 26, 27],
-    2: [6, 7, 8, 9, 12, 13, 14, 15, 18, 19, 20, 21, 26, 27, 64],
-    3: [6, 7, 8, 9, 12, 13, 14, 15, 18, 19, 20, 21, 26, 27, 125]
+    1: [8, 27],
+    2: [8, 27],
+    3: [8, 27]
   }
 } # Default refined_particle_nbr per dim/interp is considered index 0 of list
 def check_refined_particle_nbr(ndim, **kwargs):
@@ -357,9 +394,11 @@ def check_patch_size(ndim, **kwargs):
 # ------------------------------------------------------------------------------
 
 # diag_options = {"format":"phareh5", "options": {"dir": "phare_ouputs/"}}
+# "phareh5_aggregated" writes field quantities in one dataset per level instead of per patch
+# options "async": True writes diagnostics from an I/O thread
 def check_diag_options(**kwargs):
     diag_options = kwargs.get("diag_options", None)
-    formats = ["phareh5"]
+    formats = ["phareh5", "phareh5_aggregated"]
     if diag_options is not None and "format" in diag_options:
         if diag_options["format"] not in formats:
             raise ValueError("Error - diag_options format is invalid")
@@ -388,8 +427,22 @@ def check_restart_options(**kwargs):
 
     if restart_options is not None:
 
+        # wall clock triggers, in seconds or datetime.timedelta since the start of the simulation
+        for key in ["elapsed_interval", "time_limit"]:
+            if key in restart_options:
+                value = restart_options[key]
+                if isinstance(value, timedelta):
+                    value = restart_options[key] = value.total_seconds()
+                if value <= 0:
+                    raise ValueError (f"restart_options {key} must be positive")
+
         if "timestamps" not in restart_options:
-            raise ValueError (f"restart_options expects a list of timestamps")
+            if "elapsed_interval" not in restart_options and "time_limit" not in restart_options:
+                raise ValueError (f"restart_options expects a list of timestamps")
+            restart_options["timestamps"] = []
+
+        if int(restart_options.get("keep", 0)) < 0:
+            raise ValueError (f"restart_options keep must be positive, or 0 to keep all restarts")
 
         valid_modes = ["conserve", "overwrite"]
         if "mode" not in restart_options:
@@ -399,6 +452,16 @@ def check_restart_options(**kwargs):
         if mode not in valid_modes:
             raise ValueError (f"Invalid restart mode {mode}, valid modes are {valid_modes}")
 
+        # "phareh5" is a single file per restart time, which can be loaded on any number of ranks
+        valid_formats = ["samrai", "phareh5"]
+        restart_format = restart_options.get("format", "samrai")
+        if restart_format not in valid_formats:
+            raise ValueError (f"Invalid restart format {restart_format}, valid formats are {valid_formats}")
+
+        # restart files of each rank are written to local_dir, e.g. on node local storage
+        if "local_dir" in restart_options and restart_format != "samrai":
+            raise ValueError (f"restart_options local_dir requires the samrai format")
+
     return restart_options
 
 def validate_restart_options(sim):
@@ -487,7 +550,8 @@ def checker(func):
                              'boundary_types', 'refined_particle_nbr', 'path', 'nesting_buffer',
                              'diag_export_format', 'refinement_boxes', 'refinement', 'clustering',
                              'smallest_patch_size', 'largest_patch_size', "diag_options",
-                             'resistivity', 'hyper_resistivity', 'strict', "restart_options", 'tag_buffer', ]
+                             'resistivity', 'hyper_resistivity', 'strict', "restart_options", 'tag_buffer',
+                             'field_gather', 'population_control', ]
 
         accepted_keywords += check_optional_keywords(**kwargs)
 
@@ -514,6 +578,8 @@ def checker(func):
         kwargs["refinement_ratio"] = 2
 
         kwargs["particle_pusher"] = check_pusher(**kwargs)
+        kwargs["field_gather"] = check_field_gather(**kwargs)
+        kwargs["population_control"] = check_population_control(**kwargs)
         kwargs["layout"] = check_layout(**kwargs)
         kwargs["path"] = check_path(**kwargs)
 
@@ -636,6 +702,16 @@ Setting particle parameters:
           1, 2 or 3 (default=1) particle b-spline order
         * *particle_pusher* (``str``) --
           algo to push particles (default = "modifiedBoris")
+        * *field_gather* (``str``) --
+          how E and B are interpolated onto particles (default = "staggered")
+          "collocated" first projects E and B once per step on primal nodes,
+          then gathers all components with a single stencil per particle
+        * *population_control* (``dict``) --
+          keeps the number of particles per cell of each population in bounds (default None)
+          keys are "target_ppc", "max_ppc" and "min_ppc".
+          Cells with more than max_ppc particles are merged down to target_ppc particles,
+          cells with less than min_ppc particles are split up to target_ppc particles.
+          Merging conserves charge, momentum and kinetic energy.
 
 
 Setting diagnostics output parameters:
@@ -647,6 +723,25 @@ Setting diagnostics output parameters:
           type of boundary conditions (default is "periodic" for each direction)
         * *diag_export_format* (``str``)
           format of the output diagnostics (default= "phareh5")
+          "phareh5_aggregated" stores each field quantity of a level in a single dataset,
+          indexed by per patch offsets and shapes, rather than one dataset per patch
+        * *diag_options* (``dict``)
+          {"format": ..., "options": {"dir": ..., "mode": "overwrite", "async": True}}
+          with "async", dumps only copy the data to write, which is written by an I/O thread
+          while the simulation advances. Requires MPI to provide MPI_THREAD_MULTIPLE,
+          dumps are synchronous otherwise
+        * *restart_options* (``dict``)
+          {"dir": ..., "mode": "overwrite", "timestamps": [...], "format": "samrai"}
+          "elapsed_interval": restarts every interval of wall clock time, seconds or timedelta
+          "time_limit": a restart before the job time limit, the time left being less than
+          twice the longest time step
+          "keep": only the last keep restarts written by the run are kept
+          "async": restarts are written while the simulation advances. With the "phareh5"
+          format, the data is copied in memory then written by an I/O thread, which requires
+          MPI_THREAD_MULTIPLE. With the "samrai" format, only the copy from "local_dir" is
+          asynchronous
+          "local_dir": samrai format only, restart files are written to this directory,
+          e.g. node local storage, then copied to "dir"
 
 
 Misc:
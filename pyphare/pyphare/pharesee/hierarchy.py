@@ -45,21 +45,21 @@ class FieldData(PatchData):
 
     @property
     def x(self):
-        withGhost= self.field_name != "tags"
+        withGhost = bool(self.ghosts_nbr.any())
         if self._x is None:
             self._x = self.layout.yeeCoordsFor(self.field_name, "x", withGhosts=withGhost)
         return self._x
 
     @property
     def y(self):
-        withGhosts = self.field_name != "tags"
+        withGhosts = bool(self.ghosts_nbr.any())
         if self._y is None:
             self._y = self.layout.yeeCoordsFor(self.field_name, "y", withGhosts=withGhosts)
         return self._y
 
     @property
     def z(self):
-        withGhosts = self.field_name != "tags"
+        withGhosts = bool(self.ghosts_nbr.any())
         if self._z is None:
             self._z = self.layout.yeeCoordsFor(self.field_name, "z", withGhosts=withGhosts)
         return self._z
@@ -104,6 +104,8 @@ class FieldData(PatchData):
         :param layout: A GridLayout representing the domain on which data is defined
         :param field_name: the name of the field (e.g. "Bx")
         :param data: the dataset from which data can be accessed
+        :param ghosts_nbr: (optional) ghost nodes in the data, those of the layout by default,
+                           0 for fields written without ghosts
         """
         super().__init__(layout, 'field')
         self._x = None
@@ -131,7 +133,9 @@ class FieldData(PatchData):
         else:
             raise ValueError("centering not specified and cannot be inferred from field name")
 
-        if self.field_name != "tags":
+        if "ghosts_nbr" in kwargs:
+            self.ghosts_nbr[:] = kwargs["ghosts_nbr"]
+        elif self.field_name != "tags":
             for i, centering in enumerate(centerings):
                 self.ghosts_nbr[i] = layout.nbrGhosts(layout.interp_order, centering)
 
@@ -1002,11 +1006,74 @@ def is_pop_fluid_file(basename):
 
 
 
-def make_layout(h5_patch_grp, cell_width, interp_order):
+class AggregatedPatchGroup:
+    """
+    presents a patch of a level written with the "phareh5_aggregated" format
+    as a per patch h5 group, with lower/upper/origin attributes and field datasets
+    """
+    def __init__(self, name, attrs, datasets):
+        self.name = name
+        self.attrs = attrs
+        self._datasets = datasets
+
+    def keys(self):
+        return self._datasets.keys()
+
+    def __getitem__(self, key):
+        return self._datasets[key]
+
+
+def patch_groups(h5_lvl_grp):
+    """
+    yields the (patch key, patch group) pairs of a level group
+    level aggregated groups have their patches index table in the "patches" group
+    """
+    if "patches" not in h5_lvl_grp:
+        for pkey in h5_lvl_grp.keys():
+            yield pkey, h5_lvl_grp[pkey]
+        return
+
+    table = h5_lvl_grp["patches"]
+    lowers, uppers, origins = table["lower"][()], table["upper"][()], table["origin"][()]
+    fields = {key: h5_lvl_grp[key][()] for key in h5_lvl_grp.keys() if key != "patches"}
+    offsets = {key: table[key + "_offset"][()] for key in fields}
+    shapes = {key: table[key + "_shape"][()] for key in fields}
+
+    for ipatch in range(lowers.shape[0]):
+        datasets = {}
+        for key, data in fields.items():
+            offset, shape = offsets[key][ipatch], shapes[key][ipatch]
+            datasets[key] = data[offset : offset + np.prod(shape)].reshape(shape)
+        attrs = {"lower": lowers[ipatch], "upper": uppers[ipatch], "origin": origins[ipatch]}
+        pkey = "p{}".format(ipatch)
+        yield pkey, AggregatedPatchGroup(h5_lvl_grp.name + "/" + pkey, attrs, datasets)
+
+
+
+
+def coarsened_box(box, coarsen_ratio):
+    """
+    box of the nodes of a field written with a coarsen_ratio, aligned on the lower
+    cell of the box, the last coarse cell covering what remains of the box
+    """
+    lower = np.asarray(box.lower) // coarsen_ratio
+    nbr_cells = -(-np.asarray(box.shape) // coarsen_ratio)
+    return Box(lower, lower + nbr_cells - 1)
+
+
+
+
+def make_layout(h5_patch_grp, cell_width, interp_order, coarsen_ratio=0):
+    """
+    cell_width is that of the data, i.e. already multiplied by a coarsen_ratio > 1
+    """
     origin = h5_patch_grp.attrs['origin']
     upper = h5_patch_grp.attrs['upper']
     lower = h5_patch_grp.attrs['lower']
-    return GridLayout(Box(lower, upper), origin, cell_width, interp_order=interp_order)
+    box = Box(lower, upper)
+    if coarsen_ratio > 1:
+        box = coarsened_box(box, coarsen_ratio)
+    return GridLayout(box, origin, cell_width, interp_order=interp_order)
 
 
 
@@ -1081,9 +1148,10 @@ def pop_name(basename):
 
 
 
-def add_to_patchdata(patch_datas, h5_patch_grp, basename, layout):
+def add_to_patchdata(patch_datas, h5_patch_grp, basename, layout, field_ghosts=True):
     """
     adds data in the h5_patch_grp in the given PatchData dict
+    field_ghosts is False for field diagnostics written without ghosts
     returns True if valid h5 patch found
     """
 
@@ -1119,7 +1187,10 @@ def add_to_patchdata(patch_datas, h5_patch_grp, basename, layout):
                 raise RuntimeError(
                     "invalid dataset name : {} is not in {}".format(dataset_name, field_qties))
 
-            pdata = FieldData(layout, field_qties[dataset_name], dataset)
+            if field_ghosts:
+                pdata = FieldData(layout, field_qties[dataset_name], dataset)
+            else:
+                pdata = FieldData(layout, field_qties[dataset_name], dataset, ghosts_nbr=0)
 
             pdata_name = field_qties[dataset_name]
 
@@ -1157,6 +1228,14 @@ def hierarchy_fromh5(h5_filename, time, hier, silent=True):
     interp = data_file.attrs["interpOrder"]
     domain_box = Box([0] * len(data_file.attrs["domain_box"]), data_file.attrs["domain_box"])
 
+    # fields of diagnostics with a coarsen_ratio, or without ghosts (a ratio of 1),
+    # hold the physical nodes of the patches, on a mesh coarsened by the ratio
+    coarsen_ratio = int(data_file.attrs.get("coarsen_ratio", 0))
+    if coarsen_ratio > 1:
+        root_cell_width = root_cell_width * coarsen_ratio
+        domain_box = coarsened_box(domain_box, coarsen_ratio)
+    field_ghosts = coarsen_ratio == 0
+
     if create_from_all_times(time, hier):
         # first create from first time
         # then add all other times
@@ -1184,14 +1263,12 @@ def hierarchy_fromh5(h5_filename, time, hier, silent=True):
             lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
             patches = {}
 
-            for pkey in h5_patch_lvl_grp.keys():
-
-                h5_patch_grp = h5_patch_lvl_grp[pkey]
+            for pkey, h5_patch_grp in patch_groups(h5_patch_lvl_grp):
 
                 if patch_has_datasets(h5_patch_grp):
                     patch_datas = {}
-                    layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
-                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout)
+                    layout = make_layout(h5_patch_grp, lvl_cell_width, interp, coarsen_ratio)
+                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout, field_ghosts)
 
                     if ilvl not in patches:
                         patches[ilvl] = []
@@ -1225,22 +1302,19 @@ def hierarchy_fromh5(h5_filename, time, hier, silent=True):
                 ilvl = int(plvl_key[2:])
                 lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
 
-                for ipatch, pkey in enumerate(h5_time_grp[plvl_key].keys()):
-                    h5_patch_grp = h5_time_grp[plvl_key][pkey]
+                for ipatch, (pkey, h5_patch_grp) in enumerate(patch_groups(h5_time_grp[plvl_key])):
 
                     if patch_has_datasets(h5_patch_grp):
                         hier_patch = patch_levels[ilvl].patches[ipatch]
-                        origin = h5_time_grp[plvl_key][pkey].attrs['origin']
-                        upper = h5_time_grp[plvl_key][pkey].attrs['upper']
-                        lower = h5_time_grp[plvl_key][pkey].attrs['lower']
-                        file_patch_box = Box(lower, upper)
+                        origin = h5_patch_grp.attrs['origin']
+                        layout = make_layout(h5_patch_grp, lvl_cell_width, interp, coarsen_ratio)
 
-                        assert file_patch_box == hier_patch.box
+                        assert layout.box == hier_patch.box
                         assert (abs(origin - hier_patch.origin) < 1e-6).all()
                         assert (abs(lvl_cell_width - hier_patch.dl) < 1e-6).all()
 
-                        layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
-                        add_to_patchdata(hier_patch.patch_datas, h5_patch_grp, basename, layout)
+                        add_to_patchdata(hier_patch.patch_datas, h5_patch_grp, basename, layout,
+                                         field_ghosts)
 
             return hier
 
@@ -1258,13 +1332,12 @@ def hierarchy_fromh5(h5_filename, time, hier, silent=True):
             lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
             lvl_patches = []
 
-            for ipatch, pkey in enumerate(h5_time_grp[plvl_key].keys()):
-                h5_patch_grp = h5_time_grp[plvl_key][pkey]
+            for pkey, h5_patch_grp in patch_groups(h5_time_grp[plvl_key]):
 
                 if patch_has_datasets(h5_patch_grp):
-                    layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
+                    layout = make_layout(h5_patch_grp, lvl_cell_width, interp, coarsen_ratio)
                     patch_datas = {}
-                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout)
+                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout, field_ghosts)
                     lvl_patches.append(Patch(patch_datas))
 
             patch_levels[ilvl] = PatchLevel(ilvl, lvl_patches)
@@ -1338,7 +1411,8 @@ def hierarchy_from_sim(simulator, qty, pop=""):
 
 
         if isFieldQty(qty):
-            wpatches = getters[qty]()
+            # copies, the hierarchy keeps the values of this time as the simulation advances
+            wpatches = getters[qty](copy=True)
             for patch in wpatches:
                 patch_datas = {}
                 lower = patch.lower
@@ -161,6 +161,7 @@ class Simulator:
 
     def reset(self):
         if self.cpp_sim is not None:
+            self.cpp_sim.drain() # asynchronous writes are complete, or their errors raised
             import pyphare.pharein as ph
             ph.clearDict()
         if self.cpp_dw is not None:
@@ -0,0 +1,44 @@
+import unittest
+import numpy as np
+
+from pyphare.pharein import py_fn_wrapper
+
+
+class TestPyFnWrapper(unittest.TestCase):
+
+    def setUp(self):
+        py_fn_wrapper.cache.clear()
+        self.calls = 0
+
+        def fn(x):
+            self.calls += 1
+            return 2 * x
+        self.fn = fn
+
+    def test_same_coordinates_are_computed_once(self):
+        x = np.linspace(0, 1, 10)
+        np.testing.assert_array_equal(py_fn_wrapper(self.fn)(x), 2 * x)
+        np.testing.assert_array_equal(py_fn_wrapper(self.fn)(x.copy()), 2 * x)
+        self.assertEqual(self.calls, 1)
+
+    def test_coordinates_with_the_same_key_are_not_mixed_up(self):
+        x, y = np.linspace(0, 1, 10), np.linspace(1, 2, 10)
+        wrapper = py_fn_wrapper(self.fn)
+        wrapper(x)
+
+        # as if the coordinates y had the hash of x
+        (key, (fn, coords, ret)), = py_fn_wrapper.cache.items()
+        py_fn_wrapper.cache.clear()
+        key_of_y = (id(self.fn), (y.shape, hash(y.tobytes())))
+        py_fn_wrapper.cache[key_of_y] = (fn, coords, ret)
+
+        np.testing.assert_array_equal(wrapper(y), 2 * y)
+        self.assertEqual(self.calls, 2)
+
+    def test_scalar_results_are_broadcast(self):
+        x = np.linspace(0, 1, 10)
+        np.testing.assert_array_equal(py_fn_wrapper(lambda x: 1.)(x), np.ones(10))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -67,6 +67,39 @@ if (ubsan)  # -Dubsan=ON
   phare_sanitize_("-fsanitize=undefined" "" )
 endif(ubsan)
 
+if (particleFloats) # -DparticleFloats=ON
+  add_definitions(-DPHARE_PARTICLE_FLOATS=1)
+endif(particleFloats)
+
+if (NOT ndarrayRowPadding EQUAL 1) # -DndarrayRowPadding=8
+  add_definitions(-DPHARE_NDARRAY_ROW_PADDING=${ndarrayRowPadding})
+endif()
+
+# dim_interp of the simulators to build, each being bit (dim - 1) * 3 + interp - 1
+#  of PHARE_SIMULATORS, see core/utilities/meta/meta_utilities.hpp::isSimulatorBuilt
+set (PHARE_ALL_SIMULATORS 1_1 1_2 1_3 2_1 2_2 2_3 3_1 3_2 3_3)
+set (PHARE_BUILT_SIMULATORS ${PHARE_ALL_SIMULATORS})
+if (simulators) # -Dsimulators="1_1;2_1"
+  set (PHARE_BUILT_SIMULATORS ${simulators})
+  set (PHARE_SIMULATORS 0)
+  foreach(simulator ${simulators})
+    if (NOT simulator IN_LIST PHARE_ALL_SIMULATORS)
+      message(FATAL_ERROR "simulators: invalid ${simulator}, valid are ${PHARE_ALL_SIMULATORS}")
+    endif()
+    string(REPLACE "_" ";" dim_interp ${simulator})
+    list(GET dim_interp 0 dim)
+    list(GET dim_interp 1 interp)
+    math(EXPR PHARE_SIMULATORS "${PHARE_SIMULATORS} | (1 << ((${dim} - 1) * 3 + ${interp} - 1))")
+  endforeach()
+  add_definitions(-DPHARE_SIMULATORS=${PHARE_SIMULATORS})
+endif()
+
+# targets using simulators instantiated in phare_simulator, see simulator/simulator.hpp
+set (PHARE_SIMULATOR_FLAGS )
+if (simulatorInstances) # -DsimulatorInstances=OFF
+  set (PHARE_SIMULATOR_FLAGS -DPHARE_EXTERN_SIMULATORS)
+endif()
+
 # msan is not supported - it's not practical to configure - use valgrind
 
 # test functions below
@@ -15,3 +15,7 @@ include("${PHARE_PROJECT_DIR}/res/cmake/dep/pybind.cmake")
 
 # HighFive
 include("${PHARE_PROJECT_DIR}/res/cmake/dep/highfive.cmake")
+
+# H5Z-ZFP, lossy compression filter for diagnostics
+#  enabled with -DH5Z_ZFP_ROOT=/path/to/H5Z-ZFP or -DwithZFP
+include("${PHARE_PROJECT_DIR}/res/cmake/dep/zfp.cmake")
@@ -0,0 +1,16 @@
+#  TO activate lossy zfp compression of diagnostics
+#   configure cmake -DwithZFP=ON, or -DH5Z_ZFP_ROOT=/path/to/H5Z-ZFP/install
+##
+
+if(DEFINED H5Z_ZFP_ROOT)
+  set(withZFP ON)
+endif()
+
+if (withZFP)
+  find_path(H5Z_ZFP_INCLUDE_DIR H5Zzfp.h PATHS ${H5Z_ZFP_ROOT}/include REQUIRED)
+  find_library(H5Z_ZFP_LIBRARY h5zzfp PATHS ${H5Z_ZFP_ROOT}/lib REQUIRED)
+  include_directories(${H5Z_ZFP_INCLUDE_DIR})
+
+  add_definitions(-DPHARE_HAS_H5Z_ZFP=1)
+  set (PHARE_BASE_LIBS ${PHARE_BASE_LIBS} ${H5Z_ZFP_LIBRARY})
+endif()
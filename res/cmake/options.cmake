@@ -63,6 +63,10 @@ option(withIPO "Use IPO/LTO if system supported" OFF)
 option(withCaliper "Use LLNL Caliper" OFF)
 
 
+# -DwithZFP=OFF
+option(withZFP "Use H5Z-ZFP lossy compression for diagnostics" OFF)
+
+
 # -DlowResourceTests=ON
 option(lowResourceTests "Disable heavy tests for CI (2d/3d/etc" OFF)
 
@@ -81,6 +85,27 @@ endif()
 # -Dbench=OFF
 option(bench "Compile PHARE Benchmarks" OFF)
 
+# -DparticleFloats=ON
+option(particleFloats "Store particle deltas and velocities in single precision" OFF)
+# Particle weights, charges and all the arithmetic of the pusher/interpolator stay double
+# see core/data/particles/particle.hpp::ParticlePrecision
+
+# -DndarrayRowPadding=8
+set(ndarrayRowPadding 1 CACHE STRING "Pad field array rows to a multiple of this number of elements")
+# 1 means no padding, 8 doubles fill a 64 bytes cache line / AVX-512 register
+# see core/data/ndarray/ndarray_vector.hpp
+
+# -Dsimulators="1_1;2_1"
+set(simulators "" CACHE STRING "Simulators to build, as dim_interp, all if empty")
+# see core/utilities/meta/meta_utilities.hpp::possibleSimulators
+
+# -DsimulatorInstances=OFF
+option(simulatorInstances "Instantiate the simulators once, in a source per dim_interp" ON)
+
+# -DsimulatorLibs=ON
+option(simulatorLibs "Build a python module per dim_interp, instead of one for all" OFF)
+# see pyphare/pyphare/cpp/__init__.py::cpp_lib
+
 
 # print options
 function(print_phare_options)
@@ -99,6 +124,12 @@ function(print_phare_options)
   message("build with asan support                     : " ${asan})
   message("build with ccache (if found) in devMode     : " ${withCcache})
   message("build with LLNL Caliper                     : " ${withCaliper})
+  message("build with H5Z-ZFP diagnostics compression  : " ${withZFP})
+  message("Store particle deltas/velocities as float   : " ${particleFloats})
+  message("Pad field array rows to a multiple of       : " ${ndarrayRowPadding})
+  message("Simulators to build (all if empty)          : " "${simulators}")
+  message("Instantiate simulators once per dim_interp  : " ${simulatorInstances})
+  message("Build a python module per dim_interp        : " ${simulatorLibs})
 
   if(${devMode})
     message("PHARE_EXEC_LEVEL_MIN                        : " ${PHARE_EXEC_LEVEL_MIN})
@@ -22,6 +22,8 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/core/utilities/index)
   add_subdirectory(tests/core/utilities/indexer)
   add_subdirectory(tests/core/utilities/cellmap)
+  add_subdirectory(tests/core/utilities/async_worker)
+  add_subdirectory(tests/core/utilities/philox)
   #add_subdirectory(tests/core/numerics/boundary_condition)
   add_subdirectory(tests/core/numerics/interpolator)
   add_subdirectory(tests/core/numerics/pusher)
@@ -29,6 +31,7 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/core/numerics/faraday)
   add_subdirectory(tests/core/numerics/ohm)
   add_subdirectory(tests/core/numerics/ion_updater)
+  add_subdirectory(tests/core/numerics/population_control)
 
 
   add_subdirectory(tests/initializer)
@@ -49,6 +52,9 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/amr/tagging)
 
   add_subdirectory(tests/diagnostic)
+  add_subdirectory(tests/diagnostic/reductions)
+  add_subdirectory(tests/diagnostic/field_coarsening)
+  add_subdirectory(tests/hdf5/metadata)
 
 
   add_subdirectory(tests/simulator)
@@ -83,14 +83,17 @@ namespace amr
         {
             Super::getFromRestart(restart_db);
 
-            restart_db->getVector("field_" + field.name(), field.vector());
+            core::unpack(restart_db->getDoubleVector("field_" + field.name()).data(), field);
         }
 
         void putToRestart(std::shared_ptr<SAMRAI::tbox::Database> const& restart_db) const override
         {
             Super::putToRestart(restart_db);
 
-            restart_db->putVector("field_" + field.name(), field.vector());
+            // restart files do not depend on the padding of the field memory
+            auto const key        = "field_" + field.name();
+            auto const contiguous = core::contiguous(field);
+            restart_db->putDoubleArray(key, contiguous.data(), contiguous.size());
         };
 
 
@@ -3,6 +3,8 @@
 
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <numeric>
 #include <stdexcept>
 #include <vector>
@@ -150,13 +152,9 @@ namespace amr
 
                 particles.sortMapping();
 
-                Packer packer(particles);
-                core::ContiguousParticles<dim> soa{particles.size()};
-                packer.pack(soa);
-
-                std::size_t part_idx = 0;
-                core::apply(soa.as_tuple(), [&](auto const& arg) {
-                    restart_db->putVector(name + "_" + packer.keys()[part_idx++], arg);
+                // the database takes whole arrays, only one field is copied at a time
+                Packer{particles}.pack_fields([&](auto const& key, auto const& values) {
+                    restart_db->putVector(name + "_" + key, toRestart_(values));
                 });
             };
 
@@ -197,7 +195,17 @@ namespace amr
                 {
                     std::size_t part_idx = 0;
                     core::apply(soa.as_tuple(), [&](auto& arg) {
-                        restart_db->getVector(name + "_" + Packer::keys()[part_idx++], arg);
+                        auto const key = name + "_" + Packer::keys()[part_idx++];
+                        using Value    = typename std::decay_t<decltype(arg)>::value_type;
+                        if constexpr (std::is_same_v<Value, std::uint64_t>)
+                        {
+                            std::vector<int> words;
+                            restart_db->getVector(key, words);
+                            assert(words.size() * sizeof(int) == arg.size() * sizeof(Value));
+                            std::memcpy(arg.data(), words.data(), arg.size() * sizeof(Value));
+                        }
+                        else
+                            restart_db->getVector(key, arg);
                     });
                 }
 
@@ -445,6 +453,21 @@ namespace amr
         //! end index"
         SAMRAI::hier::Box interiorLocalBox_;
 
+
+        // the restart database has no 64 bits integers, ids are stored as pairs of ints
+        template<typename T>
+        static auto const& toRestart_(std::vector<T> const& values)
+        {
+            return values;
+        }
+
+        static std::vector<int> toRestart_(std::vector<std::uint64_t> const& ids)
+        {
+            std::vector<int> words(ids.size() * sizeof(std::uint64_t) / sizeof(int));
+            std::memcpy(words.data(), ids.data(), ids.size() * sizeof(std::uint64_t));
+            return words;
+        }
+
         void copy_(SAMRAI::hier::Box const& overlapBox, ParticlesData const& sourceData)
         {
             auto myDomainBox         = this->getBox();
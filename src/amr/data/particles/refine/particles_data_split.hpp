@@ -14,6 +14,7 @@
 #include <SAMRAI/hier/RefineOperator.h>
 #include <SAMRAI/pdat/CellOverlap.h>
 
+#include <algorithm>
 #include <functional>
 
 
@@ -165,6 +166,20 @@ namespace amr
 
             Splitter split;
 
+            // new fine patches get all their domain particles from the split of the coarse ones,
+            // at initialization as at regrid. At most all source particles are split: this bound
+            // is reserved at once, growing geometrically as refine_ is called once per source
+            // patch overlapping the destination, rather than counting the split particles first
+            if constexpr (splitType == ParticlesDataSplitType::interior)
+            {
+                auto const maxSize
+                    = destDomainParticles.size()
+                      + nbRefinedPart * (srcInteriorParticles.size() + srcGhostParticles.size());
+                if (maxSize > destDomainParticles.capacity())
+                    destDomainParticles.reserve(
+                        std::max(maxSize, 2 * destDomainParticles.capacity()));
+            }
+
             // The PatchLevelFillPattern had compute boxes that correspond to the expected filling.
             // In case of a coarseBoundary it will most likely give multiple boxes
             // in case of interior, this will be just one box usually
@@ -176,7 +191,6 @@ namespace amr
                 auto isInDest = [&destinationBox](auto const& particle) //
                 { return isInBox(destinationBox, particle); };
 
-
                 for (auto const& sourceParticlesArray : particlesArrays)
                 {
                     for (auto const& particle : *sourceParticlesArray)
@@ -117,7 +117,7 @@ struct Splitter<DimConst<2>, InterpConst<1>, RefinedParticlesConst<8>>
       SplitPattern_2_1_8_Dispatcher
 {
     constexpr Splitter()
-        : SplitPattern_2_1_8_Dispatcher{{1, 2}, {2, 1}}
+        : SplitPattern_2_1_8_Dispatcher{{weight[0], delta[0]}, {weight[1], delta[1]}}
     {
     }
 
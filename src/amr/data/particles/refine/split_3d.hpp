@@ -0,0 +1,208 @@
+/*
+Splitting reference material can be found @
+  https://github.com/PHAREHUB/PHARE/wiki/SplitPattern
+
+The 3D patterns are tensor products of the 1D splits of the same interpolation order, the 3D
+shape functions being the products of the 1D ones: N_particles_8 is the product of three
+N_particles_2 splits, and N_particles_27 of three N_particles_3 splits, their weights being the
+products of the 1D weights, for the center (black), the 6 faces (pink), the 12 edges (lime) and
+the 8 corners (purple) of the cube.
+*/
+
+#ifndef PHARE_SPLIT_3D_HPP
+#define PHARE_SPLIT_3D_HPP
+
+#include <array>
+#include <cstddef>
+#include "core/utilities/point/point.hpp"
+#include "core/utilities/types.hpp"
+#include "splitter.hpp"
+
+namespace PHARE::amr
+{
+using namespace PHARE::core;
+
+/**************************************************************************/
+template<>
+struct PurpleDispatcher<DimConst<3>> : SplitPattern<DimConst<3>, RefinedParticlesConst<8>>
+{
+    using Super = SplitPattern<DimConst<3>, RefinedParticlesConst<8>>;
+
+    constexpr PurpleDispatcher(float const weight, float const delta)
+        : Super{weight}
+    {
+        for (std::size_t i = 0; i < 8; i++)
+            Super::deltas_[i] = {i & 4 ? +delta : -delta, i & 2 ? +delta : -delta,
+                                 i & 1 ? +delta : -delta};
+    }
+};
+
+
+template<>
+struct PinkDispatcher<DimConst<3>> : SplitPattern<DimConst<3>, RefinedParticlesConst<6>>
+{
+    using Super = SplitPattern<DimConst<3>, RefinedParticlesConst<6>>;
+
+    constexpr PinkDispatcher(float const weight, float const delta)
+        : Super{weight}
+    {
+        Super::deltas_[0] = {-delta, 0.0f, 0.0f};
+        Super::deltas_[1] = {+delta, 0.0f, 0.0f};
+        Super::deltas_[2] = {0.0f, -delta, 0.0f};
+        Super::deltas_[3] = {0.0f, +delta, 0.0f};
+        Super::deltas_[4] = {0.0f, 0.0f, -delta};
+        Super::deltas_[5] = {0.0f, 0.0f, +delta};
+    }
+};
+
+
+template<>
+struct LimeDispatcher<DimConst<3>> : SplitPattern<DimConst<3>, RefinedParticlesConst<12>>
+{
+    using Super = SplitPattern<DimConst<3>, RefinedParticlesConst<12>>;
+
+    constexpr LimeDispatcher(float const weight, float const delta)
+        : Super{weight}
+    {
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            float const first  = i & 2 ? +delta : -delta;
+            float const second = i & 1 ? +delta : -delta;
+            Super::deltas_[i]     = {0.0f, first, second};
+            Super::deltas_[i + 4] = {first, 0.0f, second};
+            Super::deltas_[i + 8] = {first, second, 0.0f};
+        }
+    }
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_1_8_Dispatcher = PatternDispatcher<PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<1>, RefinedParticlesConst<8>>
+    : public ASplitter<DimConst<3>, InterpConst<1>, RefinedParticlesConst<8>>,
+      SplitPattern_3_1_8_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_1_8_Dispatcher{{weight[0], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {0.551569};
+    static constexpr std::array<float, 1> weight = {0.125};
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_1_27_Dispatcher
+    = PatternDispatcher<BlackDispatcher<DimConst<3>>, PinkDispatcher<DimConst<3>>,
+                        LimeDispatcher<DimConst<3>>, PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<1>, RefinedParticlesConst<27>>
+    : public ASplitter<DimConst<3>, InterpConst<1>, RefinedParticlesConst<27>>,
+      SplitPattern_3_1_27_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_1_27_Dispatcher{{weight[0]},
+                                         {weight[1], delta[0]},
+                                         {weight[2], delta[0]},
+                                         {weight[3], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {1};
+    static constexpr std::array<float, 4> weight = {0.125, 0.0625, 0.03125, 0.015625};
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_2_8_Dispatcher = PatternDispatcher<PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<2>, RefinedParticlesConst<8>>
+    : public ASplitter<DimConst<3>, InterpConst<2>, RefinedParticlesConst<8>>,
+      SplitPattern_3_2_8_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_2_8_Dispatcher{{weight[0], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {0.663959};
+    static constexpr std::array<float, 1> weight = {0.125};
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_2_27_Dispatcher
+    = PatternDispatcher<BlackDispatcher<DimConst<3>>, PinkDispatcher<DimConst<3>>,
+                        LimeDispatcher<DimConst<3>>, PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<2>, RefinedParticlesConst<27>>
+    : public ASplitter<DimConst<3>, InterpConst<2>, RefinedParticlesConst<27>>,
+      SplitPattern_3_2_27_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_2_27_Dispatcher{{weight[0]},
+                                         {weight[1], delta[0]},
+                                         {weight[2], delta[0]},
+                                         {weight[3], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {1.112033};
+    static constexpr std::array<float, 4> weight = {0.102593, 0.0582794, 0.0331063, 0.0188065};
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_3_8_Dispatcher = PatternDispatcher<PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<3>, RefinedParticlesConst<8>>
+    : public ASplitter<DimConst<3>, InterpConst<3>, RefinedParticlesConst<8>>,
+      SplitPattern_3_3_8_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_3_8_Dispatcher{{weight[0], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {0.752399};
+    static constexpr std::array<float, 1> weight = {0.125};
+};
+
+
+/**************************************************************************/
+using SplitPattern_3_3_27_Dispatcher
+    = PatternDispatcher<BlackDispatcher<DimConst<3>>, PinkDispatcher<DimConst<3>>,
+                        LimeDispatcher<DimConst<3>>, PurpleDispatcher<DimConst<3>>>;
+
+template<>
+struct Splitter<DimConst<3>, InterpConst<3>, RefinedParticlesConst<27>>
+    : public ASplitter<DimConst<3>, InterpConst<3>, RefinedParticlesConst<27>>,
+      SplitPattern_3_3_27_Dispatcher
+{
+    constexpr Splitter()
+        : SplitPattern_3_3_27_Dispatcher{{weight[0]},
+                                         {weight[1], delta[0]},
+                                         {weight[2], delta[0]},
+                                         {weight[3], delta[0]}}
+    {
+    }
+
+    static constexpr std::array<float, 1> delta  = {1.275922};
+    static constexpr std::array<float, 4> weight = {0.106458, 0.0590819, 0.0327891, 0.0181973};
+};
+
+
+/**************************************************************************/
+
+
+} // namespace PHARE::amr
+
+
+#endif /*PHARE_SPLIT_3D_H*/
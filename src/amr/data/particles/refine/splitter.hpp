@@ -12,6 +12,7 @@
 #include <cstddef>
 #include "core/utilities/types.hpp"
 #include "core/utilities/point/point.hpp"
+#include "core/data/particles/particle.hpp"
 #include "amr/amr_constants.hpp"
 
 namespace PHARE::amr
@@ -63,6 +64,8 @@ private:
 
         using FineParticle = decltype(particles[0]); // may be a reference
 
+        // the ids of the fine particles are the same whoever splits the coarse one
+        std::uint64_t iFine = 0;
         core::apply(patterns, [&](auto const& pattern) {
             for (size_t rpIndex = 0; rpIndex < pattern.deltas_.size(); rpIndex++)
             {
@@ -72,6 +75,7 @@ private:
                 fineParticle.iCell  = particle.iCell;
                 fineParticle.delta  = particle.delta;
                 fineParticle.v      = particle.v;
+                fineParticle.id     = core::derivedParticleId(particle.id, iFine++);
 
                 for (size_t iDim = 0; iDim < dimension; iDim++)
                 {
@@ -130,6 +134,10 @@ template<typename dim>
 struct PinkDispatcher
 {
 };
+template<typename dim>
+struct LimeDispatcher
+{
+};
 
 } // namespace PHARE::amr
 
@@ -60,10 +60,20 @@ namespace solver
             auto& hybMessenger = dynamic_cast<HybridMessenger&>(messenger);
 
 
+            // a restart file covers the whole root level, which is then not initialized from the
+            // user functions, while restored fine levels are first initialized from the coarser
+            // level for the cells the restart file may not cover
+            bool restored = false;
+
             if (isRootLevel(levelNumber))
             {
                 PHARE_LOG_START("hybridLevelInitializer::initialize : root level init");
-                model.initialize(level);
+                if (hybridModel.restartLoader)
+                    restored = hybridModel.restartLoader(level);
+                if (restored)
+                    hybridModel.resourcesManager->registerForRestarts(hybridModel);
+                else
+                    model.initialize(level);
                 messenger.fillRootGhosts(model, level, initDataTime);
                 PHARE_LOG_STOP("hybridLevelInitializer::initialize : root level init");
             }
@@ -78,9 +88,22 @@ namespace solver
                 }
                 else
                 {
+                    // only the root level is loaded from the init functions, new finer levels
+                    // get their particles from the split of the coarser level ones, and their
+                    // fields from its refinement
                     PHARE_LOG_START("hybridLevelInitializer::initialize : initlevel");
                     messenger.initLevel(model, level, initDataTime);
                     PHARE_LOG_STOP("hybridLevelInitializer::initialize : initlevel");
+
+                    if (hybridModel.restartLoader and hybridModel.restartLoader(level))
+                    {
+                        restored = true;
+                        auto& ions = hybridModel.state.ions;
+                        auto& EM   = hybridModel.state.electromag;
+                        hybMessenger.fillMagneticGhosts(EM.B, levelNumber, initDataTime);
+                        hybMessenger.fillElectricGhosts(EM.E, levelNumber, initDataTime);
+                        hybMessenger.fillIonGhostParticles(ions, level, initDataTime);
+                    }
                     messenger.prepareStep(model, level, initDataTime);
                 }
             }
@@ -129,6 +152,10 @@ namespace solver
 
 
 
+                // the restored electric field is kept as it was written
+                if (restored)
+                    return;
+
                 auto& electrons = hybridModel.state.electrons;
                 auto& E         = hybridModel.state.electromag.E;
 
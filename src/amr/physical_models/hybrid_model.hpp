@@ -5,6 +5,9 @@
 #define PHARE_HYBRID_MODEL_HPP
 
 #include <string>
+#include <memory>
+#include <vector>
+#include <functional>
 
 #include "initializer/data_provider.hpp"
 #include "core/models/hybrid_state.hpp"
@@ -100,6 +103,13 @@ public:
     //-------------------------------------------------------------------------
 
     std::unordered_map<std::string, std::shared_ptr<core::NdArrayVector<dimension, int>>> tags;
+
+    /**
+     * @brief restartLoader, if set, restores the electromagnetic field and the domain particles
+     * of a level being initialized from a restart file. It returns false if the file holds no
+     * data for this level. It is only set while the hierarchy is initialized.
+     */
+    std::function<bool(level_t&)> restartLoader;
 };
 
 
@@ -114,23 +124,44 @@ template<typename GridLayoutT, typename Electromag, typename Ions, typename Elec
          typename AMR_Types>
 void HybridModel<GridLayoutT, Electromag, Ions, Electrons, AMR_Types>::initialize(level_t& level)
 {
+    // init functions are evaluated once for all the patches of the level, not once per patch
+    std::vector<gridlayout_type> layouts;
+    using MagneticCoords = decltype(state.electromag.initCoordinates(layouts.front()));
+    std::vector<MagneticCoords> magneticCoords;
+    for (auto& patch : level)
+    {
+        auto const& layout = layouts.emplace_back(amr::layoutFromPatch<gridlayout_type>(*patch));
+        auto _             = this->resourcesManager->setOnPatch(*patch, state.electromag);
+        magneticCoords.push_back(state.electromag.initCoordinates(layout));
+    }
+    state.electromag.prefetch(magneticCoords);
+
+    auto& ions = state.ions;
+    std::vector<std::unique_ptr<typename ParticleInitializerFactory::ParticleInitializerT>>
+        particleInitializers;
+    for (auto& pop : ions)
+    {
+        auto const& info = pop.particleInitializerInfo();
+        particleInitializers.emplace_back(ParticleInitializerFactory::create(info));
+        particleInitializers.back()->prefetch(layouts);
+    }
+
+    std::size_t iPatch = 0;
     for (auto& patch : level)
     {
         // first initialize the ions
-        auto layout = amr::layoutFromPatch<gridlayout_type>(*patch);
-        auto& ions  = state.ions;
-        auto _      = this->resourcesManager->setOnPatch(*patch, state.electromag, state.ions);
+        auto const& layout = layouts[iPatch++];
+        auto _ = this->resourcesManager->setOnPatch(*patch, state.electromag, state.ions);
 
+        std::size_t iPop = 0;
         for (auto& pop : ions)
-        {
-            auto const& info         = pop.particleInitializerInfo();
-            auto particleInitializer = ParticleInitializerFactory::create(info);
-            particleInitializer->loadParticles(pop.domainParticles(), layout);
-        }
+            particleInitializers[iPop++]->loadParticles(pop.domainParticles(), layout);
 
         state.electromag.initialize(layout);
     }
 
+    state.electromag.prefetch(std::vector<MagneticCoords>{}); // releases the values
+
 
     resourcesManager->registerForRestarts(*this);
 }
@@ -5,7 +5,9 @@
 #include "core/data/grid/gridlayoutdefs.hpp"
 #include "core/data/vecfield/vecfield_component.hpp"
 #include "core/data/ndarray/ndarray_vector.hpp"
+#include <cmath>
 #include <cstddef>
+#include <algorithm>
 
 
 namespace PHARE::amr
@@ -123,6 +125,39 @@ void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
             }
         }
     }
+    if constexpr (dimension == 3)
+    {
+        auto const& [start_y, __]
+            = layout.physicalStartToEnd(PHARE::core::QtyCentering::dual, PHARE::core::Direction::Y);
+        auto const& [start_z, ___]
+            = layout.physicalStartToEnd(PHARE::core::QtyCentering::dual, PHARE::core::Direction::Z);
+
+        auto const& end_y = layout.nbrCells()[1] - 1;
+        auto const& end_z = layout.nbrCells()[2] - 1;
+
+        // the criterion of 2D, with the differences along z
+        for (auto iTag_x = 0u, ix = start_x; iTag_x <= end_x; ++ix, ++iTag_x)
+        {
+            for (auto iTag_y = 0u, iy = start_y; iTag_y <= end_y; ++iy, ++iTag_y)
+            {
+                for (auto iTag_z = 0u, iz = start_z; iTag_z <= end_z; ++iz, ++iTag_z)
+                {
+                    auto field_diff = [&](auto const& F) //
+                    {
+                        auto const F0 = F(ix, iy, iz);
+                        return std::max(
+                            {std::abs((F(ix + 2, iy, iz) - F0) / (1 + F(ix + 1, iy, iz) - F0)),
+                             std::abs((F(ix, iy + 2, iz) - F0) / (1 + F(ix, iy + 1, iz) - F0)),
+                             std::abs((F(ix, iy, iz + 2) - F0) / (1 + F(ix, iy, iz + 1) - F0))});
+                    };
+
+                    auto crit = std::max({field_diff(Bx), field_diff(By), field_diff(Bz)});
+
+                    tagsv(iTag_x, iTag_y, iTag_z) = crit > threshold ? 1 : 0;
+                }
+            }
+        }
+    }
 }
 } // namespace PHARE::amr
 
@@ -98,6 +98,13 @@ void HybridTagger<HybridModel>::tag(PHARE::solver::IPhysicalModel<amr_t>& model,
                 }
             }
         }
+        if constexpr (HybridModel::dimension == 3)
+        {
+            for (auto iTag_x = 0u; iTag_x < nbrCells[0]; ++iTag_x)
+                for (auto iTag_y = 0u; iTag_y < nbrCells[1]; ++iTag_y)
+                    for (auto iTag_z = 0u; iTag_z < nbrCells[2]; ++iTag_z)
+                        tagsv(iTag_x, iTag_y, iTag_z) = tagsvF(iTag_x, iTag_y, iTag_z);
+        }
     }
     else
         throw std::runtime_error("invalid tagging strategy");
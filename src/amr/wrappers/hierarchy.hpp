@@ -43,7 +43,11 @@ public:
         {
             auto& dict = sim_dict["simulation"]["restarts"];
 
-            if (dict.contains("loadPath"))
+            // native restart files are not SAMRAI restart files, see restarts/detail/h5native
+            bool const samraiFormat = !dict.contains("format")
+                                      or dict["format"].template to<std::string>() == "samrai";
+
+            if (samraiFormat and dict.contains("loadPath"))
             {
                 auto restart_manager = SAMRAI::tbox::RestartManager::getManager();
                 auto pdrm            = SAMRAI::hier::PatchDataRestartManager::getManager();
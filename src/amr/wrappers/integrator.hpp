@@ -57,6 +57,11 @@ template<std::size_t dimension>
 std::shared_ptr<SAMRAI::tbox::MemoryDatabase>
 getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr);
 
+template<std::size_t dimension>
+std::shared_ptr<SAMRAI::tbox::MemoryDatabase>
+getRestartRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr,
+                                  PHARE::initializer::PHAREDict const& restartBoxes);
+
 
 
 
@@ -71,7 +76,14 @@ Integrator<_dimension>::Integrator(
     auto loadBalancer = std::make_shared<SAMRAI::mesh::TreeLoadBalancer>(
         SAMRAI::tbox::Dimension{dimension}, "LoadBalancer");
 
-    auto refineDB    = getUserRefinementBoxesDatabase<dimension>(dict["simulation"]["AMR"]);
+    auto refineDB = getUserRefinementBoxesDatabase<dimension>(dict["simulation"]["AMR"]);
+
+    // levels restored from a native restart file are first built from the boxes of the file
+    if (dict["simulation"].contains("restarts")
+        and dict["simulation"]["restarts"].contains("boxes"))
+        refineDB = getRestartRefinementBoxesDatabase<dimension>(
+            dict["simulation"]["AMR"], dict["simulation"]["restarts"]["boxes"]);
+
     auto standardTag = std::make_shared<SAMRAI::mesh::StandardTagAndInitialize>(
         "StandardTagAndInitialize", tagAndInitStrategy.get(), refineDB);
 
@@ -121,6 +133,57 @@ Integrator<_dimension>::Integrator(
 
 
 
+/*
+ * puts in db the boxes of boxesDict, L# being the boxes of level # to refine:
+ *   boxesDict["L#"]["nbr_boxes"], boxesDict["L#"]["B#"]["lower"/"upper"]["x"/"y"/"z"]
+ */
+template<std::size_t dimension>
+void putLevelBoxes(SAMRAI::tbox::Database& db, PHARE::initializer::PHAREDict const& boxesDict,
+                   int maxLevelNumber)
+{
+    for (int levelNumber = 0; levelNumber < maxLevelNumber; ++levelNumber)
+    {
+        // not all levels are necessarily specified for refinement
+        // cppdict will throw when trying to access key L{i} with i = levelNumber
+        std::string levelString{"L" + std::to_string(levelNumber)};
+        if (boxesDict.contains(levelString))
+        {
+            auto& levelDict = boxesDict[levelString];
+            auto samraiDim  = SAMRAI::tbox::Dimension{dimension};
+            auto nbrBoxes   = levelDict["nbr_boxes"].template to<int>();
+            auto levelDB    = db.putDatabase("level_" + std::to_string(levelNumber));
+
+            std::vector<SAMRAI::tbox::DatabaseBox> dbBoxes;
+            for (int iBox = 0; iBox < nbrBoxes; ++iBox)
+            {
+                int lower[dimension];
+                int upper[dimension];
+                auto& boxDict = levelDict["B" + std::to_string(iBox)];
+
+                lower[0] = boxDict["lower"]["x"].template to<int>();
+                upper[0] = boxDict["upper"]["x"].template to<int>();
+
+                if constexpr (dimension >= 2)
+                {
+                    lower[1] = boxDict["lower"]["y"].template to<int>();
+                    upper[1] = boxDict["upper"]["y"].template to<int>();
+                }
+
+                if constexpr (dimension == 3)
+                {
+                    lower[2] = boxDict["lower"]["z"].template to<int>();
+                    upper[2] = boxDict["upper"]["z"].template to<int>();
+                }
+
+                dbBoxes.push_back(SAMRAI::tbox::DatabaseBox(samraiDim, lower, upper));
+            }
+            levelDB->putDatabaseBoxVector("boxes", dbBoxes);
+        }
+    }
+}
+
+
+
 template<std::size_t dimension>
 std::shared_ptr<SAMRAI::tbox::MemoryDatabase>
 getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr)
@@ -141,47 +204,7 @@ getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr)
         std::cout << "tagging method is set to REFINE_BOXES\n";
         refinementBoxesDatabase->putString("tagging_method", "REFINE_BOXES");
 
-
-        for (int levelNumber = 0; levelNumber < maxLevelNumber; ++levelNumber)
-        {
-            // not all levels are necessarily specified for refinement
-            // cppdict will throw when trying to access key L{i} with i = levelNumber
-            std::string levelString{"L" + std::to_string(levelNumber)};
-            if (refDict.contains(levelString))
-            {
-                auto& levelDict = refDict[levelString];
-                auto samraiDim  = SAMRAI::tbox::Dimension{dimension};
-                auto nbrBoxes   = levelDict["nbr_boxes"].template to<int>();
-                auto levelDB
-                    = refinementBoxesDatabase->putDatabase("level_" + std::to_string(levelNumber));
-
-                std::vector<SAMRAI::tbox::DatabaseBox> dbBoxes;
-                for (int iBox = 0; iBox < nbrBoxes; ++iBox)
-                {
-                    int lower[dimension];
-                    int upper[dimension];
-                    auto& boxDict = levelDict["B" + std::to_string(iBox)];
-
-                    lower[0] = boxDict["lower"]["x"].template to<int>();
-                    upper[0] = boxDict["upper"]["x"].template to<int>();
-
-                    if constexpr (dimension >= 2)
-                    {
-                        lower[1] = boxDict["lower"]["y"].template to<int>();
-                        upper[1] = boxDict["upper"]["y"].template to<int>();
-                    }
-
-                    if constexpr (dimension == 3)
-                    {
-                        lower[2] = boxDict["lower"]["z"].template to<int>();
-                        upper[2] = boxDict["upper"]["z"].template to<int>();
-                    }
-
-                    dbBoxes.push_back(SAMRAI::tbox::DatabaseBox(samraiDim, lower, upper));
-                }
-                levelDB->putDatabaseBoxVector("boxes", dbBoxes);
-            }
-        } // end loop on levels
+        putLevelBoxes<dimension>(*refinementBoxesDatabase, refDict, maxLevelNumber);
         return refinementBoxesDatabase;
     }
     else if (refinement.contains("tagging"))
@@ -194,6 +217,44 @@ getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr)
     return nullptr;
 }
 
+
+
+/*
+ * At the first cycle, when the hierarchy is initialized, the levels are refined on the boxes of
+ * the restart file, coarsened to the coarser level, then with the tagging method of the
+ * simulation.
+ */
+template<std::size_t dimension>
+std::shared_ptr<SAMRAI::tbox::MemoryDatabase>
+getRestartRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr,
+                                  PHARE::initializer::PHAREDict const& restartBoxes)
+{
+    auto maxLevelNumber = amr["max_nbr_levels"].template to<int>();
+    auto db = std::make_shared<SAMRAI::tbox::MemoryDatabase>("StandardTagAndInitialize");
+
+    auto at0db = db->putDatabase("at_0");
+    at0db->putInteger("cycle", 0);
+    auto tag0db = at0db->putDatabase("tag_0");
+    tag0db->putString("tagging_method", "REFINE_BOXES");
+    putLevelBoxes<dimension>(*tag0db, restartBoxes, maxLevelNumber);
+
+    auto const& refinement = amr["refinement"];
+    auto at1db             = db->putDatabase("at_1");
+    at1db->putInteger("cycle", 1);
+    auto tag1db = at1db->putDatabase("tag_0");
+    if (refinement.contains("boxes"))
+    {
+        tag1db->putString("tagging_method", "REFINE_BOXES");
+        putLevelBoxes<dimension>(*tag1db, refinement["boxes"], maxLevelNumber);
+    }
+    else if (refinement.contains("tagging"))
+        tag1db->putString("tagging_method", "GRADIENT_DETECTOR");
+    else
+        tag1db->putString("tagging_method", "NONE");
+
+    return db;
+}
+
 } // namespace PHARE::amr
 
 
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "core/hybrid/hybrid_quantities.hpp"
 #include "core/data/vecfield/vecfield_initializer.hpp"
@@ -49,6 +50,20 @@ namespace core
         }
 
 
+        // see VecFieldInitializer::coordinates and prefetch, B being set on the patch
+        template<typename GridLayout>
+        auto initCoordinates(GridLayout const& layout) const
+        {
+            return Binit_.coordinates(B, layout);
+        }
+
+        template<typename Coords>
+        void prefetch(std::vector<Coords> const& coords)
+        {
+            Binit_.prefetch(coords);
+        }
+
+
         //-------------------------------------------------------------------------
         //                  start the ResourcesUser interface
         //-------------------------------------------------------------------------
@@ -1059,6 +1059,27 @@ namespace core
         auto static constexpr JzToMoments() { return GridLayoutImpl::JzToMoments(); }
 
 
+        /**
+         * @brief BxToMoments return the indexes and associated coef to compute the linear
+         * interpolation necessary to project Bx onto moments.
+         */
+        auto static constexpr BxToMoments() { return GridLayoutImpl::BxToMoments(); }
+
+
+        /**
+         * @brief ByToMoments return the indexes and associated coef to compute the linear
+         * interpolation necessary to project By onto moments.
+         */
+        auto static constexpr ByToMoments() { return GridLayoutImpl::ByToMoments(); }
+
+
+        /**
+         * @brief BzToMoments return the indexes and associated coef to compute the linear
+         * interpolation necessary to project Bz onto moments.
+         */
+        auto static constexpr BzToMoments() { return GridLayoutImpl::BzToMoments(); }
+
+
         /**
          * @brief ByToEx return the indexes and associated coef to compute the linear
          * interpolation necessary to project By onto Ex.
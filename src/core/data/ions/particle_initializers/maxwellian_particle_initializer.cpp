@@ -1,8 +1,10 @@
 
 #include <array>
 #include <random>
+#include <vector>
 
 #include "core/utilities/types.hpp"
+#include "core/data/ions/particle_initializers/maxwellian_particle_initializer.hpp"
 
 
 namespace PHARE
@@ -82,5 +84,42 @@ namespace core
         }
     }
 
+
+
+    void MaxwellianBatch::resize(std::size_t const nbrParticles)
+    {
+        for (auto& component : v)
+            component.resize(nbrParticles);
+    }
+
+
+
+    void MaxwellianBatch::maxwellian(std::array<double, 3> const& V,
+                                     std::array<double, 3> const& Vth)
+    {
+        for (std::size_t comp = 0; comp < 3; comp++)
+        {
+            auto* velocity = v[comp].data();
+            for (std::size_t i = 0; i < size(); ++i)
+                velocity[i] = V[comp] + Vth[comp] * velocity[i];
+        }
+    }
+
+
+
+    void MaxwellianBatch::basisTransform(std::array<std::array<double, 3>, 3> const& basis)
+    {
+        auto* vx = v[0].data();
+        auto* vy = v[1].data();
+        auto* vz = v[2].data();
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            std::array<double, 3> const vec{vx[i], vy[i], vz[i]};
+            vx[i] = basis[0][0] * vec[0] + basis[1][0] * vec[1] + basis[2][0] * vec[2];
+            vy[i] = basis[0][1] * vec[0] + basis[1][1] * vec[1] + basis[2][1] * vec[2];
+            vz[i] = basis[0][2] * vec[0] + basis[1][2] * vec[1] + basis[2][2] * vec[2];
+        }
+    }
+
 } // namespace core
 } // namespace PHARE
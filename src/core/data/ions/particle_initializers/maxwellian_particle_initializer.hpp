@@ -3,15 +3,21 @@
 
 #include <memory>
 #include <random>
+#include <thread>
+#include <vector>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 #include <functional>
 
 #include "core/data/grid/gridlayoutdefs.hpp"
 #include "core/hybrid/hybrid_quantities.hpp"
 #include "core/utilities/types.hpp"
+#include "core/utilities/philox.hpp"
 #include "core/data/ions/particle_initializers/particle_initializer.hpp"
 #include "core/data/particles/particle.hpp"
 #include "initializer/data_provider.hpp"
+#include "initializer/init_function_cache.hpp"
 #include "core/utilities/point/point.hpp"
 
 
@@ -27,6 +33,43 @@ std::array<double, 3> basisTransform(std::array<std::array<double, 3>, 3> const&
 void localMagneticBasis(std::array<double, 3> B, std::array<std::array<double, 3>, 3>& basis);
 
 
+/** @brief MaxwellianBatch holds the velocities of the particles of a cell, component by
+ * component, so that they are scaled and transformed by loops over all the particles that the
+ * compiler vectorizes, rather than one particle at a time. Used by counter based loading.
+ */
+class MaxwellianBatch
+{
+public:
+    void resize(std::size_t const nbrParticles);
+
+    std::size_t size() const { return v[0].size(); }
+
+    // scales the normals to the Maxwellian of bulk velocity V and thermal velocity Vth
+    void maxwellian(std::array<double, 3> const& V, std::array<double, 3> const& Vth);
+
+    // the basis transform of each velocity, as a 3x3 matrix product over the batch
+    void basisTransform(std::array<std::array<double, 3>, 3> const& basis);
+
+    std::array<std::vector<double>, 3> v; // normal numbers, then the velocities
+};
+
+
+/** @brief options of the counter based loading of a MaxwellianParticleInitializer
+ *
+ * The random numbers of a particle are drawn from Philox counters given by the seed, the
+ * population, the mesh size of the level, the AMR index of the cell and the index of the
+ * particle in the cell. Loaded particles are then the same whatever the patches, MPI processes
+ * or threads loading them, and the cells of a patch are loaded by nbrThreads threads.
+ * Particle ids are derived from the same key and counter, with either loading.
+ */
+struct CounterBasedLoading
+{
+    bool enabled           = false;
+    std::size_t population = 0; // distinguishes populations loaded with the same seed
+    std::size_t nbrThreads = 1;
+};
+
+
 /** @brief a MaxwellianParticleInitializer is a ParticleInitializer that loads particles from a
  * local Maxwellian distribution given density, bulk velocity and thermal velocity profiles.
  */
@@ -42,7 +85,8 @@ public:
         std::array<InputFunction, 3> const& thermalVelocity, double const particleCharge,
         std::uint32_t const& nbrParticlesPerCell, std::optional<std::size_t> seed = {},
         Basis const basis                                = Basis::Cartesian,
-        std::array<InputFunction, 3> const magneticField = {nullptr, nullptr, nullptr})
+        std::array<InputFunction, 3> const magneticField = {nullptr, nullptr, nullptr},
+        CounterBasedLoading const counterBased           = {})
         : density_{density}
         , bulkVelocity_{bulkVelocity}
         , thermalVelocity_{thermalVelocity}
@@ -51,6 +95,7 @@ public:
         , nbrParticlePerCell_{nbrParticlesPerCell}
         , basis_{basis}
         , rngSeed_{seed}
+        , counterBased_{counterBased}
     {
     }
 
@@ -62,6 +107,10 @@ public:
     void loadParticles(ParticleArray& particles, GridLayout const& layout) const override;
 
 
+    // the profiles are evaluated once for the cells of all layouts, see InitFunctionCache
+    void prefetch(std::vector<GridLayout> const& layouts) override;
+
+
     virtual ~MaxwellianParticleInitializer() = default;
 
 
@@ -79,6 +128,42 @@ public:
 
 private:
     using Particle = typename ParticleArray::value_type;
+
+    // coordinates of the centers of the physical cells of the layout, in the order of indices
+    template<typename CellIndices>
+    static auto cellCoordinates_(GridLayout const& layout, CellIndices const& ndCellIndices)
+    {
+        // primal indexes are given here because that's what cellCenteredCoordinates takes
+        return layout.indexesToCoordVectors(
+            ndCellIndices, QtyCentering::primal,
+            [](auto const& gridLayout, auto const&... indexes) {
+                return gridLayout.cellCenteredCoordinates(indexes...);
+            });
+    }
+
+    template<typename CellIndices, typename InitFunctions>
+    void loadCounterBased_(ParticleArray& particles, GridLayout const& layout,
+                           CellIndices const& ndCellIndices, InitFunctions const& fns) const;
+
+    // of the seed, the population and the mesh size of the level of the layout
+    std::uint64_t levelKey_(GridLayout const& layout) const
+    {
+        std::uint64_t meshSize;
+        std::memcpy(&meshSize, &layout.meshSize()[0], sizeof(meshSize));
+        auto const seed = rngSeed_ ? *rngSeed_ : std::random_device{}();
+        return Philox::mix(Philox::mix(Philox::mix(seed) ^ counterBased_.population) ^ meshSize);
+    }
+
+    // the id of the particle iPart of a cell is derivedParticleId(cellIdKey_(key, cell), iPart)
+    static std::uint64_t cellIdKey_(std::uint64_t const levelKey,
+                                    std::array<int, dimension> const& AMRCell)
+    {
+        auto key = levelKey;
+        for (auto const index : AMRCell)
+            key = Philox::mix(key ^ static_cast<std::uint32_t>(index));
+        return key;
+    }
+
     InputFunction density_;
     std::array<InputFunction, 3> bulkVelocity_;
     std::array<InputFunction, 3> thermalVelocity_;
@@ -88,6 +173,7 @@ private:
     std::uint32_t nbrParticlePerCell_;
     Basis basis_;
     std::optional<std::size_t> rngSeed_;
+    CounterBasedLoading counterBased_;
 };
 
 
@@ -129,17 +215,24 @@ private:
 
 
 
+template<std::size_t dimension, typename CellIndices>
+core::Point<std::uint32_t, dimension> cellIndexAsPoint(std::size_t i, CellIndices const& indices)
+{
+    if constexpr (dimension == 1)
+        return {std::get<0>(indices[i])};
+    if constexpr (dimension == 2)
+        return {std::get<0>(indices[i]), std::get<1>(indices[i])};
+    if constexpr (dimension == 3)
+        return {std::get<0>(indices[i]), std::get<1>(indices[i]), std::get<2>(indices[i])};
+}
+
+
 template<typename ParticleArray, typename GridLayout>
 void MaxwellianParticleInitializer<ParticleArray, GridLayout>::loadParticles(
     ParticleArray& particles, GridLayout const& layout) const
 {
-    auto point = [](std::size_t i, auto const& indices) -> core::Point<std::uint32_t, dimension> {
-        if constexpr (dimension == 1)
-            return {std::get<0>(indices[i])};
-        if constexpr (dimension == 2)
-            return {std::get<0>(indices[i]), std::get<1>(indices[i])};
-        if constexpr (dimension == 3)
-            return {std::get<0>(indices[i]), std::get<1>(indices[i]), std::get<2>(indices[i])};
+    auto point = [](std::size_t i, auto const& indices) {
+        return cellIndexAsPoint<dimension>(i, indices);
     };
 
 
@@ -153,30 +246,33 @@ void MaxwellianParticleInitializer<ParticleArray, GridLayout>::loadParticles(
     };
 
 
-    // in the following two calls,
-    // primal indexes are given here because that's what cellCenteredCoordinates takes
-
     // indices = std::vector<std::tuple<std::uint32_t, per dim>>
     auto ndCellIndices = layout.physicalStartToEndIndices(QtyCentering::primal);
 
     // coords = std::tuple<std::vector<double>,  per dim>
-    auto cellCoords = layout.indexesToCoordVectors(
-        ndCellIndices, QtyCentering::primal, [](auto const& gridLayout, auto const&... indexes) {
-            return gridLayout.cellCenteredCoordinates(indexes...);
-        });
+    auto cellCoords = cellCoordinates_(layout, ndCellIndices);
 
     auto const fns = std::make_from_tuple<MaxwellianInitFunctions>(std::tuple_cat(
         std::forward_as_tuple(density_, bulkVelocity_, thermalVelocity_, magneticField_, basis_),
         cellCoords));
 
+    if (counterBased_.enabled)
+    {
+        loadCounterBased_(particles, layout, ndCellIndices, fns);
+        return;
+    }
+
     auto const [n, V, Vth] = fns();
     auto randGen           = getRNG(rngSeed_);
-    ParticleDeltaDistribution<double> deltaDistrib;
+    auto const levelKey    = levelKey_(layout);
+    ParticleDeltaDistribution<particle_float_t> deltaDistrib;
 
     for (std::size_t flatCellIdx = 0; flatCellIdx < ndCellIndices.size(); flatCellIdx++)
     {
         auto const cellWeight   = n[flatCellIdx] / nbrParticlePerCell_;
         auto const AMRCellIndex = layout.localToAMR(point(flatCellIdx, ndCellIndices));
+        auto const AMRCell      = AMRCellIndex.template toArray<int>();
+        auto const cellIdKey    = cellIdKey_(levelKey, AMRCell);
 
         std::array<double, 3> particleVelocity;
         std::array<std::array<double, 3>, 3> basis;
@@ -196,13 +292,160 @@ void MaxwellianParticleInitializer<ParticleArray, GridLayout>::loadParticles(
             if (basis_ == Basis::Magnetic)
                 particleVelocity = basisTransform(basis, particleVelocity);
 
-            particles.emplace_back(Particle{cellWeight, particleCharge_,
-                                            AMRCellIndex.template toArray<int>(),
-                                            deltas(deltaDistrib, randGen), particleVelocity});
+            particles.emplace_back(Particle{cellWeight, particleCharge_, AMRCell,
+                                            deltas(deltaDistrib, randGen), particleVelocity,
+                                            derivedParticleId(cellIdKey, ipart)});
         }
     }
 }
 
+
+
+template<typename ParticleArray, typename GridLayout>
+void MaxwellianParticleInitializer<ParticleArray, GridLayout>::prefetch(
+    std::vector<GridLayout> const& layouts)
+{
+    using Cache = initializer::InitFunctionCache<dimension>;
+
+    std::vector<typename Cache::Coords> coords;
+    for (auto const& layout : layouts)
+        coords.push_back(
+            cellCoordinates_(layout, layout.physicalStartToEndIndices(QtyCentering::primal)));
+
+    auto batch = [&](InputFunction& function) {
+        if (function)
+            function = Cache::prefetched(function, coords);
+    };
+
+    batch(density_);
+    for (auto* functions : {&bulkVelocity_, &thermalVelocity_})
+        for (auto& function : *functions)
+            batch(function);
+    if (basis_ == Basis::Magnetic)
+        for (auto& function : magneticField_)
+            batch(function);
+}
+
+
+
+/*
+ * The particles are written in place in the preallocated array, at an index given by their
+ * cell, and the cell map is updated once for all of them.
+ */
+template<typename ParticleArray, typename GridLayout>
+template<typename CellIndices, typename InitFunctions>
+void MaxwellianParticleInitializer<ParticleArray, GridLayout>::loadCounterBased_(
+    ParticleArray& particles, GridLayout const& layout, CellIndices const& ndCellIndices,
+    InitFunctions const& fns) const
+{
+    using float_type = typename Particle::float_type;
+
+    // structured bindings are not captured by lambdas in C++17
+    auto const values   = fns();
+    auto const n        = std::get<0>(values);
+    auto const V        = std::get<1>(values);
+    auto const Vth      = std::get<2>(values);
+    auto const nbrCells = ndCellIndices.size();
+    auto const first       = particles.size();
+    particles.resize(first + nbrCells * nbrParticlePerCell_);
+
+    auto const key64 = levelKey_(layout);
+    Philox::Key const key{static_cast<std::uint32_t>(key64),
+                          static_cast<std::uint32_t>(key64 >> 32)};
+
+    /* the random numbers of a particle are the ones of a CounterStream from its counter: the
+     * deltas, then three uniform numbers for its 3 normal velocities, of two words each, and a
+     * fourth one for the last particle of a cell with an odd number of particles. They are
+     * drawn for all the particles of a cell at once, in arrays of the k-th uniform number of
+     * each particle, over which Box-Muller runs. The third normals pair the third uniform
+     * numbers of the two halves of the cell, see Philox::boxMuller.
+     */
+    std::uint32_t constexpr blocksPerParticle = 4;
+    std::size_t constexpr nbrUniforms         = dimension + 3;
+    auto constexpr maxDelta = 1 - std::numeric_limits<float_type>::epsilon();
+
+    auto loadCells = [&](std::size_t firstCell, std::size_t lastCell) {
+        MaxwellianBatch batch;
+        batch.resize(nbrParticlePerCell_);
+        double lastUniform = 0; // of the last particle of an odd cell
+        std::array<std::vector<double>, nbrUniforms> uniforms;
+        for (auto& uniform : uniforms)
+            uniform.resize(nbrParticlePerCell_);
+
+        for (auto iCell = firstCell; iCell < lastCell; ++iCell)
+        {
+            auto const localCell  = cellIndexAsPoint<dimension>(iCell, ndCellIndices);
+            auto const AMRCell    = layout.localToAMR(localCell).template toArray<int>();
+            auto const cellWeight = n[iCell] / nbrParticlePerCell_;
+            auto const cellIdKey  = cellIdKey_(key64, AMRCell);
+
+            Philox::Counter counter{0, 0, 0, 0};
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                counter[iDim] = static_cast<std::uint32_t>(AMRCell[iDim]);
+
+            for (std::uint32_t iPart = 0; iPart < nbrParticlePerCell_; ++iPart)
+            {
+                bool const oddLast = iPart + 1 == nbrParticlePerCell_ and iPart % 2 == 0;
+                counter[3]         = iPart * blocksPerParticle;
+                Philox::Counter block;
+                for (std::size_t iUniform = 0; iUniform < nbrUniforms + oddLast; ++iUniform)
+                {
+                    auto const iWord = (2 * iUniform) % 4;
+                    if (iWord == 0)
+                    {
+                        block = Philox::generate(counter, key);
+                        ++counter[3];
+                    }
+                    auto const uniform = Philox::uniform(block[iWord], block[iWord + 1]);
+                    if (iUniform < nbrUniforms)
+                        uniforms[iUniform][iPart] = uniform;
+                    else
+                        lastUniform = uniform;
+                }
+            }
+
+            Philox::boxMuller(uniforms[dimension].data(), uniforms[dimension + 1].data(),
+                              batch.v[0].data(), batch.v[1].data(), nbrParticlePerCell_);
+            Philox::boxMuller(uniforms[dimension + 2].data(), lastUniform, batch.v[2].data(),
+                              nbrParticlePerCell_);
+            batch.maxwellian({V[0][iCell], V[1][iCell], V[2][iCell]},
+                             {Vth[0][iCell], Vth[1][iCell], Vth[2][iCell]});
+
+            if (basis_ == Basis::Magnetic)
+            {
+                auto const B = fns.B();
+                std::array<std::array<double, 3>, 3> basis;
+                localMagneticBasis({B[0][iCell], B[1][iCell], B[2][iCell]}, basis);
+                batch.basisTransform(basis);
+            }
+
+            for (std::uint32_t iPart = 0; iPart < nbrParticlePerCell_; ++iPart)
+            {
+                auto& particle  = particles[first + iCell * nbrParticlePerCell_ + iPart];
+                particle.weight = cellWeight;
+                particle.charge = particleCharge_;
+                particle.iCell  = AMRCell;
+                particle.id     = derivedParticleId(cellIdKey, iPart);
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    particle.delta[iDim] = std::min<float_type>(uniforms[iDim][iPart], maxDelta);
+                for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                    particle.v[iComp] = batch.v[iComp][iPart];
+            }
+        }
+    };
+
+    auto const nbrThreads = std::max(std::min(counterBased_.nbrThreads, nbrCells), std::size_t{1});
+    std::vector<std::thread> threads;
+    for (std::size_t iThread = 1; iThread < nbrThreads; ++iThread)
+        threads.emplace_back(loadCells, iThread * nbrCells / nbrThreads,
+                             (iThread + 1) * nbrCells / nbrThreads);
+    loadCells(0, nbrCells / nbrThreads);
+    for (auto& thread : threads)
+        thread.join();
+
+    particles.map_particles(first);
+}
+
 } // namespace PHARE::core
 
 
@@ -1,6 +1,7 @@
 #ifndef PHARE_PARTICLE_INITIALIZER_HPP
 #define PHARE_PARTICLE_INITIALIZER_HPP
 
+#include <vector>
 
 namespace PHARE
 {
@@ -11,6 +12,11 @@ namespace core
     {
     public:
         virtual void loadParticles(ParticleArray& particles, GridLayout const& layout) const = 0;
+
+        // called before loading the particles of these layouts, e.g. to evaluate init functions
+        // for all of them at once
+        virtual void prefetch(std::vector<GridLayout> const& /*layouts*/) {}
+
         virtual ~ParticleInitializer() = default;
     };
 
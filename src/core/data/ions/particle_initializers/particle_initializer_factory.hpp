@@ -4,6 +4,7 @@
 
 #include "core/utilities/types.hpp"
 #include "initializer/data_provider.hpp"
+#include "initializer/init_profiles.hpp"
 #include "maxwellian_particle_initializer.hpp"
 #include "particle_initializer.hpp"
 
@@ -16,11 +17,12 @@ namespace core
     template<typename ParticleArray, typename GridLayout>
     class ParticleInitializerFactory
     {
-        using ParticleInitializerT      = ParticleInitializer<ParticleArray, GridLayout>;
         static constexpr auto dimension = GridLayout::dimension;
 
 
     public:
+        using ParticleInitializerT = ParticleInitializer<ParticleArray, GridLayout>;
+
         static std::unique_ptr<ParticleInitializerT> create(initializer::PHAREDict const& dict)
         {
             using FunctionType = initializer::InitFunction<dimension>;
@@ -29,19 +31,19 @@ namespace core
 
             if (initializerName == "maxwellian")
             {
-                auto& density = dict["density"].template to<FunctionType>();
+                auto density = initializer::initFunction<dimension>(dict["density"]);
 
-                auto& bulkVelx = dict["bulk_velocity_x"].template to<FunctionType>();
+                auto bulkVelx = initializer::initFunction<dimension>(dict["bulk_velocity_x"]);
 
-                auto& bulkVely = dict["bulk_velocity_y"].template to<FunctionType>();
+                auto bulkVely = initializer::initFunction<dimension>(dict["bulk_velocity_y"]);
 
-                auto& bulkVelz = dict["bulk_velocity_z"].template to<FunctionType>();
+                auto bulkVelz = initializer::initFunction<dimension>(dict["bulk_velocity_z"]);
 
-                auto& vthx = dict["thermal_velocity_x"].template to<FunctionType>();
+                auto vthx = initializer::initFunction<dimension>(dict["thermal_velocity_x"]);
 
-                auto& vthy = dict["thermal_velocity_y"].template to<FunctionType>();
+                auto vthy = initializer::initFunction<dimension>(dict["thermal_velocity_y"]);
 
-                auto& vthz = dict["thermal_velocity_z"].template to<FunctionType>();
+                auto vthz = initializer::initFunction<dimension>(dict["thermal_velocity_z"]);
 
                 auto charge = dict["charge"].template to<double>();
 
@@ -57,11 +59,23 @@ namespace core
                 if (dict.contains("init") && dict["init"].contains("seed"))
                     seed = dict["init"]["seed"].template to<std::optional<std::size_t>>();
 
+                CounterBasedLoading counterBased;
+                if (dict.contains("init") && dict["init"].contains("rng"))
+                {
+                    auto const& init     = dict["init"];
+                    counterBased.enabled = init["rng"].template to<std::string>() == "philox";
+                    if (init.contains("population"))
+                        counterBased.population = init["population"].template to<std::size_t>();
+                    if (init.contains("threads"))
+                        counterBased.nbrThreads = init["threads"].template to<std::size_t>();
+                }
+
                 if (basisName == "cartesian")
                 {
                     return std::make_unique<
                         MaxwellianParticleInitializer<ParticleArray, GridLayout>>(
-                        density, v, vth, charge, nbrPartPerCell, seed);
+                        density, v, vth, charge, nbrPartPerCell, seed, Basis::Cartesian,
+                        std::array<FunctionType, 3>{nullptr, nullptr, nullptr}, counterBased);
                 }
                 else if (basisName == "magnetic")
                 {
@@ -72,7 +86,8 @@ namespace core
 
                     return std::make_unique<
                         MaxwellianParticleInitializer<ParticleArray, GridLayout>>(
-                        density, v, vth, charge, nbrPartPerCell, seed);
+                        density, v, vth, charge, nbrPartPerCell, seed, Basis::Cartesian,
+                        std::array<FunctionType, 3>{nullptr, nullptr, nullptr}, counterBased);
                 }
             }
             // TODO throw?
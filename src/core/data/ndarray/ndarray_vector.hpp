@@ -7,11 +7,68 @@
 #include <vector>
 #include <tuple>
 #include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 #include <iostream>
 
+#include "core/utilities/aligned_allocator.hpp"
+
+
+#if !defined(PHARE_NDARRAY_ROW_PADDING)
+#define PHARE_NDARRAY_ROW_PADDING 1
+#endif
+
 
 namespace PHARE::core
 {
+//! alignment in bytes of the NdArrayVector buffers
+std::size_t constexpr ndarray_alignment = 64;
+
+//! the fastest varying dimension of field arrays is padded to a multiple of this
+//! number of elements (cmake -DndarrayRowPadding=8), 1 means no padding
+std::uint32_t constexpr ndarray_row_padding = PHARE_NDARRAY_ROW_PADDING;
+
+
+
+/** \brief returns the shape of the memory of an array of the given shape once its fastest
+ * varying dimension is padded to a multiple of row_padding. 1D arrays are never padded
+ */
+template<std::size_t dim, bool c_ordering = true>
+auto paddedShape(std::array<std::uint32_t, dim> shape, std::uint32_t row_padding)
+{
+    if constexpr (dim > 1)
+    {
+        auto constexpr fastest = c_ordering ? dim - 1 : 0;
+        shape[fastest] = ((shape[fastest] + row_padding - 1) / row_padding) * row_padding;
+    }
+    return shape;
+}
+
+
+/** \brief returns, for each dimension, the distance in elements between two consecutive
+ * indexes in memory of an array whose memory has the given shape
+ */
+template<std::size_t dim, bool c_ordering = true>
+auto stridesFor(std::array<std::uint32_t, dim> const& memoryShape)
+{
+    std::array<std::size_t, dim> strides;
+    if constexpr (c_ordering)
+    {
+        strides[dim - 1] = 1;
+        for (int iDim = static_cast<int>(dim) - 2; iDim >= 0; --iDim)
+            strides[iDim] = strides[iDim + 1] * memoryShape[iDim + 1];
+    }
+    else
+    {
+        strides[0] = 1;
+        for (std::size_t iDim = 1; iDim < dim; ++iDim)
+            strides[iDim] = strides[iDim - 1] * memoryShape[iDim - 1];
+    }
+    return strides;
+}
+
+
 template<std::size_t dim, bool c_ordering = true, typename DataType = double>
 struct NdArrayViewer
 {
@@ -83,6 +140,7 @@ public:
     MaskedView(Array& array, Mask const& mask)
         : array_{array}
         , shape_{array.shape()}
+        , memoryShape_{array.memoryShape()}
         , mask_{mask}
     {
     }
@@ -90,6 +148,7 @@ public:
     MaskedView(Array& array, Mask&& mask)
         : array_{array}
         , shape_{array.shape()}
+        , memoryShape_{array.memoryShape()}
         , mask_{std::move(mask)}
     {
     }
@@ -97,7 +156,8 @@ public:
     template<typename... Indexes>
     DataType const& operator()(Indexes... indexes) const
     {
-        return NdArrayViewer<dimension, true, DataType>::at(array_.data(), shape_, indexes...);
+        return NdArrayViewer<dimension, true, DataType>::at(array_.data(), memoryShape_,
+                                                            indexes...);
     }
 
     template<typename... Indexes>
@@ -118,9 +178,15 @@ public:
     auto yend() const { return shape_[1] - 1 - mask_.max(); }
 
 
+    auto zstart() const { return mask_.min(); }
+
+    auto zend() const { return shape_[2] - 1 - mask_.max(); }
+
+
 private:
     Array& array_;
     std::array<std::uint32_t, dimension> shape_;
+    std::array<std::uint32_t, dimension> memoryShape_;
     Mask const& mask_;
 };
 
@@ -138,6 +204,16 @@ public:
     explicit NdArrayView(Pointer ptr, std::array<std::uint32_t, dim> const& nCells)
         : ptr_{ptr}
         , nCells_{nCells}
+        , memoryShape_{nCells}
+    {
+    }
+
+    //! view on a padded buffer, memoryShape is the shape of the memory including padding
+    explicit NdArrayView(Pointer ptr, std::array<std::uint32_t, dim> const& nCells,
+                         std::array<std::uint32_t, dim> const& memoryShape)
+        : ptr_{ptr}
+        , nCells_{nCells}
+        , memoryShape_{memoryShape}
     {
     }
 
@@ -150,7 +226,7 @@ public:
     template<typename... Indexes>
     DataType const& operator()(Indexes... indexes) const
     {
-        return NdArrayViewer<dim, c_ordering, DataType>::at(ptr_, nCells_, indexes...);
+        return NdArrayViewer<dim, c_ordering, DataType>::at(ptr_, memoryShape_, indexes...);
     }
 
     template<typename... Indexes>
@@ -162,7 +238,7 @@ public:
     template<typename Index>
     DataType const& operator()(std::array<Index, dim> const& indexes) const
     {
-        return NdArrayViewer<dim, c_ordering, DataType>::at(ptr_, nCells_, indexes);
+        return NdArrayViewer<dim, c_ordering, DataType>::at(ptr_, memoryShape_, indexes);
     }
 
     template<typename Index>
@@ -177,16 +253,83 @@ public:
         return std::accumulate(nCells_.begin(), nCells_.end(), 1, std::multiplies<std::size_t>());
     }
     auto shape() const { return nCells_; }
+    auto memoryShape() const { return memoryShape_; }
+    auto strides() const { return stridesFor<dim, c_ordering>(memoryShape_); }
+    bool isPadded() const { return memoryShape_ != nCells_; }
 
 private:
     Pointer ptr_ = nullptr;
     std::array<std::uint32_t, dim> nCells_;
+    std::array<std::uint32_t, dim> memoryShape_;
 };
 
 
 
 
-template<std::size_t dim, typename DataType = double, bool c_ordering = true>
+/** \brief RowsIterator iterates over the elements of a padded buffer in the order of their
+ * indexes, skipping the padding at the end of each row of the fastest varying dimension
+ */
+template<typename DataType>
+class RowsIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::remove_const_t<DataType>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = DataType*;
+    using reference         = DataType&;
+
+    RowsIterator(DataType* ptr, std::uint32_t rowSize, std::uint32_t memoryRowSize)
+        : ptr_{ptr}
+        , rowSize_{rowSize}
+        , padding_{memoryRowSize - rowSize}
+    {
+    }
+
+    reference operator*() const { return *ptr_; }
+    pointer operator->() const { return ptr_; }
+
+    RowsIterator& operator++()
+    {
+        ++ptr_;
+        if (++column_ == rowSize_)
+        {
+            ptr_ += padding_;
+            column_ = 0;
+        }
+        return *this;
+    }
+
+    RowsIterator operator++(int)
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    bool operator==(RowsIterator const& that) const { return ptr_ == that.ptr_; }
+    bool operator!=(RowsIterator const& that) const { return ptr_ != that.ptr_; }
+
+private:
+    DataType* ptr_;
+    std::uint32_t rowSize_;
+    std::uint32_t padding_;
+    std::uint32_t column_ = 0;
+};
+
+
+
+/** \brief NdArrayVector owns a multidimensional array stored in a 64 bytes aligned buffer
+ *
+ * If row_padding > 1, the fastest varying dimension of the buffer is padded to a multiple of
+ * row_padding elements, so that each row also starts on an aligned address. The buffer then
+ * holds more elements than the array: shape(), size(), begin() and end() refer to the
+ * elements of the array, the iterators skipping the padding, while data(), memoryShape(),
+ * memorySize() and strides() describe the buffer. Use contiguous() to get the elements
+ * without the padding.
+ */
+template<std::size_t dim, typename DataType = double, bool c_ordering = true,
+         std::uint32_t row_padding = 1>
 class NdArrayVector
 {
 public:
@@ -194,19 +337,22 @@ public:
     static const std::size_t dimension  = dim;
     using type                          = DataType;
 
+    static_assert(row_padding > 0);
+
     NdArrayVector() = delete;
 
     template<typename... Nodes>
     explicit NdArrayVector(Nodes... nodes)
-        : nCells_{nodes...}
-        , data_((... * nodes))
+        : NdArrayVector{std::array<std::uint32_t, dim>{static_cast<std::uint32_t>(nodes)...}}
     {
         static_assert(sizeof...(Nodes) == dim);
     }
 
     explicit NdArrayVector(std::array<std::uint32_t, dim> const& ncells)
         : nCells_{ncells}
-        , data_(std::accumulate(ncells.begin(), ncells.end(), 1, std::multiplies<int>()))
+        , memoryShape_{paddedShape<dim, c_ordering>(ncells, row_padding)}
+        , data_(std::accumulate(memoryShape_.begin(), memoryShape_.end(), std::size_t{1},
+                                std::multiplies<std::size_t>()))
     {
     }
 
@@ -218,13 +364,22 @@ public:
     auto data() const { return data_.data(); }
     auto data() { return data_.data(); }
 
-    auto size() const { return data_.size(); }
+    //! number of elements of the array, padding excluded
+    std::size_t size() const
+    {
+        return std::accumulate(nCells_.begin(), nCells_.end(), std::size_t{1},
+                               std::multiplies<std::size_t>());
+    }
+
+    //! number of elements of the buffer, padding included
+    auto memorySize() const { return data_.size(); }
 
-    auto begin() const { return std::begin(data_); }
-    auto begin() { return std::begin(data_); }
+    //! iterators over the elements of the array, padding excluded
+    auto begin() const { return begin_(data()); }
+    auto begin() { return begin_(data()); }
 
-    auto end() const { return std::end(data_); }
-    auto end() { return std::end(data_); }
+    auto end() const { return end_(data()); }
+    auto end() { return end_(data()); }
 
     void zero() { std::fill(data_.begin(), data_.end(), 0); }
 
@@ -234,7 +389,8 @@ public:
     template<typename... Indexes>
     DataType const& operator()(Indexes... indexes) const
     {
-        return NdArrayViewer<dim, c_ordering, DataType>::at(data_.data(), nCells_, indexes...);
+        return NdArrayViewer<dim, c_ordering, DataType>::at(data_.data(), memoryShape_,
+                                                            indexes...);
     }
 
     template<typename... Indexes>
@@ -246,7 +402,7 @@ public:
     template<typename Index>
     DataType const& operator()(std::array<Index, dim> const& indexes) const
     {
-        return NdArrayViewer<dim, c_ordering, DataType>::at(data_.data(), nCells_, indexes);
+        return NdArrayViewer<dim, c_ordering, DataType>::at(data_.data(), memoryShape_, indexes);
     }
 
     template<typename Index>
@@ -257,6 +413,19 @@ public:
 
 
     auto& shape() const { return nCells_; }
+    auto& memoryShape() const { return memoryShape_; }
+    auto strides() const { return stridesFor<dim, c_ordering>(memoryShape_); }
+    bool isPadded() const { return memoryShape_ != nCells_; }
+
+    auto view() const
+    {
+        return NdArrayView<dim, DataType, DataType const*, c_ordering>{data(), nCells_,
+                                                                       memoryShape_};
+    }
+    auto view()
+    {
+        return NdArrayView<dim, DataType, DataType*, c_ordering>{data(), nCells_, memoryShape_};
+    }
 
     template<typename Mask>
     auto operator[](Mask&& mask)
@@ -270,11 +439,133 @@ public:
 
 
 private:
+    static constexpr std::size_t fastest_ = c_ordering ? dim - 1 : 0;
+
+    template<typename T>
+    auto begin_(T* ptr) const
+    {
+        if constexpr (row_padding == 1)
+            return ptr;
+        else
+            return RowsIterator<T>{ptr, nCells_[fastest_], memoryShape_[fastest_]};
+    }
+
+    template<typename T>
+    auto end_(T* ptr) const
+    {
+        if constexpr (row_padding == 1)
+            return ptr + data_.size();
+        else
+            return RowsIterator<T>{ptr + data_.size(), nCells_[fastest_], memoryShape_[fastest_]};
+    }
+
     std::array<std::uint32_t, dim> nCells_;
-    std::vector<DataType> data_;
+    std::array<std::uint32_t, dim> memoryShape_;
+    aligned_vector<DataType, ndarray_alignment> data_;
 };
 
 
+
+/** \brief returns a contiguous copy of the elements of the array, without padding, in the
+ * order of its indexes (C ordering)
+ */
+template<typename NdArray>
+auto packed(NdArray const& array)
+{
+    using DataType       = std::decay_t<typename NdArray::type>;
+    auto constexpr dim   = NdArray::dimension;
+    auto const& shape    = array.shape();
+    std::vector<DataType> contiguous;
+    contiguous.reserve(array.size());
+
+    if constexpr (dim == 1)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            contiguous.push_back(array(i));
+
+    if constexpr (dim == 2)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            for (std::uint32_t j = 0; j < shape[1]; ++j)
+                contiguous.push_back(array(i, j));
+
+    if constexpr (dim == 3)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            for (std::uint32_t j = 0; j < shape[1]; ++j)
+                for (std::uint32_t k = 0; k < shape[2]; ++k)
+                    contiguous.push_back(array(i, j, k));
+
+    return contiguous;
+}
+
+
+/** \brief Contiguous holds the elements of an array without padding, contiguous in the order
+ * of its indexes: the buffer of the array if it is not padded, a packed copy otherwise.
+ */
+template<typename DataType>
+class Contiguous
+{
+public:
+    template<typename NdArray>
+    explicit Contiguous(NdArray const& array)
+        : copy_{array.isPadded() ? packed(array) : std::vector<DataType>{}}
+        , data_{array.isPadded() ? copy_.data() : array.data()}
+        , size_{array.size()}
+    {
+    }
+
+    Contiguous(Contiguous const&) = delete;
+    Contiguous(Contiguous&&)      = default;
+    Contiguous& operator=(Contiguous const&) = delete;
+    Contiguous& operator=(Contiguous&&) = default;
+
+    DataType const* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    DataType const* begin() const { return data_; }
+    DataType const* end() const { return data_ + size_; }
+
+private:
+    std::vector<DataType> copy_;
+    DataType const* data_;
+    std::size_t size_;
+};
+
+template<typename NdArray>
+auto contiguous(NdArray const& array)
+{
+    return Contiguous<std::decay_t<typename NdArray::type>>{array};
+}
+
+
+/** \brief inverse of packed(), copies array.size() contiguous elements into the array
+ */
+template<typename NdArray, typename DataType>
+void unpack(DataType const* contiguous, NdArray& array)
+{
+    auto constexpr dim = NdArray::dimension;
+    auto const& shape  = array.shape();
+
+    if (!array.isPadded())
+    {
+        std::copy(contiguous, contiguous + array.size(), array.data());
+        return;
+    }
+
+    if constexpr (dim == 1)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            array(i) = *contiguous++;
+
+    if constexpr (dim == 2)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            for (std::uint32_t j = 0; j < shape[1]; ++j)
+                array(i, j) = *contiguous++;
+
+    if constexpr (dim == 3)
+        for (std::uint32_t i = 0; i < shape[0]; ++i)
+            for (std::uint32_t j = 0; j < shape[1]; ++j)
+                for (std::uint32_t k = 0; k < shape[2]; ++k)
+                    array(i, j, k) = *contiguous++;
+}
+
+
 class NdArrayMask
 {
 public:
@@ -343,10 +634,35 @@ public:
         }
     }
 
+    // the nodes between the boxes of layers min and max, as in 2D, filled a row along z at a time
     template<typename Array>
     void fill3D(Array& array, typename Array::type val) const
     {
-        throw std::runtime_error("3d not implemented");
+        auto shape = array.shape();
+
+        auto inBorder = [&](std::size_t i, std::size_t iDim) {
+            return i <= max_ or i >= shape[iDim] - 1 - max_;
+        };
+
+        for (std::size_t i = min_; i <= shape[0] - 1 - min_; ++i)
+            for (std::size_t j = min_; j <= shape[1] - 1 - min_; ++j)
+            {
+                if (inBorder(i, 0) or inBorder(j, 1))
+                {
+                    // whole row, as on the left, right, bottom and top borders
+                    for (std::size_t k = min_; k <= shape[2] - 1 - min_; ++k)
+                        array(i, j, k) = val;
+                    continue;
+                }
+
+                // front border
+                for (std::size_t k = min_; k <= max_; ++k)
+                    array(i, j, k) = val;
+
+                // back border
+                for (std::size_t k = shape[2] - 1 - max_; k <= shape[2] - 1 - min_; ++k)
+                    array(i, j, k) = val;
+            }
     }
 
     template<typename Array>
@@ -364,8 +680,13 @@ public:
             for (std::size_t i = min_; i <= max_; ++i)
                 cells += (shape[0] - (i * 2) - 2) * 2 + (shape[1] - (i * 2) - 2) * 2 + 4;
 
+        // the box of layer i, minus the box inside it
         if constexpr (Array::dimension == 3)
-            throw std::runtime_error("Not implemented dimension");
+            for (std::size_t i = min_; i <= max_; ++i)
+            {
+                auto const nx = shape[0] - i * 2, ny = shape[1] - i * 2, nz = shape[2] - i * 2;
+                cells += nx * ny * nz - (nx - 2) * (ny - 2) * (nz - 2);
+            }
 
         return cells;
     }
@@ -443,9 +764,36 @@ void operator>>(MaskedView<Array, Mask>&& inner, MaskedView<Array, Mask>&& outer
             outer(outer.xend(), iy) = inner(inner.xend(), inner.ystart());
     }
 
+    // as in 2D, each node of the faces of outer gets the value of the nearest node of inner
     if constexpr (MaskedView_t::dimension == 3)
     {
-        throw std::runtime_error("3d not implemented");
+        assert(inner.xstart() > outer.xstart() and inner.xend() < outer.xend()
+               and inner.ystart() > outer.ystart() and inner.yend() < outer.yend()
+               and inner.zstart() > outer.zstart() and inner.zend() < outer.zend());
+
+        auto nearest = [](auto i, auto start, auto end) { return std::clamp(i, start, end); };
+
+        for (auto ix = outer.xstart(); ix <= outer.xend(); ++ix)
+            for (auto iy = outer.ystart(); iy <= outer.yend(); ++iy)
+            {
+                auto const jx = nearest(ix, inner.xstart(), inner.xend());
+                auto const jy = nearest(iy, inner.ystart(), inner.yend());
+
+                if (ix == outer.xstart() or ix == outer.xend() or iy == outer.ystart()
+                    or iy == outer.yend())
+                {
+                    // left, right, bottom and top faces
+                    for (auto iz = outer.zstart(); iz <= outer.zend(); ++iz)
+                    {
+                        auto const jz     = nearest(iz, inner.zstart(), inner.zend());
+                        outer(ix, iy, iz) = inner(jx, jy, jz);
+                    }
+                    continue;
+                }
+
+                outer(ix, iy, outer.zstart()) = inner(jx, jy, inner.zstart()); // front
+                outer(ix, iy, outer.zend())   = inner(jx, jy, inner.zend());   // back
+            }
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <random>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
@@ -10,12 +11,34 @@
 #include <iostream>
 
 #include "core/utilities/point/point.hpp"
+#include "core/utilities/philox.hpp"
 #include "core/utilities/span.hpp"
 #include "core/utilities/types.hpp"
 
 
+#if !defined(PHARE_PARTICLE_FLOATS)
+#define PHARE_PARTICLE_FLOATS false
+#endif
+
+
 namespace PHARE::core
 {
+/** \brief ParticlePrecision is the compile-time precision policy of particle storage
+ *
+ * deltas and velocities are stored as storage_type, which is float if PHARE_PARTICLE_FLOATS
+ * is true (cmake -DparticleFloats=ON), double otherwise.
+ * weights, charges and the fields seen by particles always stay double, and all the
+ * arithmetic of the pusher, interpolator and deposit is done in compute_type.
+ */
+struct ParticlePrecision
+{
+    using storage_type = std::conditional_t<PHARE_PARTICLE_FLOATS, float, double>;
+    using compute_type = double;
+};
+
+using particle_float_t = ParticlePrecision::storage_type;
+
+
 template<typename T = float>
 struct ParticleDeltaDistribution
 {
@@ -35,20 +58,46 @@ auto cellAsPoint(Particle const& particle)
 }
 
 
+/* id of the n-th particle made from the particle of the given id (refinement, population
+ * control), distinct for distinct n and, with high probability, from any other particle id
+ */
+inline std::uint64_t derivedParticleId(std::uint64_t const id, std::uint64_t const n)
+{
+    return Philox::mix(Philox::mix(id) + n);
+}
+
+
 template<size_t dim>
 struct Particle
 {
     static_assert(dim > 0 and dim < 4, "Only dimensions 1,2,3 are supported.");
     static const size_t dimension = dim;
+    using float_type              = particle_float_t;
 
     Particle(double a_weight, double a_charge, std::array<int, dim> cell,
-             std::array<double, dim> a_delta, std::array<double, 3> a_v)
+             std::array<float_type, dim> a_delta, std::array<float_type, 3> a_v,
+             std::uint64_t a_id = 0)
         : weight{a_weight}
         , charge{a_charge}
         , iCell{cell}
         , delta{a_delta}
         , v{a_v}
+        , id{a_id}
+    {
+    }
+
+    // narrows double deltas and velocities when particles are stored in reduced precision
+    template<typename T = float_type, typename = std::enable_if_t<!std::is_same_v<T, double>>>
+    Particle(double a_weight, double a_charge, std::array<int, dim> cell,
+             std::array<double, dim> const& a_delta, std::array<double, 3> const& a_v,
+             std::uint64_t a_id = 0)
+        : weight{a_weight}
+        , charge{a_charge}
+        , iCell{cell}
+        , id{a_id}
     {
+        std::copy(a_delta.begin(), a_delta.end(), delta.begin());
+        std::copy(a_v.begin(), a_v.end(), v.begin());
     }
 
     Particle() = default;
@@ -56,9 +105,13 @@ struct Particle
     double weight;
     double charge;
 
-    std::array<int, dim> iCell    = ConstArray<int, dim>();
-    std::array<double, dim> delta = ConstArray<double, dim>();
-    std::array<double, 3> v       = ConstArray<double, 3>();
+    std::array<int, dim> iCell        = ConstArray<int, dim>();
+    std::array<float_type, dim> delta = ConstArray<float_type, dim>();
+    std::array<float_type, 3> v       = ConstArray<float_type, 3>();
+
+    // persistent identity, given at loading and kept by the particle for its whole life, it is
+    // not part of the state compared by ==
+    std::uint64_t id = 0;
 
     double Ex = 0, Ey = 0, Ez = 0;
     double Bx = 0, By = 0, Bz = 0;
@@ -101,6 +154,7 @@ std::ostream& operator<<(std::ostream& out, Particle<dim> const& particle)
         out << v << ",";
     }
     out << "), charge : " << particle.charge << ", weight : " << particle.weight;
+    out << ", id : " << particle.id;
     out << ", Exyz : " << particle.Ex << "," << particle.Ey << "," << particle.Ez;
     out << ", Bxyz : " << particle.Bx << "," << particle.By << "," << particle.Bz;
     out << '\n';
@@ -114,11 +168,14 @@ struct ParticleView
     static_assert(dim > 0 and dim < 4, "Only dimensions 1,2,3 are supported.");
     static constexpr std::size_t dimension = dim;
 
+    using float_type = particle_float_t;
+
     double& weight;
     double& charge;
     std::array<int, dim>& iCell;
-    std::array<double, dim>& delta;
-    std::array<double, 3>& v;
+    std::array<float_type, dim>& delta;
+    std::array<float_type, 3>& v;
+    std::uint64_t& id;
 };
 
 
@@ -154,7 +211,7 @@ typename std::enable_if_t<PHARE::core::is_phare_particle_type<dim, Particle_t<di
                           PHARE::core::Particle<dim>>
 copy(Particle_t<dim> const& from)
 {
-    return {from.weight, from.charge, from.iCell, from.delta, from.v};
+    return {from.weight, from.charge, from.iCell, from.delta, from.v, from.id};
 }
 
 
@@ -3,6 +3,7 @@
 
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -145,12 +146,42 @@ public:
 
     void swap(ParticleArray<dim>& that) { std::swap(this->particles_, that.particles_); }
 
+    //! removes the particle at index, the last particle being moved to its place
+    void swap_last_reduce_by_one(std::size_t index)
+    {
+        auto const last = particles_.size() - 1;
+        if (isIn(Point{particles_[index].iCell}, box_))
+            cellMap_.erase(particles_, index);
+        if (index != last)
+        {
+            particles_[index] = particles_[last];
+            if (isIn(Point{particles_[index].iCell}, box_))
+                cellMap_(particles_[index].iCell).updateIndex(last, index);
+        }
+        particles_.pop_back();
+    }
+
     void map_particles() const { cellMap_.add(particles_); }
+    // maps the particles [first, size()), e.g. once written in place after a resize
+    void map_particles(std::size_t first) const
+    {
+        if (first < particles_.size())
+            cellMap_.add(particles_, first, particles_.size() - 1);
+    }
     void empty_map() { cellMap_.empty(); }
 
 
     auto nbr_particles_in(box_t const& box) const { return cellMap_.size(box); }
 
+    //! indexes of the particles in the given cell, which must be in box()
+    template<typename Cell>
+    auto const& indexes_in(Cell const& cell) const
+    {
+        return cellMap_(cell);
+    }
+
+    auto const& box() const { return box_; }
+
     void export_particles(box_t const& box, ParticleArray<dim>& dest) const
     {
         PHARE_LOG_SCOPE("ParticleArray::export_particles");
@@ -273,18 +304,21 @@ namespace core
             , weight(s)
             , charge(s)
             , v(s * 3)
+            , id(s)
         {
         }
 
-        template<typename Container_int, typename Container_double>
-        ContiguousParticles(Container_int&& _iCell, Container_double&& _delta,
+        template<typename Container_int, typename Container_float, typename Container_double,
+                 typename Container_id>
+        ContiguousParticles(Container_int&& _iCell, Container_float&& _delta,
                             Container_double&& _weight, Container_double&& _charge,
-                            Container_double&& _v)
+                            Container_float&& _v, Container_id&& _id)
             : iCell{_iCell}
             , delta{_delta}
             , weight{_weight}
             , charge{_charge}
             , v{_v}
+            , id{_id}
         {
         }
 
@@ -304,7 +338,8 @@ namespace core
                 *const_cast<double*>(charge.data() + i),     //
                 *_array_cast<dim>(iCell.data() + (dim * i)), //
                 *_array_cast<dim>(delta.data() + (dim * i)), //
-                *_array_cast<3>(v.data() + (3 * i)),
+                *_array_cast<3>(v.data() + (3 * i)),            //
+                *const_cast<std::uint64_t*>(id.data() + i),
             };
         }
 
@@ -336,8 +371,11 @@ namespace core
             std::vector<ParticleView<dim>> views;
         };
 
-        auto as_tuple() { return std::forward_as_tuple(weight, charge, iCell, delta, v); }
-        auto as_tuple() const { return std::forward_as_tuple(weight, charge, iCell, delta, v); }
+        auto as_tuple() { return std::forward_as_tuple(weight, charge, iCell, delta, v, id); }
+        auto as_tuple() const
+        {
+            return std::forward_as_tuple(weight, charge, iCell, delta, v, id);
+        }
 
         auto begin() { return iterator(this); }
         auto cbegin() const { return iterator(this); }
@@ -346,8 +384,10 @@ namespace core
         auto cend() const { return iterator(this); }
 
         container_t<int> iCell;
-        container_t<double> delta;
-        container_t<double> weight, charge, v;
+        container_t<particle_float_t> delta;
+        container_t<double> weight, charge;
+        container_t<particle_float_t> v;
+        container_t<std::uint64_t> id;
     };
 
 
@@ -3,7 +3,11 @@
 
 
 #include <cstddef>
+#include <cstdint>
+#include <cassert>
 #include <vector>
+#include <utility>
+#include <algorithm>
 
 #include "particle.hpp"
 #include "particle_array.hpp"
@@ -22,7 +26,7 @@ public:
     static auto get(Particle<dim> const& particle)
     {
         return std::forward_as_tuple(particle.weight, particle.charge, particle.iCell,
-                                     particle.delta, particle.v);
+                                     particle.delta, particle.v, particle.id);
     }
 
     static auto empty()
@@ -43,26 +47,131 @@ public:
 
     void pack(ContiguousParticles<dim>& copy)
     {
-        auto copyTo = [](auto& a, auto& idx, auto size, auto& v) {
-            std::copy(a.begin(), a.begin() + size, v.begin() + (idx * size));
-        };
-        std::size_t idx = 0;
-        while (this->hasNext())
+        pack(copy, it_, particles_.size() - it_);
+        it_ = particles_.size();
+    }
+
+
+    // copies the particles [first, first + size) in the first size particles of copy
+    void pack(ContiguousParticles<dim>& copy, std::size_t first, std::size_t size) const
+    {
+        assert(first + size <= particles_.size() and size <= copy.size());
+
+        for (std::size_t idx = 0; idx < size; ++idx)
+            copy_(particles_[first + idx], copy, idx);
+    }
+
+
+    /* calls onChunk(chunk, first, size) for consecutive chunks of at most chunkSize particles,
+     * the first size particles of chunk being the particles [first, first + size).
+     * A single chunk is allocated, so that the memory used does not grow with the number of
+     * particles.
+     */
+    template<typename OnChunk>
+    void pack_chunks(std::size_t chunkSize, OnChunk&& onChunk) const
+    {
+        assert(chunkSize > 0);
+        if (particles_.size() == 0)
+            return;
+
+        ContiguousParticles<dim> chunk{std::min(chunkSize, particles_.size())};
+        for (std::size_t first = 0; first < particles_.size(); first += chunkSize)
         {
-            auto next        = this->next();
-            copy.weight[idx] = std::get<0>(next);
-            copy.charge[idx] = std::get<1>(next);
-            copyTo(std::get<2>(next), idx, dim, copy.iCell);
-            copyTo(std::get<3>(next), idx, dim, copy.delta);
-            copyTo(std::get<4>(next), idx, 3, copy.v);
-            idx++;
+            auto const size = std::min(chunkSize, particles_.size() - first);
+            pack(chunk, first, size);
+            onChunk(std::as_const(chunk), first, size);
+        }
+    }
+
+
+    /* same as above for the particles for which select(index, particle) is true, first being
+     * the number of particles selected before the chunk. The particles are selected while
+     * they are copied in the chunk.
+     */
+    template<typename Select, typename OnChunk>
+    void pack_chunks(std::size_t chunkSize, Select const& select, OnChunk&& onChunk) const
+    {
+        assert(chunkSize > 0);
+        if (particles_.size() == 0)
+            return;
+
+        ContiguousParticles<dim> chunk{std::min(chunkSize, particles_.size())};
+        std::size_t first = 0, size = 0;
+        for (std::size_t idx = 0; idx < particles_.size(); ++idx)
+        {
+            if (!select(idx, particles_[idx]))
+                continue;
+            copy_(particles_[idx], chunk, size++);
+            if (size == chunk.size())
+            {
+                onChunk(std::as_const(chunk), first, size);
+                first += std::exchange(size, 0);
+            }
+        }
+        if (size > 0)
+            onChunk(std::as_const(chunk), first, size);
+    }
+
+
+    /* calls onField(key, values) for each key of keys(), values being the contiguous values of
+     * this field for all particles. Fields are copied one at a time, for writers needing a
+     * field in a single piece.
+     */
+    template<typename OnField>
+    void pack_fields(OnField&& onField) const
+    {
+        {
+            std::vector<double> values(particles_.size());
+            for (auto const& [key, member] : {std::make_pair(keys_[0], &Particle<dim>::weight),
+                                              std::make_pair(keys_[1], &Particle<dim>::charge)})
+            {
+                for (std::size_t idx = 0; idx < particles_.size(); ++idx)
+                    values[idx] = particles_[idx].*member;
+                onField(key, std::as_const(values));
+            }
+        }
+        onField(keys_[2], flatten_(&Particle<dim>::iCell));
+        onField(keys_[3], flatten_(&Particle<dim>::delta));
+        onField(keys_[4], flatten_(&Particle<dim>::v));
+        {
+            std::vector<std::uint64_t> ids(particles_.size());
+            for (std::size_t idx = 0; idx < particles_.size(); ++idx)
+                ids[idx] = particles_[idx].id;
+            onField(keys_[5], std::as_const(ids));
         }
     }
 
 private:
+    static void copy_(Particle<dim> const& particle, ContiguousParticles<dim>& copy,
+                      std::size_t idx)
+    {
+        copy.weight[idx] = particle.weight;
+        copy.charge[idx] = particle.charge;
+        std::copy(particle.iCell.begin(), particle.iCell.end(), copy.iCell.begin() + idx * dim);
+        std::copy(particle.delta.begin(), particle.delta.end(), copy.delta.begin() + idx * dim);
+        std::copy(particle.v.begin(), particle.v.end(), copy.v.begin() + idx * 3);
+        copy.id[idx] = particle.id;
+    }
+
+
+    template<typename Array>
+    auto flatten_(Array Particle<dim>::*member) const
+    {
+        auto constexpr size = std::tuple_size_v<Array>;
+        std::vector<typename Array::value_type> values(particles_.size() * size);
+        for (std::size_t idx = 0; idx < particles_.size(); ++idx)
+        {
+            auto const& array = particles_[idx].*member;
+            std::copy(array.begin(), array.end(), values.begin() + idx * size);
+        }
+        return values;
+    }
+
+
     ParticleArray<dim> const& particles_;
     std::size_t it_ = 0;
-    static inline std::array<std::string, 5> keys_{"weight", "charge", "iCell", "delta", "v"};
+    static inline std::array<std::string, 6> keys_{"weight", "charge", "iCell",
+                                                   "delta",  "v",      "id"};
 };
 
 
@@ -0,0 +1,93 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_PARTICLE_SELECTOR_HPP
+#define PHARE_CORE_DATA_PARTICLES_PARTICLE_SELECTOR_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "core/data/particles/particle.hpp"
+#include "core/utilities/philox.hpp"
+#include "core/utilities/box/box.hpp"
+#include "core/utilities/point/point.hpp"
+
+
+namespace PHARE::core
+{
+/** \brief ParticleSelector tells which particles of an array are kept, e.g. by a diagnostic
+ *
+ * A particle is kept if it passes all the enabled criteria:
+ *  - stride   : keeps the particles of index 0, stride, 2 * stride, ... of the array
+ *  - fraction : keeps the particles whose hash, in [0, 1), is below fraction. The hash only
+ *               depends on the id of the particle, so that a particle selected in a dump is
+ *               selected in all of them, whatever the domain decomposition or particle order
+ *  - boxes    : keeps the particles within one of the boxes, which are in level index
+ *               units, i.e. the particle position is iCell + delta
+ *  - minEnergy: keeps the particles of kinetic energy 0.5 * mass * v^2 >= minEnergy
+ */
+template<std::size_t dim>
+struct ParticleSelector
+{
+    std::size_t stride = 1;
+    double fraction    = 1;
+    std::vector<Box<double, dim>> boxes;
+    double minEnergy = 0;
+    double mass      = 1;
+
+
+    bool all() const { return stride == 1 and fraction >= 1 and boxes.empty() and minEnergy <= 0; }
+
+
+    bool operator()(std::size_t index, Particle<dim> const& particle) const
+    {
+        if (index % stride != 0)
+            return false;
+
+        if (fraction < 1 and hash(particle) >= fraction)
+            return false;
+
+        if (!boxes.empty())
+        {
+            Point<double, dim> position;
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                position[iDim] = particle.iCell[iDim] + particle.delta[iDim];
+            if (!isIn(position, boxes))
+                return false;
+        }
+
+        if (minEnergy > 0)
+        {
+            double energy = 0;
+            for (auto const v : particle.v)
+                energy += 0.5 * mass * v * v;
+            if (energy < minEnergy)
+                return false;
+        }
+
+        return true;
+    }
+
+
+    template<typename Particles>
+    std::size_t count(Particles const& particles) const
+    {
+        if (all())
+            return particles.size();
+
+        std::size_t nbrSelected = 0;
+        for (std::size_t idx = 0; idx < particles.size(); ++idx)
+            nbrSelected += (*this)(idx, particles[idx]);
+        return nbrSelected;
+    }
+
+
+    // splitmix64 of the particle id, mapped to [0, 1)
+    static double hash(Particle<dim> const& particle)
+    {
+        return (Philox::mix(particle.id) >> 11) * 0x1.0p-53;
+    }
+};
+
+
+} // namespace PHARE::core
+
+
+#endif /* PHARE_CORE_DATA_PARTICLES_PARTICLE_SELECTOR_HPP */
@@ -26,8 +26,9 @@ auto positionAsPoint(Particle<GridLayout::dimension> const& particle, GridLayout
     for (auto iDim = 0u; iDim < GridLayout::dimension; ++iDim)
     {
         position[iDim] = origin[iDim];
-        position[iDim]
-            += (iCell[iDim] - startIndexes[iDim] + particle.delta[iDim]) * meshSize[iDim];
+        position[iDim] += (iCell[iDim] - startIndexes[iDim]
+                           + static_cast<double>(particle.delta[iDim]))
+                          * meshSize[iDim];
     }
     return position;
 }
@@ -4,8 +4,11 @@
 #include "core/data/grid/gridlayoutdefs.hpp"
 #include "core/data/vecfield/vecfield_component.hpp"
 #include "initializer/data_provider.hpp"
+#include "initializer/init_function_cache.hpp"
+#include "initializer/init_profiles.hpp"
 
 #include <array>
+#include <vector>
 
 namespace PHARE
 {
@@ -14,13 +17,16 @@ namespace core
     template<std::size_t dimension>
     class VecFieldInitializer
     {
+        using Cache  = initializer::InitFunctionCache<dimension>;
+        using Coords = std::array<typename Cache::Coords, 3>;
+
     public:
         VecFieldInitializer() = default;
 
         VecFieldInitializer(initializer::PHAREDict const& dict)
-            : x_{dict["x_component"].template to<initializer::InitFunction<dimension>>()}
-            , y_{dict["y_component"].template to<initializer::InitFunction<dimension>>()}
-            , z_{dict["z_component"].template to<initializer::InitFunction<dimension>>()}
+            : x_{initializer::initFunction<dimension>(dict["x_component"])}
+            , y_{initializer::initFunction<dimension>(dict["y_component"])}
+            , z_{initializer::initFunction<dimension>(dict["z_component"])}
         {
         }
 
@@ -31,21 +37,64 @@ namespace core
             static_assert(GridLayout::dimension == VecField::dimension,
                           "dimension mismatch between vecfield and gridlayout");
 
-            initializeComponent_(v.getComponent(Component::X), layout, x_);
-            initializeComponent_(v.getComponent(Component::Y), layout, y_);
-            initializeComponent_(v.getComponent(Component::Z), layout, z_);
+            auto function = [&](std::size_t iComponent) -> auto const& {
+                return prefetched_[iComponent] ? prefetched_[iComponent]
+                                               : *std::array{&x_, &y_, &z_}[iComponent];
+            };
+            initializeComponent_(v.getComponent(Component::X), layout, function(0));
+            initializeComponent_(v.getComponent(Component::Y), layout, function(1));
+            initializeComponent_(v.getComponent(Component::Z), layout, function(2));
+        }
+
+
+        // init function coordinates of the components of v, set on the patch of the layout
+        template<typename VecField, typename GridLayout>
+        Coords coordinates(VecField const& v, GridLayout const& layout) const
+        {
+            return {coordinates_(v.getComponent(Component::X), layout),
+                    coordinates_(v.getComponent(Component::Y), layout),
+                    coordinates_(v.getComponent(Component::Z), layout)};
+        }
+
+
+        /* the components are then evaluated once for the coordinates of all patches, see
+         * InitFunctionCache. The values are kept until the next prefetch, an empty set of
+         * coordinates releasing them.
+         */
+        void prefetch(std::vector<Coords> const& coords)
+        {
+            prefetched_ = {};
+            if (coords.empty())
+                return;
+
+            std::vector<typename Cache::Coords> componentCoords(coords.size());
+            for (std::size_t iComponent = 0; iComponent < 3; ++iComponent)
+            {
+                for (std::size_t iPatch = 0; iPatch < coords.size(); ++iPatch)
+                    componentCoords[iPatch] = coords[iPatch][iComponent];
+                auto const& function = *std::array{&x_, &y_, &z_}[iComponent];
+                prefetched_[iComponent] = Cache::prefetched(function, componentCoords);
+            }
         }
 
     private:
         template<typename Field, typename GridLayout>
-        void initializeComponent_(Field& field, GridLayout const& layout,
-                                  initializer::InitFunction<dimension> const& init)
+        static auto coordinates_(Field const& field, GridLayout const& layout)
         {
             auto const indices = layout.ghostStartToEndIndices(field, /*includeEnd=*/true);
-            auto const coords  = layout.template indexesToCoordVectors</*WithField=*/true>(
+            return layout.template indexesToCoordVectors</*WithField=*/true>(
                 indices, field, [](auto& gridLayout, auto& field_, auto const&... args) {
                     return gridLayout.fieldNodeCoordinates(field_, gridLayout.origin(), args...);
                 });
+        }
+
+
+        template<typename Field, typename GridLayout>
+        void initializeComponent_(Field& field, GridLayout const& layout,
+                                  initializer::InitFunction<dimension> const& init)
+        {
+            auto const indices = layout.ghostStartToEndIndices(field, /*includeEnd=*/true);
+            auto const coords  = coordinates_(field, layout);
 
             std::shared_ptr<Span<double>> gridPtr // keep grid data alive
                 = std::apply([&](auto&... args) { return init(args...); }, coords);
@@ -61,6 +110,7 @@ namespace core
         initializer::InitFunction<dimension> x_;
         initializer::InitFunction<dimension> y_;
         initializer::InitFunction<dimension> z_;
+        std::array<initializer::InitFunction<dimension>, 3> prefetched_;
     };
 
 } // namespace core
@@ -4,10 +4,17 @@
 
 
 #include <array>
+#include <string>
+#include <vector>
 #include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <functional>
 
 #include "core/data/grid/gridlayout.hpp"
+#include "core/data/ndarray/ndarray_vector.hpp"
 #include "core/data/vecfield/vecfield_component.hpp"
+#include "core/utilities/index/index.hpp"
 #include "core/utilities/point/point.hpp"
 
 #include "core/logger.hpp"
@@ -172,6 +179,29 @@ public:
         }
         return fieldAtParticle;
     }
+
+    /** Performs the 1D interpolation of all the components of collocated nodes at once
+     * \param[in] nodes are the collocated values, one record of components per primal node
+     * \param[in] startIndex is the first of the nbrPointsSupport primal indices
+     * \param[in] weights are the nbrPointsSupport primal weights
+     */
+    template<typename Nodes, typename Starts, typename Weights>
+    inline auto operator()(Nodes const& nodes, Starts const& startIndex, Weights const& weights)
+    {
+        auto const& [xStartIndex] = startIndex;
+        auto const& [xWeights]    = weights;
+        auto const& order_size    = xWeights.size();
+
+        typename Nodes::node_type valuesAtParticle{};
+
+        for (auto ik = 0u; ik < order_size; ++ik)
+        {
+            auto const& node = nodes(xStartIndex + ik);
+            for (auto ic = 0u; ic < valuesAtParticle.size(); ++ic)
+                valuesAtParticle[ic] += node[ic] * xWeights[ik];
+        }
+        return valuesAtParticle;
+    }
 };
 
 
@@ -212,6 +242,34 @@ public:
 
         return fieldAtParticle;
     }
+
+    /** Performs the 2D interpolation of all the components of collocated nodes at once
+     * \param[in] nodes are the collocated values, one record of components per primal node
+     * \param[in] startIndex is the first of the nbrPointsSupport primal indices in both
+     * directions \param[in] weights are the nbrPointsSupport primal weights in both directions
+     */
+    template<typename Nodes, typename Starts, typename Weights>
+    inline auto operator()(Nodes const& nodes, Starts const& startIndex, Weights const& weights)
+    {
+        auto const& [xStartIndex, yStartIndex] = startIndex;
+        auto const& [xWeights, yWeights]       = weights;
+        auto const& order_size                 = xWeights.size();
+
+        typename Nodes::node_type valuesAtParticle{};
+
+        for (auto ix = 0u; ix < order_size; ++ix)
+        {
+            for (auto iy = 0u; iy < order_size; ++iy)
+            {
+                auto const& node = nodes(xStartIndex + ix, yStartIndex + iy);
+                auto const w     = xWeights[ix] * yWeights[iy];
+                for (auto ic = 0u; ic < valuesAtParticle.size(); ++ic)
+                    valuesAtParticle[ic] += node[ic] * w;
+            }
+        }
+
+        return valuesAtParticle;
+    }
 };
 
 
@@ -259,6 +317,37 @@ public:
         }
         return fieldAtParticle;
     }
+
+    /** Performs the 3D interpolation of all the components of collocated nodes at once
+     * \param[in] nodes are the collocated values, one record of components per primal node
+     * \param[in] startIndex is the first of the nbrPointsSupport primal indices in the 3
+     * directions \param[in] weights are the nbrPointsSupport primal weights in the 3 directions
+     */
+    template<typename Nodes, typename Starts, typename Weights>
+    inline auto operator()(Nodes const& nodes, Starts const& startIndex, Weights const& weights)
+    {
+        auto const& [xStartIndex, yStartIndex, zStartIndex] = startIndex;
+        auto const& [xWeights, yWeights, zWeights]          = weights;
+        auto const& order_size                              = xWeights.size();
+
+        typename Nodes::node_type valuesAtParticle{};
+
+        for (auto ix = 0u; ix < order_size; ++ix)
+        {
+            for (auto iy = 0u; iy < order_size; ++iy)
+            {
+                for (auto iz = 0u; iz < order_size; ++iz)
+                {
+                    auto const& node
+                        = nodes(xStartIndex + ix, yStartIndex + iy, zStartIndex + iz);
+                    auto const w = xWeights[ix] * yWeights[iy] * zWeights[iz];
+                    for (auto ic = 0u; ic < valuesAtParticle.size(); ++ic)
+                        valuesAtParticle[ic] += node[ic] * w;
+                }
+            }
+        }
+        return valuesAtParticle;
+    }
 };
 
 
@@ -414,6 +503,111 @@ public: /** Performs the 3D interpolation
 
 
 
+//! FieldGather selects how electromagnetic fields are gathered onto particles
+//! - staggered  : each component is interpolated from its own Yee grid
+//! - collocated : E and B are first projected on primal nodes, then gathered at once
+enum class FieldGather { staggered, collocated };
+
+
+inline FieldGather fieldGatherFromString(std::string const& name)
+{
+    if (name == "staggered")
+        return FieldGather::staggered;
+    if (name == "collocated")
+        return FieldGather::collocated;
+    throw std::runtime_error("Error : Invalid field gather name " + name);
+}
+
+
+
+/** \brief CollocatedElectromag holds the six electromagnetic components projected on the
+ * primal nodes of a GridLayout, stored interleaved (Ex, Ey, Ez, Bx, By, Bz) per node.
+ *
+ * Gathering from it costs one primal stencil over contiguous records per particle
+ * instead of six stencils over six separate staggered arrays.
+ * The outermost primal ghost nodes have no dual neighbour on one side and are left at zero,
+ * particles never reach them.
+ */
+template<std::size_t dim>
+class CollocatedElectromag
+{
+public:
+    static constexpr std::size_t dimension     = dim;
+    static constexpr std::size_t nbrComponents = 6;
+    using node_type                            = std::array<double, nbrComponents>;
+
+    template<typename Electromag, typename GridLayout>
+    void project(Electromag const& em, GridLayout const& layout)
+    {
+        PHARE_LOG_SCOPE("CollocatedElectromag::project");
+
+        auto const& [Ex, Ey, Ez] = em.E();
+        auto const& [Bx, By, Bz] = em.B();
+
+        shape_ = layout.allocSize(HybridQuantity::Scalar::rho);
+        nodes_.assign(std::accumulate(shape_.begin(), shape_.end(), std::size_t{1},
+                                      std::multiplies<std::size_t>()),
+                      node_type{});
+
+        auto constexpr ExToMoments = GridLayout::ExToMoments();
+        auto constexpr EyToMoments = GridLayout::EyToMoments();
+        auto constexpr EzToMoments = GridLayout::EzToMoments();
+        auto constexpr BxToMoments = GridLayout::BxToMoments();
+        auto constexpr ByToMoments = GridLayout::ByToMoments();
+        auto constexpr BzToMoments = GridLayout::BzToMoments();
+
+        auto projectNode = [&](MeshIndex<dimension> const& index, node_type& node) {
+            node[0] = GridLayout::project(Ex, index, ExToMoments);
+            node[1] = GridLayout::project(Ey, index, EyToMoments);
+            node[2] = GridLayout::project(Ez, index, EzToMoments);
+            node[3] = GridLayout::project(Bx, index, BxToMoments);
+            node[4] = GridLayout::project(By, index, ByToMoments);
+            node[5] = GridLayout::project(Bz, index, BzToMoments);
+        };
+
+        if constexpr (dimension == 1)
+        {
+            for (std::uint32_t ix = 1; ix < shape_[0] - 1; ++ix)
+                projectNode({ix}, (*this)(ix));
+        }
+        else if constexpr (dimension == 2)
+        {
+            for (std::uint32_t ix = 1; ix < shape_[0] - 1; ++ix)
+                for (std::uint32_t iy = 1; iy < shape_[1] - 1; ++iy)
+                    projectNode({ix, iy}, (*this)(ix, iy));
+        }
+        else if constexpr (dimension == 3)
+        {
+            for (std::uint32_t ix = 1; ix < shape_[0] - 1; ++ix)
+                for (std::uint32_t iy = 1; iy < shape_[1] - 1; ++iy)
+                    for (std::uint32_t iz = 1; iz < shape_[2] - 1; ++iz)
+                        projectNode({ix, iy, iz}, (*this)(ix, iy, iz));
+        }
+    }
+
+
+    template<typename... Indexes>
+    node_type const& operator()(Indexes... indexes) const
+    {
+        return NdArrayViewer<dimension, true, node_type>::at(nodes_.data(), shape_, indexes...);
+    }
+
+    template<typename... Indexes>
+    node_type& operator()(Indexes... indexes)
+    {
+        return const_cast<node_type&>(static_cast<CollocatedElectromag const&>(*this)(indexes...));
+    }
+
+    auto& shape() const { return shape_; }
+
+private:
+    std::array<std::uint32_t, dimension> shape_{};
+    std::vector<node_type> nodes_;
+};
+
+
+
+
 /** \brief Interpolator is used to perform particle-mesh interpolations using
  * 1st, 2nd or 3rd order interpolation in 1D, 2D or 3D, on a given layout.
  */
@@ -444,7 +638,7 @@ class Interpolator : private Weighter<interpOrder>
             startIndex_[iDim]
                 = iCell[iDim] - computeStartLeftShift<CenteringT, centering>(delta[iDim]);
 
-            double normalizedPos = iCell[iDim] + delta[iDim];
+            double normalizedPos = iCell[iDim] + static_cast<double>(delta[iDim]);
 
             if constexpr (centering == QtyCentering::dual)
                 normalizedPos -= dual_offset;
@@ -456,6 +650,29 @@ class Interpolator : private Weighter<interpOrder>
 public:
     auto static constexpr interp_order = interpOrder;
     auto static constexpr dimension    = dim;
+
+    Interpolator(FieldGather fieldGather = FieldGather::staggered)
+        : fieldGather_{fieldGather}
+    {
+    }
+
+    auto fieldGather() const { return fieldGather_; }
+
+
+    /**\brief prepare the gathering of the electromagnetic fields of the given layout
+     *
+     * In collocated mode, E and B are projected once onto the primal nodes of the layout,
+     * the following calls to operator()(particleRange, Em, layout) then interpolate from this
+     * projection. This must be called whenever the fields or the layout change.
+     * Nothing is done in staggered mode.
+     */
+    template<typename Electromag, typename GridLayout>
+    void prepareGather(Electromag const& Em, GridLayout const& layout)
+    {
+        if (fieldGather_ == FieldGather::collocated)
+            collocatedEM_.project(Em, layout);
+    }
+
     /**\brief interpolate electromagnetic fields on all particles in the range
      *
      * For each particle :
@@ -473,6 +690,28 @@ public:
         auto begin = particleRange.begin();
         auto end   = particleRange.end();
 
+        if (fieldGather_ == FieldGather::collocated)
+        {
+            PHARE_LOG_START("MeshToParticle::collocated");
+            for (auto currPart = begin; currPart != end; ++currPart)
+            {
+                indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, currPart->iCell,
+                                                                     currPart->delta);
+
+                auto const& [ex, ey, ez, bx, by, bz]
+                    = meshToParticle_(collocatedEM_, primal_startIndex_, primal_weights_);
+
+                currPart->Ex = ex;
+                currPart->Ey = ey;
+                currPart->Ez = ez;
+                currPart->Bx = bx;
+                currPart->By = by;
+                currPart->Bz = bz;
+            }
+            PHARE_LOG_STOP("MeshToParticle::collocated");
+            return;
+        }
+
         using Scalar             = HybridQuantity::Scalar;
         auto const& [Ex, Ey, Ez] = Em.E();
         auto const& [Bx, By, Bz] = Em.B();
@@ -523,10 +762,8 @@ public:
     inline void operator()(ParticleRange&& particleRange, Field& density, VecField& flux,
                            GridLayout const& layout, double coef = 1.)
     {
-        auto begin        = particleRange.begin();
-        auto end          = particleRange.end();
-        auto& startIndex_ = primal_startIndex_;
-        auto& weights_    = primal_weights_;
+        auto begin = particleRange.begin();
+        auto end   = particleRange.end();
 
         // for each particle, first calculate the startIndex and weights
         // for dual and primal quantities.
@@ -538,17 +775,29 @@ public:
         PHARE_LOG_START("ParticleToMesh::operator()");
 
         for (auto currPart = begin; currPart != end; ++currPart)
-        {
-            // TODO #3375
-            indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, currPart->iCell,
-                                                                 currPart->delta);
+            deposit(*currPart, density, flux, layout, coef);
 
-            particleToMesh_(density, flux, *currPart, startIndex_, weights_, coef);
-        }
         PHARE_LOG_STOP("ParticleToMesh::operator()");
     }
 
 
+    /**\brief deposit the density and flux of a single particle on the mesh
+     *
+     * this is what operator()(particleRange, density, flux, layout) does for each particle
+     * of the range, and can be called right after a particle is moved.
+     */
+    template<typename Particle, typename VecField, typename GridLayout, typename Field>
+    inline void deposit(Particle const& particle, Field& density, VecField& flux,
+                        GridLayout const& layout, double coef = 1.)
+    {
+        // TODO #3375
+        indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, particle.iCell,
+                                                             particle.delta);
+
+        particleToMesh_(density, flux, particle, primal_startIndex_, primal_weights_, coef);
+    }
+
+
     /**
      * @brief Given a delta and an interpolation order, deduce which lower index to start
      * traversing from
@@ -592,6 +841,9 @@ private:
     using Starts  = std::array<std::uint32_t, dimension>;
     using Weights = std::array<std::array<double, nbrPointsSupport(interpOrder)>, dimension>;
 
+    FieldGather fieldGather_ = FieldGather::staggered;
+    CollocatedElectromag<dimension> collocatedEM_;
+
     Weighter<interpOrder> weightComputer_;
     MeshToParticle<dimension> meshToParticle_;
     ParticleToMesh<dimension> particleToMesh_;
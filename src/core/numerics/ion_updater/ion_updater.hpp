@@ -9,6 +9,7 @@
 #include "core/numerics/pusher/pusher_factory.hpp"
 #include "core/numerics/boundary_condition/boundary_condition.hpp"
 #include "core/numerics/moments/moments.hpp"
+#include "core/numerics/population_control/population_control.hpp"
 #include "core/data/ions/ions.hpp"
 
 #include "initializer/data_provider.hpp"
@@ -38,8 +39,10 @@ public:
     using PartIterator      = typename ParticleArray::iterator;
     using ParticleRange     = IndexRange<ParticleArray>;
     using BoundaryCondition = PHARE::core::BoundaryCondition<dimension, interp_order>;
-    using Pusher = PHARE::core::Pusher<dimension, ParticleRange, Electromag, Interpolator,
-                                       BoundaryCondition, GridLayout>;
+    // the pusher PusherFactory makes, held with its type since the deposit fused to its push
+    // is a template parameter, not a virtual call
+    using Pusher = PHARE::core::BorisPusher<dimension, ParticleRange, Electromag, Interpolator,
+                                            BoundaryCondition, GridLayout>;
 
 private:
     constexpr static auto makePusher
@@ -48,10 +51,13 @@ private:
 
     std::unique_ptr<Pusher> pusher_;
     Interpolator interpolator_;
+    PopulationControl<ParticleArray> populationControl_;
 
 public:
     IonUpdater(PHARE::initializer::PHAREDict const& dict)
         : pusher_{makePusher(dict["pusher"]["name"].template to<std::string>())}
+        , interpolator_{makeFieldGather(dict)}
+        , populationControl_{makePopulationControl(dict)}
     {
     }
 
@@ -63,6 +69,21 @@ public:
 
 
 private:
+    static FieldGather makeFieldGather(PHARE::initializer::PHAREDict const& dict)
+    {
+        if (dict.contains("field_gather"))
+            return fieldGatherFromString(dict["field_gather"].template to<std::string>());
+        return FieldGather::staggered;
+    }
+
+    static PopulationControl<ParticleArray>
+    makePopulationControl(PHARE::initializer::PHAREDict const& dict)
+    {
+        if (dict.contains("population_control"))
+            return PopulationControl<ParticleArray>{dict["population_control"]};
+        return {};
+    }
+
     void updateAndDepositDomain_(Ions& ions, Electromag const& em, GridLayout const& layout);
 
     void updateAndDepositAll_(Ions& ions, Electromag const& em, GridLayout const& layout);
@@ -80,6 +101,7 @@ void IonUpdater<Ions, Electromag, GridLayout>::updatePopulations(Ions& ions, Ele
 
     resetMoments(ions);
     pusher_->setMeshAndTimeStep(layout.meshSize(), dt);
+    interpolator_.prepareGather(em, layout);
 
     if (mode == UpdaterMode::domain_only)
     {
@@ -144,11 +166,15 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositDomain_(Ions& ion
         auto inRange  = makeIndexRange(domain);
         auto outRange = makeIndexRange(domain);
 
+        // moments of particles still in the domain are deposited as they are pushed
+        auto depositInDomain = [&](Particle_t const& particle) {
+            if (isIn(Point{particle.iCell}, domainBox))
+                interpolator_.deposit(particle, pop.density(), pop.flux(), layout);
+        };
+
         auto inDomain = pusher_->move(
             inRange, outRange, em, pop.mass(), interpolator_, layout,
-            [](auto& particleRange) { return particleRange; }, inDomainBox);
-
-        interpolator_(inDomain, pop.density(), pop.flux(), layout);
+            [](auto& particleRange) { return particleRange; }, inDomainBox, depositInDomain);
 
         // TODO : we can erase here because we know we are working on a state
         // that has been saved in the solverPPC
@@ -169,10 +195,9 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositDomain_(Ions& ion
             inRange  = makeIndexRange(inputArray);
             outRange = makeIndexRange(outputArray);
 
-            auto enteredInDomain = pusher_->move(inRange, outRange, em, pop.mass(), interpolator_,
-                                                 layout, inGhostBox, inDomainBox);
-
-            interpolator_(enteredInDomain, pop.density(), pop.flux(), layout);
+            auto enteredInDomain
+                = pusher_->move(inRange, outRange, em, pop.mass(), interpolator_, layout,
+                                inGhostBox, inDomainBox, depositInDomain);
 
             if (copyInDomain)
             {
@@ -238,9 +263,22 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositAll_(Ions& ions,
         auto& domainParticles = pop.domainParticles();
         auto domainPartRange  = makeIndexRange(domainParticles);
 
-        auto inDomain = pusher_->move(
-            domainPartRange, domainPartRange, em, pop.mass(), interpolator_, layout,
-            [](auto const& particleRange) { return particleRange; }, inDomainBox);
+        // without population control, moments are deposited as particles are pushed
+        // rather than in a final loop over the domain particles
+        bool const fused = !populationControl_.enabled();
+
+        auto depositInDomain = [&](Particle_t const& particle) {
+            if (isIn(Point{particle.iCell}, domainBox))
+                interpolator_.deposit(particle, pop.density(), pop.flux(), layout);
+        };
+
+        auto noSelection = [](auto const& particleRange) { return particleRange; };
+
+        auto inDomain = fused ? pusher_->move(domainPartRange, domainPartRange, em, pop.mass(),
+                                              interpolator_, layout, noSelection, inDomainBox,
+                                              depositInDomain)
+                              : pusher_->move(domainPartRange, domainPartRange, em, pop.mass(),
+                                              interpolator_, layout, noSelection, inDomainBox);
 
         domainParticles.erase(makeRange(domainParticles, inDomain.iend(), domainParticles.size()));
 
@@ -249,9 +287,15 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositAll_(Ions& ions,
                                                    interpolator_, layout, inGhostBox, inGhostLayer);
 
             auto& particleArray = particleRange.array();
+            auto const nbrDomain = domainParticles.size();
             particleArray.export_particles(
                 domainParticles, [&](auto const& cell) { return isIn(Point{cell}, domainBox); });
 
+            // only ghost particles that just entered the domain have not been deposited yet
+            if (fused)
+                interpolator_(makeRange(domainParticles, nbrDomain, domainParticles.size()),
+                              pop.density(), pop.flux(), layout);
+
             particleArray.erase(
                 makeRange(particleArray, inGhostLayerRange.iend(), particleArray.size()));
         };
@@ -259,7 +303,13 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositAll_(Ions& ions,
         pushAndCopyInDomain(makeIndexRange(pop.patchGhostParticles()));
         pushAndCopyInDomain(makeIndexRange(pop.levelGhostParticles()));
 
-        interpolator_(makeIndexRange(domainParticles), pop.density(), pop.flux(), layout);
+        // merge/split particles of over/under populated cells before they are deposited
+        // so that moments are those of the particles sent to neighbor patches
+        if (!fused)
+        {
+            populationControl_(domainParticles, domainBox);
+            interpolator_(makeIndexRange(domainParticles), pop.density(), pop.flux(), layout);
+        }
     }
 }
 
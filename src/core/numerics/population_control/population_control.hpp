@@ -0,0 +1,271 @@
+#ifndef PHARE_CORE_NUMERICS_POPULATION_CONTROL_HPP
+#define PHARE_CORE_NUMERICS_POPULATION_CONTROL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/data/particles/particle.hpp"
+#include "core/utilities/box/box.hpp"
+#include "core/logger.hpp"
+
+#include "initializer/data_provider.hpp"
+
+
+namespace PHARE::core
+{
+/** \brief PopulationControl keeps the number of particles per cell (ppc) of a ParticleArray
+ * between min_ppc and max_ppc, using the cell counts of its CellMap.
+ *
+ * Cells with more than max_ppc particles are merged down to target_ppc particles.
+ * The particles of the cell are sorted by kinetic energy and cut in target_ppc/2 groups.
+ * Each group is replaced by two particles carrying half the group weight, located at the
+ * weighted mean position of the group, with velocities u + sigma and u - sigma, u being the
+ * weighted mean velocity of the group and sigma the weighted standard deviation of each
+ * velocity component. The weight (i.e. the charge), momentum and kinetic energy of each group
+ * are conserved.
+ *
+ * Cells with less than min_ppc particles (but at least one) are split up to target_ppc
+ * particles. The heaviest particle is replaced by two particles of half its weight with the
+ * same velocity, displaced symmetrically around its position, which conserves charge,
+ * momentum, energy and the center of charge of the cell.
+ *
+ * max_ppc == 0 disables merging, min_ppc == 0 disables splitting.
+ */
+template<typename ParticleArray>
+class PopulationControl
+{
+    static constexpr auto dimension = ParticleArray::dimension;
+    using Particle_t                = typename ParticleArray::Particle_t;
+    using float_type                = typename Particle_t::float_type;
+
+public:
+    using box_t = Box<int, dimension>;
+
+    PopulationControl() = default;
+
+    PopulationControl(std::size_t target_ppc, std::size_t min_ppc, std::size_t max_ppc)
+        : target_ppc_{target_ppc}
+        , min_ppc_{min_ppc}
+        , max_ppc_{max_ppc}
+    {
+        if (max_ppc_ > 0 and (target_ppc_ < 2 or target_ppc_ > max_ppc_))
+            throw std::runtime_error("PopulationControl: target_ppc must be in [2, max_ppc]");
+        if (min_ppc_ > 0 and target_ppc_ < min_ppc_)
+            throw std::runtime_error("PopulationControl: target_ppc must be >= min_ppc");
+    }
+
+    explicit PopulationControl(PHARE::initializer::PHAREDict const& dict)
+        : PopulationControl{get_(dict, "target_ppc"), get_(dict, "min_ppc"),
+                            get_(dict, "max_ppc")}
+    {
+    }
+
+
+    bool enabled() const { return min_ppc_ > 0 or max_ppc_ > 0; }
+
+    auto target_ppc() const { return target_ppc_; }
+    auto min_ppc() const { return min_ppc_; }
+    auto max_ppc() const { return max_ppc_; }
+
+
+    /** merges and splits the particles of the cells of the given box, which must be within
+     * the box of the particle array. Only the particles of controlled cells are touched: they
+     * are overwritten in place by their replacements, extra replacements are appended, and
+     * left over particles are removed, the last particles of the array taking their places.
+     * The cell map is updated along. Returns the number of cells that were controlled.
+     */
+    std::size_t operator()(ParticleArray& particles, box_t const& box) const
+    {
+        PHARE_LOG_SCOPE("PopulationControl::operator()");
+
+        std::vector<std::size_t> removed; // indexes of the left over particles of merged cells
+        std::vector<std::size_t> cellIndexes;
+        std::vector<Particle_t> cellParticles, replacements;
+        std::size_t nbrCells = 0;
+
+        for (auto const& cell : box)
+        {
+            auto const& indexes = particles.indexes_in(cell);
+            auto const ppc      = indexes.size();
+
+            bool const merge = max_ppc_ > 0 and ppc > max_ppc_;
+            bool const split = min_ppc_ > 0 and ppc > 0 and ppc < min_ppc_;
+
+            if (!merge and !split)
+                continue;
+
+            // copied as appending particles to the cell changes its indexes
+            cellIndexes.assign(indexes.begin(), indexes.end());
+            cellParticles.clear();
+            replacements.clear();
+            for (auto const index : cellIndexes)
+                cellParticles.push_back(particles[index]);
+
+            if (merge)
+                merge_(cellParticles, replacements);
+            else
+                split_(cellParticles, replacements);
+
+            // replacements stay in the cell, the map of overwritten particles is unchanged
+            auto const nbrInPlace = std::min(cellIndexes.size(), replacements.size());
+            for (std::size_t i = 0; i < nbrInPlace; ++i)
+                particles[cellIndexes[i]] = replacements[i];
+            for (auto i = nbrInPlace; i < replacements.size(); ++i)
+                particles.push_back(replacements[i]);
+            for (auto i = nbrInPlace; i < cellIndexes.size(); ++i)
+                removed.push_back(cellIndexes[i]);
+
+            ++nbrCells;
+        }
+
+        // from the last one, so that the particle moved in place of a removed one is kept
+        std::sort(removed.begin(), removed.end(), std::greater<std::size_t>{});
+        for (auto const index : removed)
+            particles.swap_last_reduce_by_one(index);
+
+        return nbrCells;
+    }
+
+
+
+private:
+    static std::size_t get_(PHARE::initializer::PHAREDict const& dict, std::string const& key)
+    {
+        if (dict.contains(key))
+            return static_cast<std::size_t>(dict[key].template to<int>());
+        return 0;
+    }
+
+
+    static double kineticEnergy_(Particle_t const& particle)
+    {
+        double v2 = 0;
+        for (auto const vi : particle.v)
+            v2 += static_cast<double>(vi) * vi;
+        return v2;
+    }
+
+
+    // keeps stored deltas in [0, 1[ when they are rounded to a reduced precision
+    static float_type toDelta_(double delta)
+    {
+        auto stored = static_cast<float_type>(delta);
+        if (stored >= 1)
+            stored = std::nextafter(float_type{1}, float_type{0});
+        return stored;
+    }
+
+
+    void merge_(std::vector<Particle_t>& cellParticles, std::vector<Particle_t>& merged) const
+    {
+        std::stable_sort(cellParticles.begin(), cellParticles.end(),
+                         [](auto const& p1, auto const& p2) {
+                             return kineticEnergy_(p1) < kineticEnergy_(p2);
+                         });
+
+        auto const nbrGroups = target_ppc_ / 2;
+        auto const ppc       = cellParticles.size();
+
+        for (std::size_t iGroup = 0; iGroup < nbrGroups; ++iGroup)
+        {
+            auto const first = cellParticles.begin() + (iGroup * ppc) / nbrGroups;
+            auto const last  = cellParticles.begin() + ((iGroup + 1) * ppc) / nbrGroups;
+
+            if (std::distance(first, last) < 2)
+            {
+                std::copy(first, last, std::back_inserter(merged));
+                continue;
+            }
+
+            double weight = 0;
+            std::array<double, dimension> delta{};
+            std::array<double, 3> v{};
+            for (auto it = first; it != last; ++it)
+            {
+                assert(it->charge == first->charge);
+                weight += it->weight;
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    delta[iDim] += it->weight * it->delta[iDim];
+                for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                    v[iComp] += it->weight * it->v[iComp];
+            }
+            for (auto& di : delta)
+                di /= weight;
+            for (auto& vi : v)
+                vi /= weight;
+
+            std::array<double, 3> sigma{};
+            for (auto it = first; it != last; ++it)
+                for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                {
+                    double const dv = it->v[iComp] - v[iComp];
+                    sigma[iComp] += it->weight * dv * dv;
+                }
+            for (auto& si : sigma)
+                si = std::sqrt(si / weight);
+
+            // the pair replacing the group takes the id of its first particle and one derived
+            for (auto const sign : {1., -1.})
+            {
+                Particle_t particle = *first;
+                particle.weight     = 0.5 * weight;
+                if (sign < 0)
+                    particle.id = derivedParticleId(first->id, 0);
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    particle.delta[iDim] = toDelta_(delta[iDim]);
+                for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                    particle.v[iComp] = v[iComp] + sign * sigma[iComp];
+                merged.push_back(particle);
+            }
+        }
+    }
+
+
+    void split_(std::vector<Particle_t>& cellParticles, std::vector<Particle_t>& split) const
+    {
+        while (cellParticles.size() < target_ppc_)
+        {
+            auto heaviest = std::max_element(
+                cellParticles.begin(), cellParticles.end(),
+                [](auto const& p1, auto const& p2) { return p1.weight < p2.weight; });
+
+            // the cell grows by one each time, a particle split several times gives distinct ids
+            auto particle = *heaviest;
+            particle.weight *= 0.5;
+            particle.id      = derivedParticleId(heaviest->id, cellParticles.size());
+            heaviest->weight = particle.weight;
+
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                double const delta = heaviest->delta[iDim];
+                double const shift = 0.5 * std::min(delta, 1. - delta);
+
+                heaviest->delta[iDim] = toDelta_(delta - shift);
+                particle.delta[iDim]  = toDelta_(delta + shift);
+            }
+
+            cellParticles.push_back(particle);
+        }
+
+        std::copy(cellParticles.begin(), cellParticles.end(), std::back_inserter(split));
+    }
+
+
+    std::size_t target_ppc_ = 0;
+    std::size_t min_ppc_    = 0;
+    std::size_t max_ppc_    = 0;
+};
+
+
+} // namespace PHARE::core
+
+
+#endif // PHARE_CORE_NUMERICS_POPULATION_CONTROL_HPP
@@ -27,6 +27,14 @@ public:
 private:
     using ParticleSelector = typename Super::ParticleSelector;
 
+    struct NoDeposit
+    {
+        template<typename Particle>
+        void operator()(Particle const&) const
+        {
+        }
+    };
+
 public:
     // This move function should be considered when being used so that all particles are pushed
     // twice - see: https://github.com/PHAREHUB/PHARE/issues/571
@@ -78,6 +86,25 @@ public:
                        Electromag const& emFields, double mass, Interpolator& interpolator,
                        GridLayout const& layout, ParticleSelector firstSelector,
                        ParticleSelector secondSelector) override
+    {
+        return move(rangeIn, rangeOut, emFields, mass, interpolator, layout,
+                    std::move(firstSelector), std::move(secondSelector), NoDeposit{});
+    }
+
+
+
+    /** same as the above move() but the given deposit is called on each particle of
+     * rangeOut as soon as it has reached its final position, i.e. while it is still in
+     * cache, so that moments can be accumulated without looping again over the particles.
+     * The deposit is called before secondSelector is applied, so it must itself ignore
+     * particles that secondSelector will reject. It is a template parameter so that it is
+     * inlined in the push loop.
+     */
+    template<typename Deposit>
+    ParticleRange move(ParticleRange const& rangeIn, ParticleRange& rangeOut,
+                       Electromag const& emFields, double mass, Interpolator& interpolator,
+                       GridLayout const& layout, ParticleSelector firstSelector,
+                       ParticleSelector secondSelector, Deposit&& deposit)
     {
         PHARE_LOG_SCOPE("Boris::move_no_bc");
 
@@ -85,7 +112,7 @@ public:
         // rangeIn : t=n, rangeOut : t=n+1/2
         // Do not partition on this step - this is to keep all domain and ghost
         //   particles consistent. see: https://github.com/PHAREHUB/PHARE/issues/571
-        pushStep_(rangeIn, rangeOut, PushStep::PrePush);
+        pushStep_(rangeIn, rangeOut, PushStep::PrePush, NoDeposit{});
 
         rangeOut = firstSelector(rangeOut);
 
@@ -97,8 +124,8 @@ public:
         accelerate_(rangeOut, rangeOut, mass);
 
         // now advance the particles from t=n+1/2 to t=n+1 using v_{n+1} just calculated
-        // and get a pointer to the first leaving particle
-        pushStep_(rangeOut, rangeOut, PushStep::PostPush);
+        // and deposit them right away
+        pushStep_(rangeOut, rangeOut, PushStep::PostPush, deposit);
 
         return secondSelector(rangeOut);
     }
@@ -135,8 +162,15 @@ private:
             {
                 PHARE_LOG_ERROR("Error, particle moves more than 1 cell, delta >2");
             }
+            // the new delta is computed in double but may be stored in reduced precision
+            // (see ParticlePrecision), in which case it can round up to 1
             partOut.delta[iDim] = delta - iCell;
-            newCell[iDim]       = static_cast<int>(iCell + partIn.iCell[iDim]);
+            if (partOut.delta[iDim] >= 1)
+            {
+                partOut.delta[iDim] = 0;
+                iCell += 1;
+            }
+            newCell[iDim] = static_cast<int>(iCell + partIn.iCell[iDim]);
         }
         return newCell;
     }
@@ -147,8 +181,11 @@ private:
      * in rangeOut.
      * @return the function returns and iterator on the first leaving particle, as
      * detected by the ParticleSelector
+     * deposit is called on each pushed particle once in its new cell
      */
-    void pushStep_(ParticleRange const& rangeIn, ParticleRange& rangeOut, PushStep step)
+    template<typename Deposit>
+    void pushStep_(ParticleRange const& rangeIn, ParticleRange& rangeOut, PushStep step,
+                   Deposit&& deposit)
     {
         auto& inParticles  = rangeIn.array();
         auto& outParticles = rangeOut.array();
@@ -173,6 +210,7 @@ private:
             auto newCell = advancePosition_(inParticles[inIdx], outParticles[outIdx]);
             if (newCell != inParticles[inIdx].iCell)
                 outParticles.change_icell(newCell, outIdx);
+            deposit(outParticles[outIdx]);
         }
     }
 
@@ -0,0 +1,69 @@
+#ifndef PHARE_CORE_UTILITIES_ALIGNED_ALLOCATOR_HPP
+#define PHARE_CORE_UTILITIES_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief AlignedAllocator is a std allocator returning memory aligned on the given number
+ * of bytes, so that containers using it start on a cache line / SIMD register boundary.
+ */
+template<typename T, std::size_t alignment = 64>
+struct AlignedAllocator
+{
+    static_assert(alignment >= alignof(T), "alignment must be at least that of T");
+    static_assert((alignment & (alignment - 1)) == 0, "alignment must be a power of 2");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, alignment> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length{};
+
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t{alignment});
+    }
+
+    template<typename U>
+    bool operator==(AlignedAllocator<U, alignment> const&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(AlignedAllocator<U, alignment> const&) const noexcept
+    {
+        return false;
+    }
+};
+
+
+template<typename T, std::size_t alignment = 64>
+using aligned_vector = std::vector<T, AlignedAllocator<T, alignment>>;
+
+
+} // namespace PHARE::core
+
+#endif // PHARE_CORE_UTILITIES_ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,142 @@
+#ifndef PHARE_CORE_UTILITIES_ASYNC_WORKER_HPP
+#define PHARE_CORE_UTILITIES_ASYNC_WORKER_HPP
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <iostream>
+#include <mutex>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "core/logger.hpp"
+#include "core/utilities/mpi_utils.hpp"
+
+
+namespace PHARE::core
+{
+/** \brief AsyncWorker runs tasks one at a time on a dedicated thread.
+ *
+ * At most one task is in flight: submitting a task while the previous one is not done
+ * blocks until it is (backpressure), so that the memory held by tasks is bounded by two
+ * tasks, the one being executed and the one being prepared by the submitting thread.
+ * An exception thrown by a task is rethrown by the next call to wait() or submit().
+ * The destructor waits for the task in flight, if any.
+ */
+class AsyncWorker
+{
+public:
+    using Task = std::function<void()>;
+
+    AsyncWorker()
+        : thread_{[this]() { run_(); }}
+    {
+    }
+
+    ~AsyncWorker()
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            done_.wait(lock, [this]() { return !task_; });
+            stop_ = true;
+        }
+        ready_.notify_one();
+        thread_.join();
+    }
+
+
+    void submit(Task&& task)
+    {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_ = std::move(task);
+        }
+        ready_.notify_one();
+    }
+
+
+    // blocks until the task in flight, if any, is done
+    void wait()
+    {
+        PHARE_LOG_SCOPE("AsyncWorker::wait");
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_.wait(lock, [this]() { return !task_; });
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+
+    bool busy() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return static_cast<bool>(task_);
+    }
+
+
+    AsyncWorker(AsyncWorker const&) = delete;
+    AsyncWorker(AsyncWorker&&)      = delete;
+    AsyncWorker& operator=(AsyncWorker const&) = delete;
+    AsyncWorker& operator=(AsyncWorker&&) = delete;
+
+private:
+    void run_()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true)
+        {
+            ready_.wait(lock, [this]() { return stop_ or task_; });
+            if (!task_) // stopping
+                return;
+
+            lock.unlock();
+            std::exception_ptr error;
+            try
+            {
+                task_();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            task_  = nullptr;
+            error_ = error;
+            done_.notify_all();
+        }
+    }
+
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_, done_;
+    Task task_;
+    std::exception_ptr error_;
+    bool stop_ = false;
+    std::thread thread_; // last, started once the other members are constructed
+};
+
+
+
+/** the worker of the asynchronous writer "what", or null if it must be synchronous because its
+ * tasks call MPI and MPI does not provide MPI_THREAD_MULTIPLE, see SamraiLifeCycle
+ */
+inline std::unique_ptr<AsyncWorker> makeAsyncWorker(std::string const& what,
+                                                    bool const mpiFromThread = true)
+{
+    if (!mpiFromThread or mpi::thread_multiple())
+        return std::make_unique<AsyncWorker>();
+
+    if (mpi::rank() == 0)
+        std::cout << "WARNING: MPI_THREAD_MULTIPLE not provided, " << what << " are synchronous"
+                  << std::endl;
+    return nullptr;
+}
+
+
+} // namespace PHARE::core
+
+#endif // PHARE_CORE_UTILITIES_ASYNC_WORKER_HPP
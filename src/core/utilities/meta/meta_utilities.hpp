@@ -1,6 +1,7 @@
 #ifndef PHARE_CORE_UTILITIES_META_META_UTILITIES_HPP
 #define PHARE_CORE_UTILITIES_META_META_UTILITIES_HPP
 
+#include <tuple>
 #include <iterator>
 #include <type_traits>
 
@@ -69,18 +70,88 @@ namespace core
     using SimulatorOption = std::tuple<DimConstant, InterpConstant,
                                        std::integral_constant<std::size_t, ValidNbrParticles>...>;
 
+    // whether the simulators of this dimension and interpolation order are built, all of them
+    // unless PHARE_SIMULATORS holds the bit (dim - 1) * 3 + interp - 1 of each one to build
+    // (see -Dsimulators in res/cmake/options.cmake)
+    constexpr bool isSimulatorBuilt([[maybe_unused]] std::size_t dim,
+                                    [[maybe_unused]] std::size_t interp)
+    {
+#if defined(PHARE_SIMULATORS)
+        return (PHARE_SIMULATORS >> ((dim - 1) * 3 + interp - 1)) & 1;
+#else
+        return true;
+#endif
+    }
+
+    template<typename... SimulatorOptions>
+    constexpr decltype(auto) builtSimulators(std::tuple<SimulatorOptions...> const&)
+    {
+        return std::tuple_cat(
+            std::conditional_t<isSimulatorBuilt(std::tuple_element_t<0, SimulatorOptions>{}(),
+                                                std::tuple_element_t<1, SimulatorOptions>{}()),
+                               std::tuple<SimulatorOptions>, std::tuple<>>{}...);
+    }
+
+    // inner tuple = dim, interp, list[possible nbrParticles for dim/interp]
+    // keep PHARE_SIMULATOR_INSTANCES below in sync, a static_assert checks they match
+    using AllSimulators = std::tuple<SimulatorOption<DimConst<1>, InterpConst<1>, 2, 3>,
+                                     SimulatorOption<DimConst<1>, InterpConst<2>, 2, 3, 4>,
+                                     SimulatorOption<DimConst<1>, InterpConst<3>, 2, 3, 4, 5>,
+
+                                     SimulatorOption<DimConst<2>, InterpConst<1>, 4, 5, 8, 9>,
+                                     SimulatorOption<DimConst<2>, InterpConst<2>, 4, 5, 8, 9, 16>,
+                                     SimulatorOption<DimConst<2>, InterpConst<3>, 4, 5, 8, 9, 25>,
+
+                                     SimulatorOption<DimConst<3>, InterpConst<1>, 8, 27>,
+                                     SimulatorOption<DimConst<3>, InterpConst<2>, 8, 27>,
+                                     SimulatorOption<DimConst<3>, InterpConst<3>, 8, 27>>;
+
     constexpr decltype(auto) possibleSimulators()
     {
-        // inner tuple = dim, interp, list[possible nbrParticles for dim/interp]
-        return std::tuple<SimulatorOption<DimConst<1>, InterpConst<1>, 2, 3>,
-                          SimulatorOption<DimConst<1>, InterpConst<2>, 2, 3, 4>,
-                          SimulatorOption<DimConst<1>, InterpConst<3>, 2, 3, 4, 5>,
-
-                          SimulatorOption<DimConst<2>, InterpConst<1>, 4, 5, 8, 9>,
-                          SimulatorOption<DimConst<2>, InterpConst<2>, 4, 5, 8, 9, 16>,
-                          SimulatorOption<DimConst<2>, InterpConst<3>, 4, 5, 8, 9, 25>>{};
+        return builtSimulators(AllSimulators{});
     }
 
+// X(dim, interp, nbRefinedPart) for each simulator of a dimension and interpolation order of
+// possibleSimulators, for the explicit instantiations of src/simulator/simulator_instance.cpp.in
+#define PHARE_SIMULATOR_INSTANCES_1_1(X) X(1, 1, 2) X(1, 1, 3)
+#define PHARE_SIMULATOR_INSTANCES_1_2(X) X(1, 2, 2) X(1, 2, 3) X(1, 2, 4)
+#define PHARE_SIMULATOR_INSTANCES_1_3(X) X(1, 3, 2) X(1, 3, 3) X(1, 3, 4) X(1, 3, 5)
+#define PHARE_SIMULATOR_INSTANCES_2_1(X) X(2, 1, 4) X(2, 1, 5) X(2, 1, 8) X(2, 1, 9)
+#define PHARE_SIMULATOR_INSTANCES_2_2(X) X(2, 2, 4) X(2, 2, 5) X(2, 2, 8) X(2, 2, 9) X(2, 2, 16)
+#define PHARE_SIMULATOR_INSTANCES_2_3(X) X(2, 3, 4) X(2, 3, 5) X(2, 3, 8) X(2, 3, 9) X(2, 3, 25)
+#define PHARE_SIMULATOR_INSTANCES_3_1(X) X(3, 1, 8) X(3, 1, 27)
+#define PHARE_SIMULATOR_INSTANCES_3_2(X) X(3, 2, 8) X(3, 2, 27)
+#define PHARE_SIMULATOR_INSTANCES_3_3(X) X(3, 3, 8) X(3, 3, 27)
+
+#define PHARE_SIMULATOR_INSTANCES(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_1_1(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_1_2(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_1_3(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_2_1(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_2_2(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_2_3(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_3_1(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_3_2(X)                                                               \
+    PHARE_SIMULATOR_INSTANCES_3_3(X)
+
+// the SimulatorOption each PHARE_SIMULATOR_INSTANCES_<dim>_<interp> declares
+#define PHARE_SIMULATOR_NBR_PART_(dim, interp, nbRefinedPart) , nbRefinedPart
+#define PHARE_SIMULATOR_OPTION_(dim, interp)                                                       \
+    SimulatorOption<DimConst<dim>, InterpConst<interp> PHARE_SIMULATOR_INSTANCES_##dim##_##interp( \
+        PHARE_SIMULATOR_NBR_PART_)>
+
+    static_assert(
+        std::is_same_v<AllSimulators,
+                       std::tuple<PHARE_SIMULATOR_OPTION_(1, 1), PHARE_SIMULATOR_OPTION_(1, 2),
+                                  PHARE_SIMULATOR_OPTION_(1, 3), PHARE_SIMULATOR_OPTION_(2, 1),
+                                  PHARE_SIMULATOR_OPTION_(2, 2), PHARE_SIMULATOR_OPTION_(2, 3),
+                                  PHARE_SIMULATOR_OPTION_(3, 1), PHARE_SIMULATOR_OPTION_(3, 2),
+                                  PHARE_SIMULATOR_OPTION_(3, 3)>>,
+        "PHARE_SIMULATOR_INSTANCES_* must match AllSimulators");
+
+#undef PHARE_SIMULATOR_OPTION_
+#undef PHARE_SIMULATOR_NBR_PART_
+
 
     template<typename Maker> // used from PHARE::amr::Hierarchy
     auto makeAtRuntime(std::size_t dim, Maker&& maker)
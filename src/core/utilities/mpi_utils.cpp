@@ -41,6 +41,14 @@ void barrier()
 }
 
 
+bool thread_multiple()
+{
+    int provided;
+    MPI_Query_thread(&provided);
+    return provided == MPI_THREAD_MULTIPLE;
+}
+
+
 
 std::string date_time(std::string format)
 {
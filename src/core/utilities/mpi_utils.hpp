@@ -34,6 +34,9 @@ int rank();
 
 void barrier();
 
+// true if MPI functions can be called concurrently from several threads
+bool thread_multiple();
+
 std::string date_time(std::string format = "%Y-%m-%d-%H:%M:%S");
 
 template<typename Data>
@@ -181,6 +184,38 @@ std::vector<Data> collect(Data const& data, int mpi_size)
         return values;
     }
 }
+
+
+// concatenation, in rank order, of the vectors of all processes with a single MPI_Gatherv,
+// the result is only valid on root, or on all processes if root < 0 (MPI_Allgatherv)
+template<typename Data>
+SpanSet<Data, int> gather(std::vector<Data> const& local, int root = 0)
+{
+    int const mpi_size  = size();
+    auto sizes          = collect(static_cast<int>(local.size()), mpi_size);
+    bool const receives = root < 0 or rank() == root;
+    SpanSet<Data, int> gathered{receives ? std::move(sizes) : std::vector<int>(mpi_size, 0)};
+
+    if (root < 0)
+        _collect_vector<Data>(local, gathered, gathered.sizes, gathered.displs, mpi_size);
+    else
+        MPI_Gatherv(local.data(), static_cast<int>(local.size()), mpi_type_for<Data>(),
+                    gathered.data(), gathered.sizes.data(), gathered.displs.data(),
+                    mpi_type_for<Data>(), root, MPI_COMM_WORLD);
+    return gathered;
+}
+
+
+// element-wise sum of the vectors of all processes, which must have the same size,
+// the result is only valid on rank 0
+template<typename Data>
+std::vector<Data> sum_on_root(std::vector<Data> const& local)
+{
+    std::vector<Data> global(local.size());
+    MPI_Reduce(local.data(), global.data(), static_cast<int>(local.size()), mpi_type_for<Data>(),
+               MPI_SUM, 0, MPI_COMM_WORLD);
+    return global;
+}
 } // namespace PHARE::core::mpi
 
 
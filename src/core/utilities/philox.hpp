@@ -0,0 +1,148 @@
+#ifndef PHARE_CORE_UTILITIES_PHILOX_HPP
+#define PHARE_CORE_UTILITIES_PHILOX_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace PHARE::core
+{
+/** \brief Philox4x32-10 counter based random number generator (Salmon et al., SC11).
+ *
+ * The four 32 bits words returned for a counter are a pure function of the key and of the
+ * counter, so that any random number can be drawn independently of the others, in any order
+ * and from any thread, given its counter.
+ */
+class Philox
+{
+public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key     = std::array<std::uint32_t, 2>;
+
+    static Counter generate(Counter counter, Key key)
+    {
+        for (std::size_t round = 0; round < 10; ++round)
+        {
+            if (round > 0)
+            {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            auto const p0 = std::uint64_t{0xD2511F53} * counter[0];
+            auto const p1 = std::uint64_t{0xCD9E8D57} * counter[2];
+            counter       = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                       static_cast<std::uint32_t>(p1),
+                       static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                       static_cast<std::uint32_t>(p0)};
+        }
+        return counter;
+    }
+
+
+    // in [0, 1), of the 53 bits of two words
+    static double uniform(std::uint32_t const high, std::uint32_t const low)
+    {
+        return static_cast<double>((std::uint64_t{high} << 21) | (low >> 11)) * 0x1p-53;
+    }
+
+
+    /* Box-Muller without rejection over arrays, each pair of uniform numbers in [0, 1) of u0
+     * and u1 giving two independent normals, in cosines and sines. The loop stays scalar: GCC
+     * only has vector log, cos and sin (glibc's libmvec) with -ffast-math, which is not used.
+     */
+    static void boxMuller(double const* u0, double const* u1, double* cosines, double* sines,
+                          std::size_t const size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto const radius = std::sqrt(-2. * std::log(1. - u0[i]));
+            auto const angle  = 2. * M_PI * u1[i];
+            cosines[i]        = radius * std::cos(angle);
+            sines[i]          = radius * std::sin(angle);
+        }
+    }
+
+    /* size normals from the size uniform numbers of u, by Box-Muller over the pairs of the
+     * first and second halves of u, so that no normal is drawn for nothing. For an odd size,
+     * the last normal is the cosine one of u[size - 1] and uLast.
+     */
+    static void boxMuller(double const* u, double const uLast, double* normals,
+                          std::size_t const size)
+    {
+        auto const half = size / 2;
+        boxMuller(u, u + half, normals, normals + half, half);
+        if (size % 2 == 1)
+            normals[size - 1] = std::sqrt(-2. * std::log(1. - u[size - 1]))
+                                * std::cos(2. * M_PI * uLast);
+    }
+
+
+    // splitmix64, to derive keys from several integers
+    static std::uint64_t mix(std::uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+        return value ^ (value >> 31);
+    }
+};
+
+
+
+/** \brief CounterStream draws a sequence of random numbers from the counters following a base
+ * counter, whose last word is incremented for each block of four words.
+ * Doubles have 53 random bits, taken from two words.
+ */
+class CounterStream
+{
+public:
+    CounterStream(Philox::Key const& key, Philox::Counter const& counter)
+        : key_{key}
+        , counter_{counter}
+    {
+    }
+
+    // in [0, 1)
+    double uniform()
+    {
+        if (next_ == 4)
+        {
+            block_ = Philox::generate(counter_, key_);
+            ++counter_[3];
+            next_ = 0;
+        }
+        next_ += 2;
+        return Philox::uniform(block_[next_ - 2], block_[next_ - 1]);
+    }
+
+    // of mean 0 and standard deviation 1, Box-Muller without rejection
+    double normal()
+    {
+        if (hasNormal_)
+        {
+            hasNormal_ = false;
+            return normal_;
+        }
+        auto const u0 = uniform();
+        auto const u1 = uniform();
+        double normal;
+        Philox::boxMuller(&u0, &u1, &normal, &normal_, 1);
+        hasNormal_ = true;
+        return normal;
+    }
+
+private:
+    Philox::Key key_;
+    Philox::Counter counter_;
+    Philox::Counter block_;
+    std::size_t next_ = 4;
+    double normal_    = 0;
+    bool hasNormal_   = false;
+};
+
+
+} // namespace PHARE::core
+
+#endif // PHARE_CORE_UTILITIES_PHILOX_HPP
@@ -0,0 +1,127 @@
+#ifndef PHARE_DIAGNOSTIC_DETAIL_FIELD_COARSENING_HPP
+#define PHARE_DIAGNOSTIC_DETAIL_FIELD_COARSENING_HPP
+
+#include "core/data/grid/gridlayoutdefs.hpp"
+#include "core/utilities/types.hpp"
+#include "amr/data/field/coarsening/coarsen_weighter.hpp"
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+namespace PHARE::diagnostic
+{
+/*
+ * Physical nodes of a field, without ghosts, coarsened by an integer ratio for output.
+ *
+ * Coarse nodes are aligned on the first physical node of the patch. Each coarse node is a
+ * weighted sum of the fine nodes around it, with the weights of the AMR field coarsening
+ * (amr::CoarsenWeighter): ratio + 1 nodes centered on it for primal quantities and an even
+ * ratio, ratio nodes otherwise. Where the stencil goes beyond the field, e.g. for a ratio
+ * larger than the ghost width or a number of cells not multiple of the ratio, the closest
+ * node of the field is used.
+ * A ratio of 1 gives the physical nodes as they are.
+ */
+template<typename GridLayout>
+class FieldCoarsening
+{
+    static constexpr auto dimension = GridLayout::dimension;
+    using Stencil = std::vector<std::pair<std::uint32_t, double>>; // (local index, weight)
+
+public:
+    template<typename Field>
+    FieldCoarsening(Field const& field, std::size_t ratio)
+    {
+        auto const centering = GridLayout::centering(field.physicalQuantity());
+        auto const ghosts    = GridLayout::nbrGhosts();
+        auto const shape     = field.shape();
+
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            bool const primal = centering[iDim] == core::QtyCentering::primal;
+            auto const last   = shape[iDim] - 1;
+            auto const nCells = shape[iDim] - 2 * ghosts - (primal ? 1 : 0);
+            auto const nbrCoarseCells = (nCells + ratio - 1) / ratio;
+            shape_[iDim]              = nbrCoarseCells + (primal ? 1 : 0);
+
+            std::vector<double> weights{1.};
+            int shift = 0;
+            if (ratio > 1)
+            {
+                auto const nbrPoints = primal and ratio % 2 == 0 ? ratio + 1 : ratio;
+                weights              = amr::CoarsenWeighter{nbrPoints}.weights();
+                shift                = primal ? -static_cast<int>(ratio / 2) : 0;
+            }
+
+            for (std::size_t iCoarse = 0; iCoarse < shape_[iDim]; ++iCoarse)
+            {
+                auto& stencil   = stencils_[iDim].emplace_back();
+                int const first = static_cast<int>(ghosts + iCoarse * ratio) + shift;
+                for (std::size_t iPoint = 0; iPoint < weights.size(); ++iPoint)
+                {
+                    auto const index = first + static_cast<int>(iPoint);
+                    stencil.emplace_back(std::clamp<int>(index, 0, last), weights[iPoint]);
+                }
+            }
+        }
+    }
+
+
+    auto shape() const { return std::vector<std::size_t>(shape_.begin(), shape_.end()); }
+
+
+    // coarsened values, in the row major order of the field
+    template<typename Field>
+    std::vector<double> operator()(Field const& field) const
+    {
+        std::vector<double> values;
+        values.reserve(core::product(shape_));
+
+        auto const& sx = stencils_[0];
+        if constexpr (dimension == 1)
+        {
+            for (auto const& x : sx)
+                values.push_back(sum_(x, [&](auto i) { return field(i); }));
+        }
+        else if constexpr (dimension == 2)
+        {
+            for (auto const& x : sx)
+                for (auto const& y : stencils_[1])
+                    values.push_back(sum_(x, [&](auto i) {
+                        return sum_(y, [&](auto j) { return field(i, j); });
+                    }));
+        }
+        else
+        {
+            for (auto const& x : sx)
+                for (auto const& y : stencils_[1])
+                    for (auto const& z : stencils_[2])
+                        values.push_back(sum_(x, [&](auto i) {
+                            return sum_(y, [&](auto j) {
+                                return sum_(z, [&](auto k) { return field(i, j, k); });
+                            });
+                        }));
+        }
+        return values;
+    }
+
+private:
+    template<typename Value>
+    static double sum_(Stencil const& stencil, Value&& value)
+    {
+        double sum = 0;
+        for (auto const& [index, weight] : stencil)
+            sum += weight * value(index);
+        return sum;
+    }
+
+    std::array<std::size_t, dimension> shape_;
+    std::array<std::vector<Stencil>, dimension> stencils_;
+};
+
+
+} // namespace PHARE::diagnostic
+
+#endif /* PHARE_DIAGNOSTIC_DETAIL_FIELD_COARSENING_HPP */
@@ -21,6 +21,7 @@ class H5TypeWriter : public PHARE::diagnostic::TypeWriter
 {
 public:
     using Attributes                = typename Writer::Attributes;
+    using Field                     = typename Writer::Field;
     static constexpr auto dimension = Writer::dimension;
 
     H5TypeWriter(Writer& h5Writer)
@@ -50,8 +51,25 @@ public:
 
 
 
+    //------ field diagnostics, used by the level aggregated layout -----------
+    // names of the datasets written per patch by the diagnostic, empty if not made of fields
+    virtual std::vector<std::string> fieldNames(DiagnosticProperties const&) { return {}; }
+
+    // fields of the current patch, in the order of fieldNames()
+    virtual std::vector<Field const*> fields(DiagnosticProperties&) { return {}; }
+    //------------------------------------------------------------------------
+
+
+
     //------ valid for all h5type writers -------------------------------------
-    void finalize(DiagnosticProperties& diagnostic)
+    HighFiveFile& file(DiagnosticProperties const& diagnostic)
+    {
+        return *fileData_.at(diagnostic.quantity);
+    }
+
+    // returns the file of the diagnostic if it is to be closed, which happens when it is
+    // destroyed, so that it can outlive pending writes
+    std::unique_ptr<HighFiveFile> finalize(DiagnosticProperties& diagnostic)
     {
         // we close the file by removing the associated file
         // from the map. This is done only at flush time otherwise
@@ -63,9 +81,12 @@ public:
 
         if (flushEvery != Writer::flush_never and diagnostic.dumpIdx % flushEvery == 0)
         {
+            auto file = std::move(fileData_.at(diagnostic.quantity));
             fileData_.erase(diagnostic.quantity);
             assert(fileData_.count(diagnostic.quantity) == 0);
+            return file;
         }
+        return nullptr;
     }
     //------------------------------------------------------------------------
 
@@ -75,17 +96,11 @@ protected:
     void initDataSets_(std::unordered_map<std::size_t, std::vector<std::string>> const& patchIDs,
                        Attributes& patchAttributes, std::size_t maxLevel, InitPatch&& initPatch)
     {
+        // creations are batched and exchanged by the Writer, processes having less patches than
+        // others on a level have nothing to create for them
         for (std::size_t lvl = h5Writer_.minLevel; lvl <= maxLevel; lvl++)
-        {
-            auto& lvlPatches       = patchIDs.at(lvl);
-            std::size_t patchNbr   = lvlPatches.size();
-            std::size_t maxPatches = core::mpi::max(patchNbr);
-            for (std::size_t i = 0; i < patchNbr; ++i)
-                initPatch(lvl, patchAttributes[std::to_string(lvl) + "_" + lvlPatches[i]],
-                          lvlPatches[i]);
-            for (std::size_t i = patchNbr; i < maxPatches; i++)
-                initPatch(lvl, patchAttributes);
-        }
+            for (auto const& patchID : patchIDs.at(lvl))
+                initPatch(lvl, patchAttributes[std::to_string(lvl) + "_" + patchID], patchID);
     }
 
     void writeAttributes_(
@@ -95,21 +110,15 @@ protected:
         std::size_t maxLevel)
     {
         for (std::size_t lvl = h5Writer_.minLevel; lvl <= maxLevel; lvl++)
-        {
-            auto& lvlPatches       = patchAttributes.at(lvl);
-            std::size_t patchNbr   = lvlPatches.size();
-            std::size_t maxPatches = core::mpi::max(patchNbr);
-            for (auto const& [patch, attr] : lvlPatches)
+            for (auto const& [patch, attr] : patchAttributes.at(lvl))
                 h5Writer_.writeAttributeDict(file, attr,
                                              h5Writer_.getPatchPathAddTimestamp(lvl, patch));
-            for (std::size_t i = patchNbr; i < maxPatches; i++)
-                h5Writer_.writeAttributeDict(file, h5Writer_.modelView().getEmptyPatchProperties(),
-                                             "");
-        }
 
         if (diagnostic.nAttributes > 0)
             h5Writer_.writeAttributeDict(file, diagnostic.fileAttributes, "/py_attrs");
         h5Writer_.writeAttributeDict(file, fileAttributes, "/");
+        if (auto const coarsening = h5Writer_.fieldCoarsening(diagnostic); coarsening > 0)
+            file.write_attributes_per_mpi("/", "coarsen_ratio", coarsening);
     }
 
     template<typename ParticlePopulation>
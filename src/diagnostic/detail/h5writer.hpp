@@ -5,11 +5,18 @@
 
 #include "core/data/vecfield/vecfield_component.hpp"
 #include "core/utilities/mpi_utils.hpp"
+#include "core/utilities/async_worker.hpp"
 #include "core/utilities/types.hpp"
 #include "core/utilities/meta/meta_utilities.hpp"
 
 #include "hdf5/detail/h5/h5_file.hpp"
 
+#include "diagnostic/detail/field_coarsening.hpp"
+
+#include <map>
+#include <iostream>
+#include <functional>
+
 #include "diagnostic/detail/h5typewriter.hpp"
 #include "diagnostic/diagnostic_manager.hpp"
 #include "diagnostic/diagnostic_props.hpp"
@@ -32,6 +39,8 @@ template<typename H5Writer>
 class ParticlesDiagnosticWriter;
 template<typename H5Writer>
 class MetaDiagnosticWriter;
+template<typename H5Writer>
+class ReducedDiagnosticWriter;
 
 
 
@@ -46,6 +55,7 @@ public:
     using This       = Writer<ModelView>;
     using GridLayout = typename ModelView::GridLayout;
     using Attributes = typename ModelView::PatchProperties;
+    using Field      = typename ModelView::Field;
 
     static constexpr auto dimension   = GridLayout::dimension;
     static constexpr auto interpOrder = GridLayout::interp_order;
@@ -54,16 +64,40 @@ public:
     // flush_never: disables manual file closing, but still occurrs via RAII
     static constexpr std::size_t flush_never = 0;
 
+    // default format has one dataset per quantity per patch
+    // the aggregated one has one dataset per quantity per level for field quantities
+    static constexpr auto per_patch_format  = "phareh5";
+    static constexpr auto aggregated_format = "phareh5_aggregated";
+
     template<typename Hierarchy, typename Model>
     Writer(Hierarchy& hier, Model& model, std::string const hifivePath,
-           unsigned _flags /* = HiFile::ReadWrite | HiFile::Create | HiFile::Truncate */)
+           unsigned _flags /* = HiFile::ReadWrite | HiFile::Create | HiFile::Truncate */,
+           std::string const format = per_patch_format, bool const async = false)
         : flags{_flags}
+        , aggregated{format == aggregated_format}
         , filePath_{hifivePath}
         , modelView_{hier, model}
     {
+        if (format != per_patch_format and format != aggregated_format)
+            throw std::runtime_error("Unknown diagnostics format " + format);
+
+        // HDF5 calls MPI, the I/O thread can only do it while the solver does if allowed
+        if (async)
+            worker_ = core::makeAsyncWorker("diagnostics");
     }
 
-    ~Writer() {}
+    // the simulator drains before destruction, errors of writes still in flight are only logged
+    ~Writer()
+    {
+        try
+        {
+            drain();
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "diagnostics writer: " << e.what() << std::endl;
+        }
+    }
 
     template<typename Hierarchy, typename Model>
     static auto make_unique(Hierarchy& hier, Model& model, initializer::PHAREDict const& dict)
@@ -72,7 +106,11 @@ public:
         unsigned flags       = READ_WRITE;
         if (dict.contains("mode") and dict["mode"].template to<std::string>() == "overwrite")
             flags |= HiFile::Truncate;
-        return std::make_unique<This>(hier, model, filePath, flags);
+        std::string format = per_patch_format;
+        if (dict.contains("format"))
+            format = dict["format"].template to<std::string>();
+        bool const async = dict.contains("async") and dict["async"].template to<int>() > 0;
+        return std::make_unique<This>(hier, model, filePath, flags, format, async);
     }
 
 
@@ -80,6 +118,15 @@ public:
     void dump_level(std::size_t level, std::vector<DiagnosticProperties*> const& diagnostics,
                     double timestamp);
 
+    // waits for the writes of the previous dump, if asynchronous
+    void drain()
+    {
+        if (worker_)
+            worker_->wait();
+    }
+
+    bool async() const { return worker_ != nullptr; }
+
     template<typename String>
     auto getDiagnosticWriterForType(String& type)
     {
@@ -101,14 +148,47 @@ public:
 
     auto makeFile(DiagnosticProperties const& diagnostic)
     {
-        return makeFile(fileString(diagnostic.quantity),
-                        file_flags[diagnostic.type + diagnostic.quantity]);
+        auto file = makeFile(fileString(diagnostic.quantity),
+                             file_flags[diagnostic.type + diagnostic.quantity]);
+        file->set_filters(filtersFor(diagnostic), levelAggregated(diagnostic));
+        return file;
     }
 
+    // field diagnostics of the aggregated format are written per level, collectively
+    bool levelAggregated(DiagnosticProperties const& diagnostic) const
+    {
+        return aggregated and diagnostic.type != "reduced"
+               and writers.at(diagnostic.type)->fieldNames(diagnostic).size() > 0;
+    }
+
+    // dataset storage options of the diagnostic, see DataSetFilters
+    static DataSetFilters filtersFor(DiagnosticProperties const& diagnostic)
+    {
+        auto const& params = diagnostic.params;
+        DataSetFilters filters;
+        if (params.contains("chunk_size"))
+            filters.chunkSize = diagnostic.param<std::size_t>("chunk_size");
+        if (params.contains("deflate"))
+            filters.deflate = diagnostic.param<std::size_t>("deflate");
+        if (params.contains("shuffle"))
+            filters.shuffle = diagnostic.param<std::size_t>("shuffle") > 0;
+        if (params.contains("lossy"))
+        {
+            filters.lossy          = diagnostic.param<std::string>("lossy");
+            filters.lossyTolerance = diagnostic.param<double>("lossy_tolerance");
+        }
+        return filters;
+    }
+
+
+    static std::string getFullLevelPath(std::string timestamp, int iLevel)
+    {
+        return "/t/" + timestamp + "/pl" + std::to_string(iLevel);
+    }
 
     static std::string getFullPatchPath(std::string timestamp, int iLevel, std::string globalCoords)
     {
-        return "/t/" + timestamp + "/pl" + std::to_string(iLevel) + "/p" + globalCoords;
+        return getFullLevelPath(timestamp, iLevel) + "/p" + globalCoords;
     }
 
     template<typename Type, typename Size>
@@ -140,34 +220,76 @@ public:
 
 
 
+    /* 0 if the fields of the diagnostic are written as they are, with their ghosts, otherwise
+     * the ratio by which their physical nodes are coarsened, see FieldCoarsening.
+     * "write_ghosts" = 0 alone writes the physical nodes, i.e. a ratio of 1
+     */
+    static std::size_t fieldCoarsening(DiagnosticProperties const& diagnostic)
+    {
+        auto const& params = diagnostic.params;
+        if (params.contains("coarsen_ratio") and diagnostic.param<std::size_t>("coarsen_ratio") > 1)
+            return diagnostic.param<std::size_t>("coarsen_ratio");
+        if (params.contains("write_ghosts") and diagnostic.param<std::size_t>("write_ghosts") == 0)
+            return 1;
+        return 0;
+    }
+
+    template<typename Field>
+    static std::vector<std::size_t> fieldShape(Field const& field, std::size_t coarsening)
+    {
+        if (coarsening > 0)
+            return FieldCoarsening<GridLayout>{field, coarsening}.shape();
+        // highfive doesn't accept uint32 which ndarray.shape() is
+        auto const& shape = field.shape();
+        return std::vector<std::size_t>(shape.data(), shape.data() + shape.size());
+    }
+
+
+    // padded fields are written without their padding
+    template<typename Field>
+    static void writeFieldAsDataset(HighFiveFile& h5, std::string path, Field const& field,
+                                    std::size_t coarsening = 0)
+    {
+        if (coarsening > 0)
+            h5.write_data_set_flat<dimension>(
+                path, FieldCoarsening<GridLayout>{field, coarsening}(field).data());
+        else
+            h5.write_data_set_flat<dimension>(path, core::contiguous(field).data());
+    }
+
     template<typename VecField>
-    static void writeVecFieldAsDataset(HighFiveFile& h5, std::string path, VecField& vecField)
+    static void writeVecFieldAsDataset(HighFiveFile& h5, std::string path, VecField& vecField,
+                                       std::size_t coarsening = 0)
     {
         for (auto& [id, type] : core::Components::componentMap)
-            h5.write_data_set_flat<dimension>(path + "_" + id,
-                                              &(*vecField.getComponent(type).begin()));
+            writeFieldAsDataset(h5, path + "_" + id, vecField.getComponent(type), coarsening);
     }
 
     auto& modelView() { return modelView_; }
 
     std::size_t minLevel = 0, maxLevel = 10; // TODO hard-coded to be parametrized somehow
     unsigned flags;
+    bool const aggregated;
 
 
 private:
     double timestamp_ = 0;
     std::string filePath_;
     std::string patchPath_; // is passed around as "virtual write()" has no parameters
+    std::size_t patchLevel_ = 0;
     ModelView modelView_;
     Attributes fileAttributes_;
 
     std::unordered_map<std::string, unsigned> file_flags;
 
+    std::unique_ptr<core::AsyncWorker> worker_; // null if dumps are synchronous
+
     std::unordered_map<std::string, std::shared_ptr<H5TypeWriter<This>>> writers{
         {"info", make_writer<MetaDiagnosticWriter<This>>()},
         {"fluid", make_writer<FluidDiagnosticWriter<This>>()},
         {"electromag", make_writer<ElectromagDiagnosticWriter<This>>()},
-        {"particle", make_writer<ParticlesDiagnosticWriter<This>>()} //
+        {"particle", make_writer<ParticlesDiagnosticWriter<This>>()},
+        {"reduced", make_writer<ReducedDiagnosticWriter<This>>()} //
     };
 
     template<typename Writer>
@@ -179,6 +301,8 @@ private:
 
     void initializeDatasets_(std::vector<DiagnosticProperties*> const& diagnotics);
     void writeDatasets_(std::vector<DiagnosticProperties*> const& diagnotics);
+    void writeLevelAggregated_(std::vector<DiagnosticProperties*> const& diagnotics);
+    void writeReduced_(std::vector<DiagnosticProperties*> const& diagnotics);
 
     Writer(Writer const&)            = delete;
     Writer(Writer&&)                 = delete;
@@ -192,6 +316,7 @@ private:
     friend class ElectromagDiagnosticWriter<This>;
     friend class ParticlesDiagnosticWriter<This>;
     friend class MetaDiagnosticWriter<This>;
+    friend class ReducedDiagnosticWriter<This>;
     friend class H5TypeWriter<This>;
 
     // used by friends start
@@ -201,8 +326,15 @@ private:
                                 iLevel, globalCoords);
     }
 
+    std::string getLevelPathAddTimestamp(int iLevel)
+    {
+        return getFullLevelPath(core::to_string_with_precision(timestamp_, timestamp_precision),
+                                iLevel);
+    }
+
 
     auto& patchPath() const { return patchPath_; }
+    auto patchLevel() const { return patchLevel_; }
     // used by friends end
 };
 
@@ -212,6 +344,9 @@ template<typename ModelView>
 void Writer<ModelView>::dump(std::vector<DiagnosticProperties*> const& diagnostics,
                              double timestamp)
 {
+    // HDF5 is not used concurrently, the previous writes must be done (backpressure)
+    drain();
+
     timestamp_                     = timestamp;
     fileAttributes_["dimension"]   = dimension;
     fileAttributes_["interpOrder"] = interpOrder;
@@ -224,15 +359,69 @@ void Writer<ModelView>::dump(std::vector<DiagnosticProperties*> const& diagnosti
         if (!file_flags.count(diagnostic->type + diagnostic->quantity))
             file_flags[diagnostic->type + diagnostic->quantity] = this->flags;
 
-    initializeDatasets_(diagnostics);
-    writeDatasets_(diagnostics);
+    // non field diagnostics (particles, tags) are always written per patch
+    // reduced diagnostics are written once per dump, independently of the patches
+    std::vector<DiagnosticProperties*> perPatch, perLevel, reduced;
+    for (auto* diagnostic : diagnostics)
+    {
+        if (diagnostic->type == "reduced")
+            reduced.push_back(diagnostic);
+        else if (levelAggregated(*diagnostic))
+            perLevel.push_back(diagnostic);
+        else
+            perPatch.push_back(diagnostic);
+    }
+
+    // asynchronous dumps copy the data to write, which is written by the worker thread
+    std::vector<HighFiveFile*> files;
+    if (worker_)
+        for (auto* diagnostic : diagnostics)
+        {
+            auto& writer = *writers.at(diagnostic->type);
+            writer.createFiles(*diagnostic);
+            auto* file = &writer.file(*diagnostic);
+            if (std::find(files.begin(), files.end(), file) == files.end())
+            {
+                file->open_write_stage();
+                files.push_back(file);
+            }
+        }
+
+    if (perPatch.size() > 0)
+    {
+        initializeDatasets_(perPatch);
+        writeDatasets_(perPatch);
+    }
+    if (perLevel.size() > 0)
+        writeLevelAggregated_(perLevel);
+    if (reduced.size() > 0)
+        writeReduced_(reduced);
 
+    std::vector<std::unique_ptr<HighFiveFile>> closing;
     for (auto* diagnostic : diagnostics)
     {
-        writers.at(diagnostic->type)->finalize(*diagnostic);
+        if (auto file = writers.at(diagnostic->type)->finalize(*diagnostic))
+            closing.emplace_back(std::move(file));
         // don't truncate past first dump
         file_flags[diagnostic->type + diagnostic->quantity] = READ_WRITE;
     }
+
+    if (worker_)
+    {
+        std::vector<std::function<void()>> writes;
+        for (auto* file : files)
+            for (auto& write : file->close_write_stage())
+                writes.emplace_back(std::move(write));
+
+        // files to close are closed once written, std::function must be copyable
+        auto toClose = std::make_shared<decltype(closing)>(std::move(closing));
+        worker_->submit([writes = std::move(writes), toClose]() {
+            PHARE_LOG_SCOPE("Writer::asyncWrites");
+            for (auto const& write : writes)
+                write();
+            toClose->clear();
+        });
+    }
 }
 
 template<typename ModelView>
@@ -255,21 +444,40 @@ void Writer<ModelView>::dump_level(std::size_t level,
 
 
 
+/*
+ * Datasets and attributes of all diagnostics are not created as they are visited but
+ * recorded in metadata batches, which are exchanged between MPI processes once per dump.
+ */
 template<typename ModelView>
 void Writer<ModelView>::initializeDatasets_(std::vector<DiagnosticProperties*> const& diagnostics)
 {
     std::size_t maxLocalLevel = 0;
     std::unordered_map<std::size_t, std::vector<std::string>> lvlPatchIDs;
     Attributes patchAttributes; // stores dataset info/size for synced MPI creation
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>
+        patchProperties;
 
+    std::vector<HighFiveFile*> files;
     for (auto* diag : diagnostics)
-        writers.at(diag->type)->createFiles(*diag);
+    {
+        auto& writer = *writers.at(diag->type);
+        writer.createFiles(*diag);
+        auto* file = &writer.file(*diag);
+        if (std::find(files.begin(), files.end(), file) == files.end())
+        {
+            file->open_metadata_batch();
+            files.push_back(file);
+        }
+    }
 
-    auto collectPatchAttributes = [&](GridLayout&, std::string patchID, std::size_t iLevel) {
+    auto collectPatchAttributes = [&](GridLayout& gridLayout, std::string patchID,
+                                      std::size_t iLevel) {
         if (!lvlPatchIDs.count(iLevel))
             lvlPatchIDs.emplace(iLevel, std::vector<std::string>());
 
         lvlPatchIDs.at(iLevel).emplace_back(patchID);
+        patchProperties[iLevel].emplace_back(patchID,
+                                             modelView_.getPatchProperties(patchID, gridLayout));
 
         for (auto* diag : diagnostics)
         {
@@ -283,14 +491,21 @@ void Writer<ModelView>::initializeDatasets_(std::vector<DiagnosticProperties*> c
     // sets empty vectors in case current process lacks patch on a level
     std::size_t maxMPILevel = core::mpi::max(maxLocalLevel);
     for (std::size_t lvl = minLevel; lvl <= maxMPILevel; lvl++)
+    {
         if (!lvlPatchIDs.count(lvl))
             lvlPatchIDs.emplace(lvl, std::vector<std::string>());
+        if (!patchProperties.count(lvl))
+            patchProperties.emplace(lvl, std::vector<std::pair<std::string, Attributes>>{});
+    }
 
     for (auto* diagnostic : diagnostics)
     {
-        writers.at(diagnostic->type)
-            ->initDataSets(*diagnostic, lvlPatchIDs, patchAttributes, maxMPILevel);
+        auto& writer = *writers.at(diagnostic->type);
+        writer.initDataSets(*diagnostic, lvlPatchIDs, patchAttributes, maxMPILevel);
+        writer.writeAttributes(*diagnostic, fileAttributes_, patchProperties, maxMPILevel);
     }
+
+    exchange_metadata(files);
 }
 
 
@@ -298,32 +513,290 @@ void Writer<ModelView>::initializeDatasets_(std::vector<DiagnosticProperties*> c
 template<typename ModelView>
 void Writer<ModelView>::writeDatasets_(std::vector<DiagnosticProperties*> const& diagnostics)
 {
-    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>
-        patchAttributes;
-
-    std::size_t maxLocalLevel = 0;
-    auto writePatch = [&](GridLayout& gridLayout, std::string patchID, std::size_t iLevel) {
-        if (!patchAttributes.count(iLevel))
-            patchAttributes.emplace(iLevel, std::vector<std::pair<std::string, Attributes>>{});
-        patchPath_ = getPatchPathAddTimestamp(iLevel, patchID);
-        patchAttributes[iLevel].emplace_back(patchID,
-                                             modelView_.getPatchProperties(patchID, gridLayout));
+    auto writePatch = [&](GridLayout&, std::string patchID, std::size_t iLevel) {
+        patchPath_  = getPatchPathAddTimestamp(iLevel, patchID);
+        patchLevel_ = iLevel;
         for (auto* diagnostic : diagnostics)
             writers.at(diagnostic->type)->write(*diagnostic);
-        maxLocalLevel = iLevel;
     };
 
     modelView_.visitHierarchy(writePatch, minLevel, maxLevel);
+}
+
+
+
+/*
+ * Level aggregated layout, for field diagnostics
+ *
+ * /t#/pl#/<name>                   : fields of all patches of the level, flattened and
+ *                                    concatenated by MPI rank then patch
+ * /t#/pl#/patches/(lower, upper)   : AMR box of each patch, (nbrPatches, dim)
+ * /t#/pl#/patches/origin           : origin of each patch, (nbrPatches, dim)
+ * /t#/pl#/patches/<name>_offset    : offset of each patch in the <name> dataset
+ * /t#/pl#/patches/<name>_shape     : shape of the field of each patch, (nbrPatches, dim)
+ *
+ * where <name> is the name of the per patch dataset (e.g. EM_B_x, density, flux_x).
+ * Fields of diagnostics with a coarsen_ratio, or without ghosts, hold the physical nodes of
+ * each patch coarsened as in the per patch format, see FieldCoarsening, and have no ghosts.
+ * Patches of a rank being contiguous, each rank writes a single hyperslab per dataset.
+ * Hyperslabs are written collectively, ranks without patches on a level write empty ones.
+ */
+template<typename ModelView>
+void Writer<ModelView>::writeLevelAggregated_(std::vector<DiagnosticProperties*> const& diagnostics)
+{
+    using Sizes = std::vector<std::size_t>;
+
+    struct Level
+    {
+        std::size_t nbrPatches = 0;
+        std::vector<int> lower, upper;
+        std::vector<double> origin;
+        // per diagnostic, per field
+        std::vector<std::vector<std::vector<double>>> data;
+        std::vector<std::vector<Sizes>> offsets, shapes;
+    };
+
+    std::vector<HighFiveFile*> files;
+    std::vector<std::vector<std::string>> names;
+    std::vector<std::vector<Sizes>> ghosts;
+    for (auto* diagnostic : diagnostics)
+    {
+        auto& writer = *writers.at(diagnostic->type);
+        writer.createFiles(*diagnostic);
+        files.push_back(&writer.file(*diagnostic));
+        names.push_back(writer.fieldNames(*diagnostic));
+        ghosts.emplace_back(names.back().size());
+    }
+
+    std::map<std::size_t, Level> levels;
+    auto levelAt = [&](std::size_t iLevel) -> Level& {
+        auto& level = levels[iLevel];
+        if (level.data.empty())
+            for (auto const& diagNames : names)
+            {
+                level.data.emplace_back(diagNames.size());
+                level.offsets.emplace_back(diagNames.size());
+                level.shapes.emplace_back(diagNames.size());
+            }
+        return level;
+    };
+
+    std::size_t maxLocalLevel = 0;
+    auto collectPatch = [&](GridLayout& gridLayout, std::string, std::size_t iLevel) {
+        auto& level = levelAt(iLevel);
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            level.lower.push_back(gridLayout.AMRBox().lower[iDim]);
+            level.upper.push_back(gridLayout.AMRBox().upper[iDim]);
+            level.origin.push_back(gridLayout.origin()[iDim]);
+        }
+
+        for (std::size_t iDiag = 0; iDiag < diagnostics.size(); ++iDiag)
+        {
+            auto const coarsening = fieldCoarsening(*diagnostics[iDiag]);
+            auto fields = writers.at(diagnostics[iDiag]->type)->fields(*diagnostics[iDiag]);
+            for (std::size_t iField = 0; iField < fields.size(); ++iField)
+            {
+                auto const& field = *fields[iField];
+                auto& data        = level.data[iDiag][iField];
+                auto& shape       = level.shapes[iDiag][iField];
+
+                level.offsets[iDiag][iField].push_back(data.size());
+                if (coarsening > 0)
+                {
+                    FieldCoarsening<GridLayout> const coarsen{field, coarsening};
+                    auto const values = coarsen(field);
+                    data.insert(data.end(), values.begin(), values.end());
+                    for (auto const n : coarsen.shape())
+                        shape.push_back(n);
+                    ghosts[iDiag][iField] = Sizes(dimension, 0);
+                    continue;
+                }
+
+                auto const contiguous = core::contiguous(field);
+                data.insert(data.end(), contiguous.begin(), contiguous.end());
+                for (auto const n : field.shape())
+                    shape.push_back(n);
+
+                auto const nbrGhosts = GridLayout::nDNbrGhosts(field.physicalQuantity());
+                ghosts[iDiag][iField] = Sizes(nbrGhosts.begin(), nbrGhosts.end());
+            }
+        }
+        ++level.nbrPatches;
+        maxLocalLevel = iLevel;
+    };
+
+    modelView_.visitHierarchy(collectPatch, minLevel, maxLevel);
 
     std::size_t maxMPILevel = core::mpi::max(maxLocalLevel);
-    // sets empty vectors in case current process lacks patch on a level
-    for (std::size_t lvl = minLevel; lvl <= maxMPILevel; lvl++)
-        if (!patchAttributes.count(lvl))
-            patchAttributes.emplace(lvl, std::vector<std::pair<std::string, Attributes>>{});
 
+    // visits the number of patches of each level then the size of each field, in the same
+    // order on all ranks, entry being the index of the visited value
+    auto forEachSize = [&](auto&& onPatches, auto&& onField) {
+        std::size_t entry = 0;
+        for (std::size_t lvl = minLevel; lvl <= maxMPILevel; ++lvl)
+        {
+            auto& level = levelAt(lvl);
+            onPatches(lvl, level, entry++);
+            for (std::size_t iDiag = 0; iDiag < diagnostics.size(); ++iDiag)
+                for (std::size_t iField = 0; iField < names[iDiag].size(); ++iField)
+                    onField(lvl, level, iDiag, iField, entry++);
+        }
+    };
+
+    Sizes localSizes;
+    forEachSize([&](auto, auto& level, auto) { localSizes.push_back(level.nbrPatches); },
+                [&](auto, auto& level, auto iDiag, auto iField, auto) {
+                    localSizes.push_back(level.data[iDiag][iField].size());
+                });
+
+    // one exchange gives the position of this rank in all datasets
+    auto const perRank = core::mpi::collect(localSizes);
+    auto const rank    = static_cast<std::size_t>(core::mpi::rank());
+    Sizes start(localSizes.size(), 0), total(localSizes.size(), 0);
+    for (std::size_t iRank = 0; iRank < perRank.size(); ++iRank)
+        for (std::size_t entry = 0; entry < localSizes.size(); ++entry)
+        {
+            if (iRank < rank)
+                start[entry] += perRank[iRank][entry];
+            total[entry] += perRank[iRank][entry];
+        }
+
+    for (auto* file : files)
+        file->open_metadata_batch();
+
+    bool const creator     = rank == 0;
+    std::size_t patchEntry = 0;
+    forEachSize(
+        [&](auto lvl, auto&, auto entry) {
+            patchEntry = entry;
+            if (!creator)
+                return;
+            auto const path = getLevelPathAddTimestamp(lvl) + "/patches/";
+            Sizes const shape{total[entry], dimension};
+            for (auto* file : files)
+            {
+                file->template create_data_set_per_mpi<int>(path + "lower", shape);
+                file->template create_data_set_per_mpi<int>(path + "upper", shape);
+                file->template create_data_set_per_mpi<double>(path + "origin", shape);
+            }
+        },
+        [&](auto lvl, auto&, auto iDiag, auto iField, auto entry) {
+            auto& file            = *files[iDiag];
+            auto const path       = getLevelPathAddTimestamp(lvl) + "/";
+            auto const& name      = names[iDiag][iField];
+            auto const nbrPatches = total[patchEntry];
+            if (creator)
+            {
+                createDataSet<double>(file, path + name, Sizes{total[entry]});
+                file.template create_data_set_per_mpi<std::size_t>(
+                    path + "patches/" + name + "_offset", Sizes{nbrPatches});
+                file.template create_data_set_per_mpi<std::size_t>(
+                    path + "patches/" + name + "_shape", Sizes{nbrPatches, dimension});
+            }
+            // only ranks with patches know the ghosts, duplicates are ignored
+            if (total[entry] > 0 and ghosts[iDiag][iField].size() > 0)
+                file.write_attributes_per_mpi(path + name, "ghosts", ghosts[iDiag][iField]);
+        });
+
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>> noPatches;
+    for (std::size_t lvl = minLevel; lvl <= maxMPILevel; lvl++)
+        noPatches[lvl] = {};
     for (auto* diagnostic : diagnostics)
         writers.at(diagnostic->type)
-            ->writeAttributes(*diagnostic, fileAttributes_, patchAttributes, maxMPILevel);
+            ->writeAttributes(*diagnostic, fileAttributes_, noPatches, maxMPILevel);
+    for (auto* file : files)
+        file->write_attributes_per_mpi("/", "format", std::string{aggregated_format});
+
+    exchange_metadata(files);
+
+    // all ranks take part in the writes of the datasets that exist, which are those of
+    // non-zero total size
+    for (auto* file : files)
+        file->set_collective_writes(true);
+
+    forEachSize(
+        [&](auto lvl, auto& level, auto entry) {
+            patchEntry = entry;
+            if (total[entry] == 0)
+                return;
+            auto const path = getLevelPathAddTimestamp(lvl) + "/patches/";
+            Sizes const offset{start[entry], 0}, count{level.nbrPatches, dimension};
+            for (auto* file : files)
+            {
+                file->template write_data_set_flat_selection<2>(path + "lower", offset, count,
+                                                                level.lower.data());
+                file->template write_data_set_flat_selection<2>(path + "upper", offset, count,
+                                                                level.upper.data());
+                file->template write_data_set_flat_selection<2>(path + "origin", offset, count,
+                                                                level.origin.data());
+            }
+        },
+        [&](auto lvl, auto& level, auto iDiag, auto iField, auto entry) {
+            if (total[patchEntry] == 0)
+                return;
+            auto& file       = *files[iDiag];
+            auto const path  = getLevelPathAddTimestamp(lvl) + "/";
+            auto const& name = names[iDiag][iField];
+            auto const& data = level.data[iDiag][iField];
+            auto const first = start[patchEntry];
+            auto const nbr   = level.nbrPatches;
+
+            Sizes offsets = level.offsets[iDiag][iField];
+            for (auto& offset : offsets)
+                offset += start[entry];
+
+            if (total[entry] > 0)
+                file.write_data_set_flat_selection(path + name, {start[entry]}, {data.size()},
+                                                   data.data());
+            file.write_data_set_flat_selection(path + "patches/" + name + "_offset", {first},
+                                               {nbr}, offsets.data());
+            file.template write_data_set_flat_selection<2>(
+                path + "patches/" + name + "_shape", {first, 0}, {nbr, dimension},
+                level.shapes[iDiag][iField].data());
+        });
+
+    for (auto* file : files)
+        file->set_collective_writes(false);
+}
+
+
+
+/*
+ * Reduced diagnostics have a single dataset per dump, written by rank 0, and no patch
+ * attributes, their metadata is exchanged like that of the other layouts
+ */
+template<typename ModelView>
+void Writer<ModelView>::writeReduced_(std::vector<DiagnosticProperties*> const& diagnostics)
+{
+    std::vector<HighFiveFile*> files;
+    for (auto* diagnostic : diagnostics)
+    {
+        auto& writer = *writers.at(diagnostic->type);
+        writer.createFiles(*diagnostic);
+        auto* file = &writer.file(*diagnostic);
+        if (std::find(files.begin(), files.end(), file) == files.end())
+        {
+            file->open_metadata_batch();
+            files.push_back(file);
+        }
+    }
+
+    Attributes noDataSetInfo;
+    std::unordered_map<std::size_t, std::vector<std::string>> noPatchIDs{{minLevel, {}}};
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>> noPatches{
+        {minLevel, {}}};
+    for (auto* diagnostic : diagnostics)
+    {
+        auto& writer = *writers.at(diagnostic->type);
+        writer.initDataSets(*diagnostic, noPatchIDs, noDataSetInfo, minLevel);
+        writer.writeAttributes(*diagnostic, fileAttributes_, noPatches, minLevel);
+    }
+
+    exchange_metadata(files);
+
+    for (auto* diagnostic : diagnostics)
+        writers.at(diagnostic->type)->write(*diagnostic);
 }
 
 
@@ -0,0 +1,187 @@
+#ifndef PHARE_DIAGNOSTIC_DETAIL_REDUCTIONS_HPP
+#define PHARE_DIAGNOSTIC_DETAIL_REDUCTIONS_HPP
+
+#include "core/data/grid/gridlayoutdefs.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+
+namespace PHARE::diagnostic
+{
+/*
+ * Values of a reduced diagnostic of one level, see ReducedDiagnosticWriter, accumulated patch
+ * by patch in sums and counts, then averaged over the computes, for histograms, or over the
+ * cells, for box averages and line cuts.
+ *
+ * Histogram bins are flattened in row major order of the axes. Line cuts have one value per
+ * cell of the level along cutAxis, indexed by the AMR index of the cell.
+ */
+template<std::size_t dimension>
+struct Reduction
+{
+    using Box = std::pair<std::vector<double>, std::vector<double>>; // physical lower, upper
+
+    std::string kind, population, field;
+    std::size_t level = 0, cutAxis = 0;
+    std::vector<std::string> axes;
+    std::vector<std::size_t> bins;
+    std::vector<double> lower, upper;
+    std::optional<Box> box;
+    std::vector<double> position;
+
+    // accumulated since the last write, reduced on rank 0 at write time
+    std::vector<double> sums, counts;
+    std::size_t nbrComputes = 0;
+    std::vector<double> values;
+
+
+    template<typename Position>
+    bool inBox(Position const& point) const
+    {
+        if (!box)
+            return true;
+        auto const& [boxLower, boxUpper] = *box;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            if (point[iDim] < boxLower[iDim] or point[iDim] >= boxUpper[iDim])
+                return false;
+        return true;
+    }
+
+
+    // adds the weight of the particles within box to the bin of their values along the axes
+    template<typename GridLayout, typename Particles>
+    void histogram(GridLayout const& layout, Particles const& particles, double const mass)
+    {
+        auto const& dx     = layout.meshSize();
+        auto const origin  = layout.origin();
+        auto const& AMRBox = layout.AMRBox();
+
+        for (auto const& particle : particles)
+        {
+            std::array<double, dimension> point;
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                auto const cell = particle.iCell[iDim] - AMRBox.lower[iDim];
+                point[iDim]     = origin[iDim] + (cell + particle.delta[iDim]) * dx[iDim];
+            }
+            if (!inBox(point))
+                continue;
+
+            std::size_t bin = 0;
+            bool inRange    = true;
+            for (std::size_t iAxis = 0; iAxis < axes.size(); ++iAxis)
+            {
+                auto const& axis = axes[iAxis];
+                double value     = 0;
+                if (axis == "energy")
+                    for (auto const v : particle.v)
+                        value += 0.5 * mass * v * v;
+                else if (axis[0] == 'v')
+                    value = particle.v[axis[1] - 'x'];
+                else
+                    value = point[axis[0] - 'x'];
+
+                auto const& axisLower = lower[iAxis];
+                auto const& axisUpper = upper[iAxis];
+                auto const nbrBins    = bins[iAxis];
+                inRange               = value >= axisLower and value < axisUpper;
+                if (!inRange)
+                    break;
+                auto const fraction = (value - axisLower) / (axisUpper - axisLower);
+                auto const iBin     = static_cast<std::size_t>(fraction * nbrBins);
+                bin                 = bin * nbrBins + std::min(iBin, nbrBins - 1);
+            }
+
+            if (inRange)
+                sums[bin] += particle.weight;
+        }
+    }
+
+
+    // adds the value of the field at the cells within box, or crossed by the line of line cuts
+    // primal quantities are sampled at the first node of the cell
+    template<typename GridLayout, typename Field>
+    void fieldCells(GridLayout const& layout, Field const& fieldData)
+    {
+        auto const& dx     = layout.meshSize();
+        auto const origin  = layout.origin();
+        auto const& AMRBox = layout.AMRBox();
+
+        std::array<std::uint32_t, dimension> start;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            start[iDim] = layout.physicalStartIndex(fieldData, static_cast<core::Direction>(iDim));
+
+        for (auto const& cell : AMRBox)
+        {
+            std::array<double, dimension> center;
+            std::array<std::uint32_t, dimension> local;
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                center[iDim] = origin[iDim] + (cell[iDim] - AMRBox.lower[iDim] + .5) * dx[iDim];
+                local[iDim]  = start[iDim] + cell[iDim] - AMRBox.lower[iDim];
+            }
+
+            std::size_t index = 0;
+            if (kind == "line_cut")
+            {
+                bool onLine = true;
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    if (iDim != cutAxis)
+                        onLine = onLine
+                                 and std::abs(center[iDim] - position[iDim]) <= .5 * dx[iDim];
+                if (!onLine)
+                    continue;
+                index = static_cast<std::size_t>(cell[cutAxis]);
+            }
+            else if (!inBox(center))
+                continue;
+
+            double value = 0;
+            if constexpr (dimension == 1)
+                value = fieldData(local[0]);
+            else if constexpr (dimension == 2)
+                value = fieldData(local[0], local[1]);
+            else
+                value = fieldData(local[0], local[1], local[2]);
+
+            sums[index] += value;
+            counts[index] += 1;
+        }
+    }
+
+
+    // values from the sums and counts of all processes, NaN for cells no patch covered
+    void average(std::vector<double> const& allSums, std::vector<double> const& allCounts)
+    {
+        values.resize(allSums.size());
+        for (std::size_t i = 0; i < allSums.size(); ++i)
+        {
+            if (kind == "histogram")
+                values[i] = allSums[i] / nbrComputes;
+            else
+                values[i] = allCounts[i] > 0 ? allSums[i] / allCounts[i]
+                                             : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+
+    void reset()
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        std::fill(counts.begin(), counts.end(), 0);
+        nbrComputes = 0;
+    }
+};
+
+
+} // namespace PHARE::diagnostic
+
+#endif /* PHARE_DIAGNOSTIC_DETAIL_REDUCTIONS_HPP */
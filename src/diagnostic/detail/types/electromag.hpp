@@ -26,6 +26,7 @@ public:
     using Attributes = typename Super::Attributes;
     using GridLayout = typename H5Writer::GridLayout;
     using FloatType  = typename H5Writer::FloatType;
+    using Field      = typename Super::Field;
 
     ElectromagDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
@@ -47,6 +48,10 @@ public:
         DiagnosticProperties&, Attributes&,
         std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
         std::size_t maxLevel) override;
+
+    std::vector<std::string> fieldNames(DiagnosticProperties const& diagnostic) override;
+
+    std::vector<Field const*> fields(DiagnosticProperties& diagnostic) override;
 };
 
 
@@ -68,14 +73,16 @@ void ElectromagDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties&
     auto vecFields         = h5Writer.modelView().getElectromagFields();
     std::string lvlPatchID = std::to_string(iLevel) + "_" + patchID;
 
+    auto const coarsening = h5Writer.fieldCoarsening(diagnostic);
+
     auto infoVF = [&](auto& vecF, std::string name, auto& attr) {
         for (auto& [id, type] : core::Components::componentMap)
         {
-            // highfive doesn't accept uint32 which ndarray.shape() is
-            auto const& array_shape = vecF.getComponent(type).shape();
-            attr[name][id]          = std::vector<std::size_t>(array_shape.data(),
-                                                      array_shape.data() + array_shape.size());
-            auto ghosts = GridLayout::nDNbrGhosts(vecF.getComponent(type).physicalQuantity());
+            auto const& field = vecF.getComponent(type);
+            attr[name][id]    = h5Writer.fieldShape(field, coarsening);
+            auto ghosts       = GridLayout::nDNbrGhosts(field.physicalQuantity());
+            if (coarsening > 0)
+                ghosts = core::ConstArray<std::uint32_t, GridLayout::dimension>(0);
             attr[name][id + "_ghosts_x"] = static_cast<std::size_t>(ghosts[0]);
             if constexpr (GridLayout::dimension > 1)
                 attr[name][id + "_ghosts_y"] = static_cast<std::size_t>(ghosts[1]);
@@ -153,7 +160,7 @@ void ElectromagDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnosti
         if (diagnostic.quantity == "/" + vecField->name())
             h5Writer.writeVecFieldAsDataset(*fileData_.at(diagnostic.quantity),
                                             h5Writer.patchPath() + "/" + vecField->name(),
-                                            *vecField);
+                                            *vecField, h5Writer.fieldCoarsening(diagnostic));
 }
 
 
@@ -170,6 +177,33 @@ void ElectromagDiagnosticWriter<H5Writer>::writeAttributes(
 }
 
 
+
+template<typename H5Writer>
+std::vector<std::string>
+ElectromagDiagnosticWriter<H5Writer>::fieldNames(DiagnosticProperties const& diagnostic)
+{
+    std::vector<std::string> names;
+    for (auto* vecField : this->h5Writer_.modelView().getElectromagFields())
+        if (diagnostic.quantity == "/" + vecField->name())
+            for (auto& [id, type] : core::Components::componentMap)
+                names.emplace_back(vecField->name() + "_" + id);
+    return names;
+}
+
+
+template<typename H5Writer>
+auto ElectromagDiagnosticWriter<H5Writer>::fields(DiagnosticProperties& diagnostic)
+    -> std::vector<Field const*>
+{
+    std::vector<Field const*> fields;
+    for (auto* vecField : this->h5Writer_.modelView().getElectromagFields())
+        if (diagnostic.quantity == "/" + vecField->name())
+            for (auto& [id, type] : core::Components::componentMap)
+                fields.emplace_back(&vecField->getComponent(type));
+    return fields;
+}
+
+
 } // namespace PHARE::diagnostic::h5
 
 #endif /* PHARE_DIAGNOSTIC_DETAIL_TYPES_ELECTROMAG_H */
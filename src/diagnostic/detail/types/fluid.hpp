@@ -32,6 +32,7 @@ public:
     using Attributes = typename Super::Attributes;
     using GridLayout = typename H5Writer::GridLayout;
     using FloatType  = typename H5Writer::FloatType;
+    using Field      = typename Super::Field;
 
     FluidDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
@@ -53,6 +54,17 @@ public:
         DiagnosticProperties&, Attributes&,
         std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
         std::size_t maxLevel) override;
+
+    std::vector<std::string> fieldNames(DiagnosticProperties const& diagnostic) override;
+
+    std::vector<Field const*> fields(DiagnosticProperties& diagnostic) override;
+
+private:
+    // calls onField(name) or onVecField(name) for the quantity of the diagnostic,
+    // with the population of the quantity, if any
+    template<typename OnField, typename OnVecField>
+    void visitQuantity_(DiagnosticProperties const& diagnostic, OnField&& onField,
+                        OnVecField&& onVecField);
 };
 
 
@@ -81,8 +93,12 @@ void FluidDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties& diagn
 
     auto checkActive = [&](auto& tree, auto var) { return diagnostic.quantity == tree + var; };
 
-    auto setGhostNbr = [](auto const& field, auto& attr, auto const& name) {
-        auto ghosts              = GridLayout::nDNbrGhosts(field.physicalQuantity());
+    auto const coarsening = h5Writer.fieldCoarsening(diagnostic);
+
+    auto setGhostNbr = [&](auto const& field, auto& attr, auto const& name) {
+        auto ghosts = GridLayout::nDNbrGhosts(field.physicalQuantity());
+        if (coarsening > 0)
+            ghosts = core::ConstArray<std::uint32_t, GridLayout::dimension>(0);
         attr[name + "_ghosts_x"] = static_cast<std::size_t>(ghosts[0]);
         if constexpr (GridLayout::dimension > 1)
             attr[name + "_ghosts_y"] = static_cast<std::size_t>(ghosts[1]);
@@ -91,9 +107,7 @@ void FluidDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties& diagn
     };
 
     auto infoDS = [&](auto& field, std::string name, auto& attr) {
-        // highfive doesn't accept uint32 which ndarray.shape() is
-        auto const& shape = field.shape();
-        attr[name]        = std::vector<std::size_t>(shape.data(), shape.data() + shape.size());
+        attr[name] = h5Writer.fieldShape(field, coarsening);
         setGhostNbr(field, attr, name);
     };
 
@@ -190,11 +204,13 @@ void FluidDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnostic)
     auto& h5file   = *fileData_.at(diagnostic.quantity);
 
     auto checkActive = [&](auto& tree, auto var) { return diagnostic.quantity == tree + var; };
-    auto writeDS     = [&](auto path, auto& field) {
-        h5file.template write_data_set_flat<GridLayout::dimension>(path, &(*field.begin()));
+    auto const coarsening = h5Writer.fieldCoarsening(diagnostic);
+    auto writeDS          = [&](auto path, auto& field) {
+        h5Writer.writeFieldAsDataset(h5file, path, field, coarsening);
+    };
+    auto writeVF = [&](auto path, auto& vecF) {
+        h5Writer.writeVecFieldAsDataset(h5file, path, vecF, coarsening);
     };
-    auto writeVF
-        = [&](auto path, auto& vecF) { h5Writer.writeVecFieldAsDataset(h5file, path, vecF); };
 
     std::string path = h5Writer.patchPath() + "/";
     for (auto& pop : ions)
@@ -240,6 +256,62 @@ void FluidDiagnosticWriter<H5Writer>::writeAttributes(
     writeAttributes_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
 }
 
+
+template<typename H5Writer>
+template<typename OnField, typename OnVecField>
+void FluidDiagnosticWriter<H5Writer>::visitQuantity_(DiagnosticProperties const& diagnostic,
+                                                     OnField&& onField, OnVecField&& onVecField)
+{
+    auto& ions = this->h5Writer_.modelView().getIons();
+
+    auto checkActive = [&](auto& tree, auto var) { return diagnostic.quantity == tree + var; };
+
+    for (auto& pop : ions)
+    {
+        std::string tree{"/ions/pop/" + pop.name() + "/"};
+        if (checkActive(tree, "density"))
+            onField("density", [&]() -> auto& { return pop.density(); });
+        if (checkActive(tree, "flux"))
+            onVecField("flux", [&]() -> auto& { return pop.flux(); });
+    }
+
+    std::string tree{"/ions/"};
+    if (checkActive(tree, "density"))
+        onField("density", [&]() -> auto& { return ions.density(); });
+    if (checkActive(tree, "bulkVelocity"))
+        onVecField("bulkVelocity", [&]() -> auto& { return ions.velocity(); });
+}
+
+
+template<typename H5Writer>
+std::vector<std::string>
+FluidDiagnosticWriter<H5Writer>::fieldNames(DiagnosticProperties const& diagnostic)
+{
+    std::vector<std::string> names;
+    visitQuantity_(
+        diagnostic, [&](std::string const& name, auto&&) { names.emplace_back(name); },
+        [&](std::string const& name, auto&&) {
+            for (auto const& [id, type] : core::Components::componentMap)
+                names.emplace_back(name + "_" + id);
+        });
+    return names;
+}
+
+
+template<typename H5Writer>
+auto FluidDiagnosticWriter<H5Writer>::fields(DiagnosticProperties& diagnostic)
+    -> std::vector<Field const*>
+{
+    std::vector<Field const*> fields;
+    visitQuantity_(
+        diagnostic, [&](std::string const&, auto&& field) { fields.emplace_back(&field()); },
+        [&](std::string const&, auto&& vecField) {
+            for (auto const& [id, type] : core::Components::componentMap)
+                fields.emplace_back(&vecField().getComponent(type));
+        });
+    return fields;
+}
+
 } // namespace PHARE::diagnostic::h5
 
 #endif /* PHARE_DIAGNOSTIC_DETAIL_TYPES_FLUID_H */
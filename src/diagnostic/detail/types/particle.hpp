@@ -4,6 +4,7 @@
 #include "diagnostic/detail/h5typewriter.hpp"
 
 #include "core/data/particles/particle_packer.hpp"
+#include "core/data/particles/particle_selector.hpp"
 
 #include "amr/data/particles/particles_data.hpp"
 
@@ -20,9 +21,16 @@ namespace PHARE::diagnostic::h5
  *
  * Possible outputs
  *
- * /t#/pl#/p#/ions/pop_(1,2,...)/domain/(weight, charge, iCell, delta, v)
- * /t#/pl#/p#/ions/pop_(1,2,...)/levelGhost/(weight, charge, iCell, delta, v)
- * /t#/pl#/p#/ions/pop_(1,2,...)/patchGhost/(weight, charge, iCell, delta, v)
+ * /t#/pl#/p#/ions/pop_(1,2,...)/domain/(weight, charge, iCell, delta, v, id)
+ * /t#/pl#/p#/ions/pop_(1,2,...)/levelGhost/(weight, charge, iCell, delta, v, id)
+ * /t#/pl#/p#/ions/pop_(1,2,...)/patchGhost/(weight, charge, iCell, delta, v, id)
+ *
+ * Only a selection of the particles is written if the diagnostic has the parameters
+ *   stride     : every stride-th particle of each patch
+ *   fraction   : the particles of hash below fraction, see core::ParticleSelector
+ *   min_energy : the particles of kinetic energy above min_energy
+ *   nbr_boxes  : the particles within the physical boxes
+ *                (box_#_lower_#, box_#_upper_#), # being the box then the dimension
  */
 template<typename H5Writer>
 class ParticlesDiagnosticWriter : public H5TypeWriter<H5Writer>
@@ -41,6 +49,7 @@ public:
     using Attributes                  = typename Super::Attributes;
     using Packer                      = core::ParticlePacker<dimension>;
     using FloatType                   = typename H5Writer::FloatType;
+    using Selector                    = core::ParticleSelector<dimension>;
 
     ParticlesDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
@@ -62,9 +71,57 @@ public:
         DiagnosticProperties&, Attributes&,
         std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
         std::size_t maxLevel) override;
+
+private:
+    template<typename Population>
+    Selector selector_(DiagnosticProperties const& diagnostic, Population const& pop,
+                       std::size_t iLevel);
 };
 
 
+template<typename H5Writer>
+template<typename Population>
+auto ParticlesDiagnosticWriter<H5Writer>::selector_(DiagnosticProperties const& diagnostic,
+                                                    Population const& pop, std::size_t iLevel)
+    -> Selector
+{
+    auto const& params = diagnostic.params;
+
+    Selector selector;
+    selector.mass = pop.mass();
+    if (params.contains("stride"))
+        selector.stride = diagnostic.param<std::size_t>("stride");
+    if (params.contains("fraction"))
+        selector.fraction = diagnostic.param<double>("fraction");
+    if (params.contains("min_energy"))
+        selector.minEnergy = diagnostic.param<double>("min_energy");
+
+    if (params.contains("nbr_boxes"))
+    {
+        // physical boxes to level index units, the refinement ratio is 2
+        auto const& modelView = h5Writer_.modelView();
+        auto const origin     = modelView.origin();
+        auto const cellWidth  = modelView.cellWidth();
+        auto toIndex          = [&](std::string const& key, std::size_t iDim) {
+            auto const dx = cellWidth[iDim] / (1 << iLevel);
+            return (diagnostic.param<double>(key) - origin[iDim]) / dx;
+        };
+
+        for (std::size_t iBox = 0; iBox < diagnostic.param<std::size_t>("nbr_boxes"); ++iBox)
+        {
+            auto const prefix = "box_" + std::to_string(iBox);
+            auto& box         = selector.boxes.emplace_back();
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                box.lower[iDim] = toIndex(prefix + "_lower_" + std::to_string(iDim), iDim);
+                box.upper[iDim] = toIndex(prefix + "_upper_" + std::to_string(iDim), iDim);
+            }
+        }
+    }
+    return selector;
+}
+
+
 template<typename H5Writer>
 void ParticlesDiagnosticWriter<H5Writer>::createFiles(DiagnosticProperties& diagnostic)
 {
@@ -81,14 +138,15 @@ void ParticlesDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties& d
                                                          std::string const& patchID,
                                                          Attributes& patchAttributes)
 {
-    auto checkInfo = [&](auto& tree, auto pType, auto& attr, auto& ps) {
+    auto checkInfo = [&](auto& tree, auto pType, auto& attr, auto& ps, auto const& pop) {
         std::string active{tree + pType};
         if (diagnostic.quantity == active)
         {
-            std::size_t part_idx = 0;
+            auto const nbrParticles = selector_(diagnostic, pop, iLevel).count(ps);
+            std::size_t part_idx    = 0;
             core::apply(Packer::empty(), [&](auto const& arg) {
                 attr[pType][Packer::keys()[part_idx++]]
-                    = hdf5::ParticleWriter::size_for<dimension>(arg, ps.size());
+                    = hdf5::ParticleWriter::size_for<dimension>(arg, nbrParticles);
             });
         }
     };
@@ -100,9 +158,9 @@ void ParticlesDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties& d
     {
         std::string tree{"/ions/pop/" + pop.name() + "/"};
         auto& popAttr = patchAttributes[lvlPatchID][pop.name()];
-        checkInfo(tree, "domain", popAttr, pop.domainParticles());
-        checkInfo(tree, "levelGhost", popAttr, pop.levelGhostParticles());
-        checkInfo(tree, "patchGhost", popAttr, pop.patchGhostParticles());
+        checkInfo(tree, "domain", popAttr, pop.domainParticles(), pop);
+        checkInfo(tree, "levelGhost", popAttr, pop.levelGhostParticles(), pop);
+        checkInfo(tree, "patchGhost", popAttr, pop.patchGhostParticles(), pop);
     }
 }
 
@@ -168,19 +226,26 @@ void ParticlesDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnostic
 {
     auto& h5Writer = this->h5Writer_;
 
-    auto checkWrite = [&](auto& tree, auto pType, auto& ps) {
+    auto checkWrite = [&](auto& tree, auto pType, auto& ps, auto const& pop) {
         std::string active{tree + pType};
-        if (diagnostic.quantity == active && ps.size() > 0)
-            hdf5::ParticleWriter::write(*fileData_.at(diagnostic.quantity), ps,
-                                        h5Writer.patchPath() + "/");
+        if (diagnostic.quantity != active || ps.size() == 0)
+            return;
+
+        auto& h5file    = *fileData_.at(diagnostic.quantity);
+        auto const path = h5Writer.patchPath() + "/";
+        auto selector   = selector_(diagnostic, pop, h5Writer.patchLevel());
+        if (selector.all())
+            hdf5::ParticleWriter::write(h5file, ps, path);
+        else
+            hdf5::ParticleWriter::write(h5file, ps, path, selector);
     };
 
     for (auto& pop : h5Writer.modelView().getIons())
     {
         std::string tree{"/ions/pop/" + pop.name() + "/"};
-        checkWrite(tree, "domain", pop.domainParticles());
-        checkWrite(tree, "levelGhost", pop.levelGhostParticles());
-        checkWrite(tree, "patchGhost", pop.patchGhostParticles());
+        checkWrite(tree, "domain", pop.domainParticles(), pop);
+        checkWrite(tree, "levelGhost", pop.levelGhostParticles(), pop);
+        checkWrite(tree, "patchGhost", pop.patchGhostParticles(), pop);
     }
 }
 
@@ -0,0 +1,320 @@
+#ifndef PHARE_DIAGNOSTIC_DETAIL_TYPES_REDUCED_HPP
+#define PHARE_DIAGNOSTIC_DETAIL_TYPES_REDUCED_HPP
+
+#include "diagnostic/detail/h5typewriter.hpp"
+#include "diagnostic/detail/reductions.hpp"
+
+#include "core/data/vecfield/vecfield_component.hpp"
+#include "core/utilities/mpi_utils.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace PHARE::diagnostic::h5
+{
+/*
+ * In situ reductions of the particles or fields of one level, accumulated over the compute
+ * timestamps between two writes, and written as a single dataset per write
+ *
+ * /t#/pl#/histogram   : weight of the particles of a population binned along 1 to 3 axes
+ *                       among x, y, z, vx, vy, vz and energy, averaged over the computes,
+ *                       e.g. velocity distributions with (vx, vy) or energy spectra
+ * /t#/pl#/box_average : mean of a field over the cells of the level within a box
+ * /t#/pl#/line_cut    : field along the cells of the level crossed by a line parallel to an
+ *                       axis, averaged over the computes, NaN where the level has no patch
+ *
+ * Fields are named as in the level aggregated layout, e.g. EM_B_x, density, bulkVelocity_x,
+ * protons_density, protons_flux_x, and are sampled once per cell, at the first node of the
+ * cell for primal quantities, so that no value is counted twice across patches.
+ * Histograms and box averages can be restricted to a physical box.
+ * The values are computed by diagnostic::Reduction, this class parses and writes them.
+ */
+template<typename H5Writer>
+class ReducedDiagnosticWriter : public H5TypeWriter<H5Writer>
+{
+public:
+    using Super = H5TypeWriter<H5Writer>;
+    using Super::fileData_;
+    using Super::h5Writer_;
+    using Super::writeAttributes_;
+    using Attributes = typename Super::Attributes;
+    using GridLayout = typename H5Writer::GridLayout;
+    using Field      = typename Super::Field;
+
+    static constexpr auto dimension = GridLayout::dimension;
+
+    ReducedDiagnosticWriter(H5Writer& h5Writer)
+        : Super{h5Writer}
+    {
+    }
+
+    void write(DiagnosticProperties&) override;
+
+    void compute(DiagnosticProperties&) override;
+
+    void createFiles(DiagnosticProperties& diagnostic) override;
+
+    void getDataSetInfo(DiagnosticProperties&, std::size_t, std::string const&,
+                        Attributes&) override
+    {
+    }
+
+    void initDataSets(DiagnosticProperties& diagnostic,
+                      std::unordered_map<std::size_t, std::vector<std::string>> const& patchIDs,
+                      Attributes& patchAttributes, std::size_t maxLevel) override;
+
+    void writeAttributes(
+        DiagnosticProperties&, Attributes&,
+        std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+        std::size_t maxLevel) override;
+
+private:
+    using Reduction = diagnostic::Reduction<dimension>;
+
+    Reduction& reduction_(DiagnosticProperties const& diagnostic);
+    std::string path_(Reduction const& reduction) const;
+
+    Field const& field_(std::string const& name) const;
+
+    std::unordered_map<std::string, Reduction> reductions_;
+};
+
+
+
+template<typename H5Writer>
+auto ReducedDiagnosticWriter<H5Writer>::reduction_(DiagnosticProperties const& diagnostic)
+    -> Reduction&
+{
+    if (reductions_.count(diagnostic.quantity))
+        return reductions_.at(diagnostic.quantity);
+
+    auto const& params = diagnostic.params;
+    auto vector        = [&](std::string const& key, std::size_t size) {
+        std::vector<double> values(size);
+        for (std::size_t i = 0; i < size; ++i)
+            values[i] = diagnostic.param<double>(key + "_" + std::to_string(i));
+        return values;
+    };
+
+    Reduction reduction;
+    reduction.kind = diagnostic.param<std::string>("kind");
+    if (params.contains("level"))
+        reduction.level = diagnostic.param<std::size_t>("level");
+    if (params.contains("box_lower_0"))
+        reduction.box
+            = std::make_pair(vector("box_lower", dimension), vector("box_upper", dimension));
+
+    std::size_t size = 1;
+    if (reduction.kind == "histogram")
+    {
+        reduction.population = diagnostic.param<std::string>("population_name");
+        std::istringstream axes{diagnostic.param<std::string>("axes")};
+        for (std::string axis; std::getline(axes, axis, ',');)
+        {
+            bool const position
+                = axis.size() == 1 and axis[0] >= 'x' and axis[0] < 'x' + int{dimension};
+            bool const velocity = axis == "vx" or axis == "vy" or axis == "vz";
+            if (!position and !velocity and axis != "energy")
+                throw std::runtime_error("Reduced diagnostic: invalid histogram axis " + axis);
+            reduction.axes.push_back(axis);
+        }
+        if (reduction.axes.empty() or reduction.axes.size() > 3)
+            throw std::runtime_error("Reduced diagnostic histograms have 1 to 3 axes");
+
+        reduction.lower = vector("lower", reduction.axes.size());
+        reduction.upper = vector("upper", reduction.axes.size());
+        for (std::size_t i = 0; i < reduction.axes.size(); ++i)
+        {
+            reduction.bins.push_back(diagnostic.param<std::size_t>("bins_" + std::to_string(i)));
+            size *= reduction.bins.back();
+        }
+    }
+    else if (reduction.kind == "box_average" or reduction.kind == "line_cut")
+    {
+        reduction.field = diagnostic.param<std::string>("field");
+        if (reduction.kind == "line_cut")
+        {
+            reduction.cutAxis  = diagnostic.param<std::size_t>("cut_axis");
+            reduction.position = vector("position", dimension);
+            // the refinement ratio is 2
+            auto const& domainBox = h5Writer_.modelView().domainBox();
+            size = static_cast<std::size_t>(domainBox[reduction.cutAxis] + 1) << reduction.level;
+        }
+    }
+    else
+        throw std::runtime_error("Unknown reduced diagnostic " + reduction.kind);
+
+    reduction.sums.resize(size, 0);
+    reduction.counts.resize(size, 0);
+    return reductions_.emplace(diagnostic.quantity, std::move(reduction)).first->second;
+}
+
+
+
+template<typename H5Writer>
+std::string ReducedDiagnosticWriter<H5Writer>::path_(Reduction const& reduction) const
+{
+    return h5Writer_.getLevelPathAddTimestamp(reduction.level) + "/" + reduction.kind;
+}
+
+
+
+template<typename H5Writer>
+auto ReducedDiagnosticWriter<H5Writer>::field_(std::string const& name) const -> Field const&
+{
+    auto& modelView = h5Writer_.modelView();
+
+    for (auto* vecField : modelView.getElectromagFields())
+        for (auto& [id, type] : core::Components::componentMap)
+            if (name == vecField->name() + "_" + id)
+                return vecField->getComponent(type);
+
+    auto& ions = modelView.getIons();
+    if (name == "density")
+        return ions.density();
+    for (auto& [id, type] : core::Components::componentMap)
+        if (name == "bulkVelocity_" + id)
+            return ions.velocity().getComponent(type);
+
+    for (auto& pop : ions)
+    {
+        if (name == pop.name() + "_density")
+            return pop.density();
+        for (auto& [id, type] : core::Components::componentMap)
+            if (name == pop.name() + "_flux_" + id)
+                return pop.flux().getComponent(type);
+    }
+
+    throw std::runtime_error("Reduced diagnostic: unknown field " + name);
+}
+
+
+
+template<typename H5Writer>
+void ReducedDiagnosticWriter<H5Writer>::compute(DiagnosticProperties& diagnostic)
+{
+    auto& reduction = reduction_(diagnostic);
+
+    auto reduce = [&](GridLayout& layout, std::string const&, std::size_t) {
+        if (reduction.kind == "histogram")
+        {
+            for (auto& pop : h5Writer_.modelView().getIons())
+                if (pop.name() == reduction.population)
+                    reduction.histogram(layout, pop.domainParticles(), pop.mass());
+        }
+        else
+            reduction.fieldCells(layout, field_(reduction.field));
+    };
+    h5Writer_.modelView().visitHierarchy(reduce, reduction.level, reduction.level);
+
+    ++reduction.nbrComputes;
+}
+
+
+
+template<typename H5Writer>
+void ReducedDiagnosticWriter<H5Writer>::createFiles(DiagnosticProperties& diagnostic)
+{
+    if (!fileData_.count(diagnostic.quantity))
+        fileData_.emplace(diagnostic.quantity, h5Writer_.makeFile(diagnostic));
+}
+
+
+
+/*
+ * Reductions are summed on rank 0, which alone creates and writes the dataset.
+ * A write without a compute since the previous one computes the current state.
+ */
+template<typename H5Writer>
+void ReducedDiagnosticWriter<H5Writer>::initDataSets(
+    DiagnosticProperties& diagnostic,
+    std::unordered_map<std::size_t, std::vector<std::string>> const&, Attributes&, std::size_t)
+{
+    auto& reduction = reduction_(diagnostic);
+    if (reduction.nbrComputes == 0)
+        compute(diagnostic);
+
+    reduction.average(core::mpi::sum_on_root(reduction.sums),
+                      core::mpi::sum_on_root(reduction.counts));
+
+    if (core::mpi::rank() == 0)
+    {
+        auto shape = reduction.bins;
+        if (shape.empty())
+            shape.push_back(reduction.values.size());
+        auto& file = *fileData_.at(diagnostic.quantity);
+        file.template create_data_set_per_mpi<double>(path_(reduction), shape);
+    }
+}
+
+
+
+template<typename H5Writer>
+void ReducedDiagnosticWriter<H5Writer>::writeAttributes(
+    DiagnosticProperties& diagnostic, Attributes& fileAttributes,
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&
+        patchAttributes,
+    std::size_t maxLevel)
+{
+    auto& file            = *fileData_.at(diagnostic.quantity);
+    auto const& reduction = reduction_(diagnostic);
+
+    writeAttributes_(diagnostic, file, fileAttributes, patchAttributes, maxLevel);
+
+    if (core::mpi::rank() != 0)
+        return;
+
+    Attributes attributes;
+    attributes["nbr_computes"] = reduction.nbrComputes;
+    if (reduction.kind == "histogram")
+    {
+        std::string axes;
+        for (auto const& axis : reduction.axes)
+            axes += (axes.empty() ? "" : ",") + axis;
+        attributes["population_name"] = reduction.population;
+        attributes["axes"]            = axes;
+        attributes["lower"]           = reduction.lower;
+        attributes["upper"]           = reduction.upper;
+    }
+    else
+        attributes["field"] = reduction.field;
+    if (reduction.kind == "line_cut")
+    {
+        attributes["cut_axis"] = reduction.cutAxis;
+        attributes["position"] = reduction.position;
+    }
+    if (reduction.box)
+    {
+        attributes["box_lower"] = reduction.box->first;
+        attributes["box_upper"] = reduction.box->second;
+    }
+    h5Writer_.writeAttributeDict(file, attributes, path_(reduction));
+}
+
+
+
+template<typename H5Writer>
+void ReducedDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnostic)
+{
+    auto& reduction = reduction_(diagnostic);
+
+    if (core::mpi::rank() == 0)
+    {
+        auto& file = *fileData_.at(diagnostic.quantity);
+        auto const path = path_(reduction);
+        auto const* data = reduction.values.data();
+        if (reduction.bins.size() == 3)
+            file.template write_data_set_flat<3>(path, data);
+        else if (reduction.bins.size() == 2)
+            file.template write_data_set_flat<2>(path, data);
+        else
+            file.template write_data_set_flat<1>(path, data);
+    }
+
+    reduction.reset();
+}
+
+
+} // namespace PHARE::diagnostic::h5
+
+#endif /* PHARE_DIAGNOSTIC_DETAIL_TYPES_REDUCED_HPP */
@@ -3,10 +3,12 @@
 #define PHARE_DIAGNOSTIC_MANAGER_HPP_
 
 #include "core/data/particles/particle_array.hpp"
+#include "core/utilities/mpi_utils.hpp"
 #include "initializer/data_provider.hpp"
 #include "diagnostic_props.hpp"
 
 #include <utility>
+#include <algorithm>
 #include <cmath>
 #include <memory>
 
@@ -19,7 +21,8 @@ enum class Mode { LIGHT, FULL };
 template<typename DiagManager>
 void registerDiagnostics(DiagManager& dMan, initializer::PHAREDict const& diagsParams)
 {
-    std::vector<std::string> const diagTypes = {"fluid", "electromag", "particle", "info"};
+    std::vector<std::string> const diagTypes = {"fluid", "electromag", "particle", "info",
+                                               "reduced"};
 
     for (auto& diagType : diagTypes)
     {
@@ -45,6 +48,8 @@ class IDiagnosticsManager
 public:
     virtual bool dump(double timeStamp, double timeStep)         = 0;
     virtual void dump_level(std::size_t level, double timeStamp) = 0;
+    virtual void drain()                                         = 0;
+    virtual bool needsDump(double timeStamp, double timeStep)    = 0;
     inline virtual ~IDiagnosticsManager();
 };
 IDiagnosticsManager::~IDiagnosticsManager() {}
@@ -61,6 +66,19 @@ public:
     void dump_level(std::size_t level, double timeStamp) override;
 
 
+    // waits for pending asynchronous writes, e.g. before other HDF5 files are used
+    void drain() override { writer_->drain(); }
+
+
+    // true if a diagnostic is written at this time
+    bool needsDump(double timeStamp, double timeStep) override
+    {
+        return std::any_of(diagnostics_.begin(), diagnostics_.end(), [&](auto& diag) {
+            return needsWrite_(diag, timeStamp, timeStep);
+        });
+    }
+
+
     DiagnosticsManager(std::unique_ptr<Writer>&& writer_ptr)
         : writer_{std::move(writer_ptr)}
     {
@@ -139,6 +157,59 @@ DiagnosticsManager<Writer>::addDiagDict(initializer::PHAREDict const& diagParams
     diagProps.writeTimestamps = diagParams["write_timestamps"].template to<std::vector<double>>();
     diagProps["flush_every"]  = diagParams["flush_every"].template to<std::size_t>();
 
+    for (std::string const key :
+         {"chunk_size", "deflate", "shuffle", "coarsen_ratio", "write_ghosts"})
+        if (diagParams.contains(key))
+            diagProps[key] = diagParams[key].template to<std::size_t>();
+    if (diagParams.contains("lossy"))
+    {
+        diagProps["lossy"]           = diagParams["lossy"].template to<std::string>();
+        diagProps["lossy_tolerance"] = diagParams["lossy_tolerance"].template to<double>();
+    }
+
+    if (diagProps.type == "particle")
+    {
+        if (diagParams.contains("stride"))
+            diagProps["stride"] = diagParams["stride"].template to<std::size_t>();
+        for (std::string const key : {"fraction", "min_energy"})
+            if (diagParams.contains(key))
+                diagProps[key] = diagParams[key].template to<double>();
+
+        std::size_t const nbrBoxes
+            = diagParams.contains("nbr_boxes") ? diagParams["nbr_boxes"].template to<std::size_t>()
+                                               : 0;
+        if (nbrBoxes > 0)
+            diagProps["nbr_boxes"] = nbrBoxes;
+        for (std::size_t iBox = 0; iBox < nbrBoxes; ++iBox)
+            for (std::size_t iDim = 0; iDim < 3; ++iDim)
+                for (auto const bound : {"_lower_", "_upper_"})
+                {
+                    auto const key = "box_" + std::to_string(iBox) + bound + std::to_string(iDim);
+                    if (diagParams.contains(key))
+                        diagProps[key] = diagParams[key].template to<double>();
+                }
+    }
+
+    if (diagProps.type == "reduced")
+    {
+        auto copy = [&](std::string const& key, auto type) {
+            if (diagParams.contains(key))
+                diagProps[key] = diagParams[key].template to<decltype(type)>();
+        };
+        for (std::string const key : {"kind", "population_name", "axes", "field"})
+            copy(key, std::string{});
+        for (std::string const key : {"level", "cut_axis"})
+            copy(key, std::size_t{});
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            auto const idx = std::to_string(i);
+            copy("bins_" + idx, std::size_t{});
+            for (std::string const key :
+                 {"lower_", "upper_", "box_lower_", "box_upper_", "position_"})
+                copy(key + idx, double{});
+        }
+    }
+
     diagProps.computeTimestamps
         = diagParams["compute_timestamps"].template to<std::vector<double>>();
 
@@ -151,6 +222,9 @@ DiagnosticsManager<Writer>::addDiagDict(initializer::PHAREDict const& diagParams
         diagProps.fileAttributes[key] = val;
     }
 
+    // invalid storage options are reported now rather than at the first dump
+    Writer::filtersFor(diagProps).check(core::mpi::size());
+
     return *this;
 }
 
@@ -192,6 +266,13 @@ bool DiagnosticsManager<Writer>::dump(double timeStamp, double timeStep)
         nextWrite_[diag->type + diag->quantity]++;
     }
 
+    // the last dump is complete on return, as for synchronous dumps
+    if (activeDiagnostics.size() > 0
+        and std::all_of(diagnostics_.begin(), diagnostics_.end(), [&](auto const& diag) {
+                return nextWrite_[diag.type + diag.quantity] >= diag.writeTimestamps.size();
+            }))
+        writer_->drain();
+
     return activeDiagnostics.size() > 0;
 }
 
@@ -34,6 +34,7 @@ class ModelView : public IModelView
 
 public:
     using GridLayout = typename Model::gridlayout_type;
+    using Field      = typename VecField::field_type;
     using PatchProperties
         = cppdict::Dict<float, double, std::size_t, std::vector<int>, std::vector<std::uint32_t>,
                         std::vector<double>, std::vector<std::size_t>, std::string>;
@@ -80,17 +81,6 @@ public:
     }
 
 
-    static auto getEmptyPatchProperties()
-    {
-        PatchProperties dict;
-        dict["origin"]   = std::vector<double>{};
-        dict["nbrCells"] = std::vector<std::uint32_t>{};
-        dict["lower"]    = std::vector<int>{};
-        dict["upper"]    = std::vector<int>{};
-        dict["mpi_rank"] = std::size_t{0};
-        return dict;
-    }
-
     bool hasTagsVectorFor(int ilevel, std::string patch_id) const
     {
         auto key = std::to_string(ilevel) + "_" + patch_id;
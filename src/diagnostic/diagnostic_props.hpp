@@ -12,7 +12,7 @@ namespace PHARE::diagnostic
 struct DiagnosticProperties
 {
     // Types limited to actual need, no harm to modify
-    using Params         = cppdict::Dict<std::size_t>;
+    using Params         = cppdict::Dict<std::size_t, double, std::string>;
     using FileAttributes = cppdict::Dict<std::string>;
 
     std::vector<double> writeTimestamps, computeTimestamps;
@@ -20,6 +20,9 @@ struct DiagnosticProperties
 
     Params params{}; // supports arbitrary values for specific diagnostic writers
                      // for instance "flushEvery" for H5 file writers
+                     // or "chunk_size", "deflate", "shuffle", "lossy", "lossy_tolerance"
+                     // for the storage of their datasets
+                     // or "coarsen_ratio", "write_ghosts" for field diagnostics
 
     auto& operator[](std::string const& paramKey) { return params[paramKey]; }
 
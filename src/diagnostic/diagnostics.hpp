@@ -29,6 +29,7 @@
 #include "diagnostic/detail/types/particle.hpp"
 #include "diagnostic/detail/types/fluid.hpp"
 #include "diagnostic/detail/types/meta.hpp"
+#include "diagnostic/detail/types/reduced.hpp"
 
 #endif
 
@@ -45,6 +46,10 @@ struct NullOpDiagnosticsManager : public IDiagnosticsManager
     {
         throw std::runtime_error("NOOP");
     }
+
+    void drain() override {}
+
+    bool needsDump(double /*timeStamp*/, double /*timeStep*/) override { return false; }
 };
 
 struct DiagnosticsManagerResolver
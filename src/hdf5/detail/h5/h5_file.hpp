@@ -4,6 +4,17 @@
 #include "highfive/H5File.hpp"
 #include "highfive/H5Easy.hpp"
 
+#include "core/utilities/mpi_utils.hpp"
+#include "hdf5/detail/h5/h5_metadata.hpp"
+#include "hdf5/detail/h5/h5_filters.hpp"
+
+#include <memory>
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <iostream>
+#include <functional>
+
 namespace PHARE::hdf5::h5
 {
 using HiFile = HighFive::File;
@@ -78,6 +89,7 @@ public:
     HighFiveFile(std::string const path, unsigned flags = HiFile::ReadWrite, bool para = true)
         : fapl_{}
         , h5file_{createHighFiveFile(path, flags, para, fapl_)}
+        , parallel_{para}
     {
     }
 
@@ -94,6 +106,17 @@ public:
         return data;
     }
 
+    // reads the hyperslab of the dataset starting at offset, of count elements per dim
+    template<typename T>
+    auto read_data_set_flat_selection(std::string path, std::vector<std::size_t> const& offset,
+                                      std::vector<std::size_t> const& count) const
+    {
+        std::vector<T> data(core::product(count, std::size_t{1}));
+        if (data.size() > 0)
+            h5file_.getDataSet(path).select(offset, count).read(data.data());
+        return data;
+    }
+
     template<typename T, std::size_t dim = 1>
     auto read_data_set(std::string path) const
     {
@@ -113,16 +136,59 @@ public:
     template<std::size_t dim = 1, typename Data>
     auto& write_data_set_flat(std::string path, Data const& data)
     {
-        h5file_.getDataSet(path).write(pointer_dim_caster<dim>(data));
+        if (stage_)
+            stage_write_<dim>(path, {}, {}, data, h5file_.getDataSet(path).getElementCount());
+        else
+            h5file_.getDataSet(path).write(pointer_dim_caster<dim>(data));
         return *this;
     }
 
 
+    // writes data in the hyperslab of the dataset starting at offset, of count elements per dim
+    // count is zero for MPI processes taking part in collective writes with nothing to write
+    template<std::size_t dim = 1, typename Data>
+    auto& write_data_set_flat_selection(std::string path, std::vector<std::size_t> const& offset,
+                                        std::vector<std::size_t> const& count, Data const& data)
+    {
+        if (stage_)
+            stage_write_<dim>(path, offset, count, data, core::product(count, std::size_t{1}));
+        else
+            h5file_.getDataSet(path).select(offset, count).write(pointer_dim_caster<dim>(data),
+                                                                 transfer_props_());
+        return *this;
+    }
+
+
+    /*
+     * While set, hyperslab writes use collective MPI-IO transfers, which parallel filters
+     * require. All MPI processes must then do the same writes in the same order, with empty
+     * selections where they have nothing to write.
+     */
+    void set_collective_writes(bool collective) { collective_ = collective; }
+
+
     template<typename Type, typename Size>
     void create_data_set(std::string const& path, Size const& dataSetSize)
     {
         createGroupsToDataSet(path);
-        h5file_.createDataSet<Type>(path, HighFive::DataSpace(dataSetSize));
+
+        std::vector<std::size_t> shape;
+        if constexpr (core::is_iterable_v<Size>)
+            shape.assign(dataSetSize.begin(), dataSetSize.end());
+        else
+            shape.push_back(dataSetSize);
+
+        h5file_.createDataSet<Type>(path, HighFive::DataSpace(shape),
+                                    filters_.template properties<Type>(shape));
+    }
+
+
+    // filters apply to the datasets created afterwards, see DataSetFilters
+    // collectiveWrites tells all writes of the file are done with set_collective_writes
+    void set_filters(DataSetFilters const& filters, bool const collectiveWrites = false)
+    {
+        filters.check(core::mpi::size(), collectiveWrites);
+        filters_ = filters;
     }
 
 
@@ -137,6 +203,13 @@ public:
     template<typename Type, typename Size>
     void create_data_set_per_mpi(std::string const& path, Size const& dataSetSize)
     {
+        if (batch_)
+        {
+            if (!is_zero(dataSetSize) and path != "")
+                batch_->template add_data_set<Type>(path, dataSetSize);
+            return;
+        }
+
         auto mpi_size = core::mpi::size();
         auto sizes    = core::mpi::collect(dataSetSize, mpi_size);
         auto paths    = core::mpi::collect(path, mpi_size);
@@ -174,18 +247,12 @@ public:
     {
         constexpr bool data_is_vector = core::is_std_vector_v<Data>;
 
-        auto doAttribute = [&](auto node, auto const& _key, auto const& value) {
-            if constexpr (data_is_vector)
-            {
-                if (value.size())
-                    node.template createAttribute<typename Data::value_type>(
-                            _key, HighFive::DataSpace(value.size()))
-                        .write(value.data());
-            }
-            else
-                node.template createAttribute<Data>(_key, HighFive::DataSpace::From(value))
-                    .write(value);
-        };
+        if (batch_)
+        {
+            if (path != "null" and path != "")
+                batch_->add_attribute(path, key, data);
+            return;
+        }
 
         int mpi_size = core::mpi::size();
         auto values  = [&]() {
@@ -202,22 +269,77 @@ public:
             if (keyPath.empty())
                 continue;
 
-            if (h5file_.exist(keyPath)
-                && h5file_.getObjectType(keyPath) == HighFive::ObjectType::Dataset)
-            {
-                if (!h5file_.getDataSet(keyPath).hasAttribute(key))
-                    doAttribute(h5file_.getDataSet(keyPath), key, values[i]);
-            }
-            else // group
-            {
-                createGroupsToDataSet(keyPath + "/dataset");
-                if (!h5file_.getGroup(keyPath).hasAttribute(key))
-                    doAttribute(h5file_.getGroup(keyPath), key, values[i]);
-            }
+            if constexpr (data_is_vector)
+                create_attribute_<typename Data::value_type>(keyPath, key, values[i]);
+            else
+                create_attribute_<Data>(keyPath, key, values[i]);
         }
     }
 
 
+
+    /*
+     * While a metadata batch is open, create_data_set_per_mpi and write_attributes_per_mpi
+     * do not communicate but only record what is to be created. exchange_metadata then
+     * creates everything recorded on all MPI processes with a single exchange.
+     */
+    void open_metadata_batch() { batch_ = std::make_unique<MetadataBatch>(); }
+
+    auto close_metadata_batch()
+    {
+        assert(batch_);
+        auto batch = std::move(*batch_);
+        batch_.reset();
+        return batch;
+    }
+
+
+    // creates all datasets described by the given per MPI process buffers, then all attributes
+    template<typename Buffers>
+    void create_metadata(Buffers const& perMPIBuffers)
+    {
+        auto noAttribute = [](auto const&...) {};
+        auto noDataSet   = [](auto const&...) {};
+
+        for (auto const& buffer : perMPIBuffers)
+            MetadataBatch::unpack(buffer.data(), buffer.size(),
+                                  [&](auto const& path, auto const& shape, auto type) {
+                                      using Type = decltype(type);
+                                      if constexpr (!std::is_same_v<Type, std::string>)
+                                          create_data_set<Type>(path, shape);
+                                  },
+                                  noAttribute);
+
+        for (auto const& buffer : perMPIBuffers)
+            MetadataBatch::unpack(buffer.data(), buffer.size(), noDataSet,
+                                  [&](auto const& path, auto const& key, auto const& value) {
+                                      using Value = std::decay_t<decltype(value)>;
+                                      if constexpr (core::is_std_vector_v<Value>)
+                                          create_attribute_<typename Value::value_type>(path, key,
+                                                                                        value);
+                                      else
+                                          create_attribute_<Value>(path, key, value);
+                                  });
+    }
+
+
+    /*
+     * While writes are staged, write_data_set_flat(_selection) copy the data to be written
+     * instead of writing it, so that the source data can be modified before the actual
+     * writes, done by calling the functions returned by close_write_stage.
+     * Datasets must exist when their writes are staged.
+     */
+    void open_write_stage() { stage_ = std::make_unique<std::vector<std::function<void()>>>(); }
+
+    auto close_write_stage()
+    {
+        assert(stage_);
+        auto writes = std::move(*stage_);
+        stage_.reset();
+        return writes;
+    }
+
+
     HighFiveFile(const HighFiveFile&)  = delete;
     HighFiveFile(const HighFiveFile&&) = delete;
     HighFiveFile& operator=(const HighFiveFile&) = delete;
@@ -226,6 +348,65 @@ public:
 private:
     HighFive::FileAccessProps fapl_;
     HiFile h5file_;
+    std::unique_ptr<MetadataBatch> batch_;
+    DataSetFilters filters_;
+    std::unique_ptr<std::vector<std::function<void()>>> stage_;
+    bool parallel_   = true;
+    bool collective_ = false;
+
+
+    HighFive::DataTransferProps transfer_props_() const
+    {
+        HighFive::DataTransferProps xfer;
+#if defined(H5_HAVE_PARALLEL)
+        if (parallel_ and collective_)
+            xfer.add(HighFive::UseCollectiveIO{});
+#endif
+        return xfer;
+    }
+
+
+    template<std::size_t dim, typename Data>
+    void stage_write_(std::string const& path, std::vector<std::size_t> const& offset,
+                      std::vector<std::size_t> const& count, Data const& data, std::size_t size)
+    {
+        using Value = std::remove_cv_t<std::remove_pointer_t<Data>>;
+        auto copy   = std::make_shared<std::vector<Value>>(data, data + size);
+
+        // the transfer mode is the one at staging time
+        stage_->emplace_back([this, path, offset, count, copy, xfer = transfer_props_()]() {
+            auto dataSet = h5file_.getDataSet(path);
+            if (count.empty())
+                dataSet.write(pointer_dim_caster<dim>(copy->data()));
+            else
+                dataSet.select(offset, count).write(pointer_dim_caster<dim>(copy->data()), xfer);
+        });
+    }
+
+
+    // Data is the attribute element type, value either a single Data or a contiguous range
+    template<typename Data, typename Value>
+    void create_attribute_(std::string const& path, std::string const& key, Value const& value)
+    {
+        auto doAttribute = [&](auto node) {
+            if (node.hasAttribute(key))
+                return;
+            if constexpr (std::is_same_v<Data, Value>)
+                node.template createAttribute<Data>(key, HighFive::DataSpace::From(value))
+                    .write(value);
+            else if (value.size())
+                node.template createAttribute<Data>(key, HighFive::DataSpace(value.size()))
+                    .write(value.data());
+        };
+
+        if (h5file_.exist(path) && h5file_.getObjectType(path) == HighFive::ObjectType::Dataset)
+            doAttribute(h5file_.getDataSet(path));
+        else // group
+        {
+            createGroupsToDataSet(path + "/dataset");
+            doAttribute(h5file_.getGroup(path));
+        }
+    }
 
 
     // during attribute/dataset creation, we currently don't require the parents of the group to
@@ -261,6 +442,46 @@ private:
 
 
 
+/*
+ * Closes the metadata batches of the given files and exchanges them between all MPI processes
+ * in a single collective, after which each process creates all datasets and attributes.
+ * All processes must pass the same number of files, in the same order.
+ */
+template<typename Files>
+void exchange_metadata(Files const& files)
+{
+    std::vector<MetadataBatch> batches;
+    std::vector<char> local;
+    for (auto* file : files)
+    {
+        batches.emplace_back(file->close_metadata_batch());
+        auto const& buffer = batches.back().buffer();
+        auto const size    = buffer.size();
+        auto const* bytes  = reinterpret_cast<char const*>(&size);
+        local.insert(local.end(), bytes, bytes + sizeof(size));
+        local.insert(local.end(), buffer.begin(), buffer.end());
+    }
+
+    auto const perMPI = core::mpi::collect_raw(local, core::mpi::size());
+
+    // offsets of the buffer of the next file in the buffer of each MPI process
+    std::vector<std::size_t> offsets(perMPI.sizes.size(), 0);
+    for (auto* file : files)
+    {
+        std::vector<core::Span<char>> buffers;
+        for (std::size_t rank = 0; rank < offsets.size(); ++rank)
+        {
+            auto const* data = perMPI[static_cast<int>(rank)].data() + offsets[rank];
+            std::size_t size;
+            std::memcpy(&size, data, sizeof(size));
+            buffers.push_back({data + sizeof(size), size});
+            offsets[rank] += sizeof(size) + size;
+        }
+        file->create_metadata(buffers);
+    }
+}
+
+
 } // namespace PHARE::hdf5::h5
 
 
@@ -0,0 +1,99 @@
+#ifndef PHARE_HDF5_H5_FILTERS_HPP
+#define PHARE_HDF5_H5_FILTERS_HPP
+
+#include "highfive/H5File.hpp"
+
+#if defined(PHARE_HAS_H5Z_ZFP)
+#include "H5Zzfp.h"
+#endif
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace PHARE::hdf5::h5
+{
+/*
+  Storage options of the datasets of a file
+
+  chunkSize       : number of elements of the first dimension per chunk, 0 is contiguous storage
+  deflate         : gzip level in [1, 9], 0 disables it
+  shuffle         : byte shuffling before deflate, which helps compressing floating points
+  lossy           : name of a lossy compressor for floating point datasets, "" disables it,
+                    "zfp" is available if PHARE was built with H5Z-ZFP (-DH5Z_ZFP_ROOT=...)
+  lossyTolerance  : absolute error bound of the lossy compressor
+
+  Filters require chunking, if no chunkSize is given datasets are a single chunk.
+  Parallel HDF5 only writes filtered datasets collectively, so with several MPI processes
+  compression needs files written with collective transfers, see set_collective_writes.
+*/
+struct DataSetFilters
+{
+    std::size_t chunkSize = 0;
+    std::size_t deflate   = 0;
+    bool shuffle          = false;
+    std::string lossy;
+    double lossyTolerance = 0;
+
+
+    bool compressed() const { return deflate > 0 or shuffle or !lossy.empty(); }
+
+    bool chunked() const { return chunkSize > 0 or compressed(); }
+
+
+    void check(int const mpiSize = 1, bool const collectiveWrites = false) const
+    {
+        if (compressed() and mpiSize > 1 and !collectiveWrites)
+            throw std::runtime_error(
+                "DataSetFilters: compression needs a single MPI process or collective writes");
+        if (deflate > 9)
+            throw std::runtime_error("DataSetFilters: deflate level must be in [0, 9]");
+        if (!lossy.empty() and lossy != "zfp")
+            throw std::runtime_error("DataSetFilters: unknown lossy compressor " + lossy);
+#if !defined(PHARE_HAS_H5Z_ZFP)
+        if (lossy == "zfp")
+            throw std::runtime_error("DataSetFilters: PHARE not built with H5Z-ZFP");
+#endif
+        if (!lossy.empty() and lossyTolerance <= 0)
+            throw std::runtime_error("DataSetFilters: lossy compression needs a tolerance > 0");
+    }
+
+
+    template<typename Type>
+    HighFive::DataSetCreateProps properties(std::vector<std::size_t> const& shape) const
+    {
+        HighFive::DataSetCreateProps props;
+        if (!chunked() or shape.empty() or shape[0] == 0)
+            return props;
+
+        std::vector<hsize_t> chunk(shape.begin(), shape.end());
+        if (chunkSize > 0)
+            chunk[0] = std::min(chunk[0], static_cast<hsize_t>(chunkSize));
+        props.add(HighFive::Chunking(chunk));
+
+        constexpr bool floating = std::is_floating_point_v<Type>;
+        if (floating and lossy == "zfp")
+        {
+#if defined(PHARE_HAS_H5Z_ZFP)
+            static bool const registered = H5Z_zfp_initialize() >= 0;
+            if (!registered or H5Pset_zfp_accuracy(props.getId(), lossyTolerance) < 0)
+                throw std::runtime_error("DataSetFilters: cannot set the zfp filter");
+#endif
+            return props; // zfp works on the values, lossless filters would not help after it
+        }
+
+        if (shuffle)
+            props.add(HighFive::Shuffle());
+        if (deflate > 0)
+            props.add(HighFive::Deflate(static_cast<unsigned>(deflate)));
+        return props;
+    }
+};
+
+
+} // namespace PHARE::hdf5::h5
+
+#endif /* PHARE_HDF5_H5_FILTERS_HPP */
@@ -0,0 +1,227 @@
+#ifndef PHARE_HDF5_H5_METADATA_HPP
+#define PHARE_HDF5_H5_METADATA_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+#include "core/utilities/types.hpp"
+#include "core/utilities/meta/meta_utilities.hpp"
+
+namespace PHARE::hdf5::h5
+{
+/*
+  HDF5 requires all MPI processes to create all datasets and attributes of a parallel file.
+  Rather than exchanging the path and size/value of each of them as they are created, a
+  MetadataBatch packs descriptors of the local creations in a byte buffer, so that the buffers
+  of all processes can be exchanged at once, and unpacked by each process to do all creations.
+
+  A descriptor is
+    dataset   : kind, path, type, rank, shape
+    attribute : kind, path, key, type, isVector, nbrElements, elements
+*/
+class MetadataBatch
+{
+public:
+    enum class Kind : char { dataset, attribute };
+    enum class Type : char { Float, Double, Int, UInt32, SizeT, String };
+
+
+    template<typename T>
+    static constexpr Type type_for()
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return Type::Float;
+        else if constexpr (std::is_same_v<T, double>)
+            return Type::Double;
+        else if constexpr (std::is_same_v<T, int>)
+            return Type::Int;
+        else if constexpr (std::is_same_v<T, std::uint32_t>)
+            return Type::UInt32;
+        else if constexpr (std::is_same_v<T, std::size_t>)
+            return Type::SizeT;
+        else
+        {
+            static_assert(std::is_same_v<T, std::string>, "unhandled metadata type");
+            return Type::String;
+        }
+    }
+
+    // calls fn with a default constructed value of the type matching the tag
+    template<typename Fn>
+    static void visit_type(Type type, Fn&& fn)
+    {
+        switch (type)
+        {
+            case Type::Float: return fn(float{});
+            case Type::Double: return fn(double{});
+            case Type::Int: return fn(int{});
+            case Type::UInt32: return fn(std::uint32_t{});
+            case Type::SizeT: return fn(std::size_t{});
+            case Type::String: return fn(std::string{});
+        }
+        throw std::runtime_error("MetadataBatch: unknown type tag");
+    }
+
+
+
+    template<typename T, typename Size>
+    void add_data_set(std::string const& path, Size const& size)
+    {
+        put_(Kind::dataset);
+        put_(path);
+        put_(type_for<T>());
+        if constexpr (core::is_iterable_v<Size>)
+        {
+            put_(static_cast<std::size_t>(size.size()));
+            for (auto const& s : size)
+                put_(static_cast<std::size_t>(s));
+        }
+        else
+        {
+            put_(std::size_t{1});
+            put_(static_cast<std::size_t>(size));
+        }
+    }
+
+
+    template<typename Data>
+    void add_attribute(std::string const& path, std::string const& key, Data const& data)
+    {
+        put_(Kind::attribute);
+        put_(path);
+        put_(key);
+        if constexpr (core::is_std_vector_v<Data>)
+        {
+            put_(type_for<typename Data::value_type>());
+            put_(true);
+            put_(static_cast<std::size_t>(data.size()));
+            for (auto const& value : data)
+                put_(value);
+        }
+        else
+        {
+            put_(type_for<Data>());
+            put_(false);
+            put_(std::size_t{1});
+            put_(data);
+        }
+    }
+
+
+    auto& buffer() const { return buffer_; }
+    bool empty() const { return buffer_.empty(); }
+
+
+
+    /*
+      onDataSet(path, shape, T{}) is called for each dataset descriptor of the buffer,
+      onAttribute(path, key, value) for each attribute descriptor, value being either a
+      std::string, a std::vector<T> or a single T
+    */
+    template<typename OnDataSet, typename OnAttribute>
+    static void unpack(char const* data, std::size_t size, OnDataSet&& onDataSet,
+                       OnAttribute&& onAttribute)
+    {
+        Reader reader{data, data + size};
+        while (reader.pos < reader.end)
+        {
+            auto const kind = reader.template get<Kind>();
+            auto const path = reader.get_string();
+
+            if (kind == Kind::dataset)
+            {
+                auto const type = reader.template get<Type>();
+                std::vector<std::size_t> shape(reader.template get<std::size_t>());
+                for (auto& s : shape)
+                    s = reader.template get<std::size_t>();
+                visit_type(type, [&](auto value) { onDataSet(path, shape, value); });
+            }
+            else
+            {
+                auto const key         = reader.get_string();
+                auto const type        = reader.template get<Type>();
+                auto const isVector    = reader.template get<bool>();
+                auto const nbrElements = reader.template get<std::size_t>();
+                visit_type(type, [&](auto value) {
+                    using T = decltype(value);
+                    if (isVector)
+                    {
+                        std::vector<T> values(nbrElements);
+                        for (auto& v : values)
+                            v = reader.template get_value<T>();
+                        onAttribute(path, key, values);
+                    }
+                    else
+                        onAttribute(path, key, reader.template get_value<T>());
+                });
+            }
+        }
+        assert(reader.pos == reader.end);
+    }
+
+
+
+private:
+    struct Reader
+    {
+        template<typename T>
+        T get()
+        {
+            T value;
+            assert(pos + sizeof(T) <= end);
+            std::memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        std::string get_string()
+        {
+            auto const size = get<std::size_t>();
+            assert(pos + size <= end);
+            std::string value{pos, size};
+            pos += size;
+            return value;
+        }
+
+        template<typename T>
+        T get_value()
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+                return get_string();
+            else
+                return get<T>();
+        }
+
+        char const* pos;
+        char const* end;
+    };
+
+
+    template<typename T>
+    void put_(T const& value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            put_(static_cast<std::size_t>(value.size()));
+            buffer_.insert(buffer_.end(), value.begin(), value.end());
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            auto const* bytes = reinterpret_cast<char const*>(&value);
+            buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+        }
+    }
+
+    std::vector<char> buffer_;
+};
+
+
+} // namespace PHARE::hdf5::h5
+
+#endif /* PHARE_HDF5_H5_METADATA_HPP */
@@ -15,24 +15,37 @@ namespace PHARE::hdf5
 class ParticleWriter
 {
 public:
+    // number of particles copied at a time to be written, bounds the memory used by writes
+    static constexpr std::size_t chunk_size = 1 << 16;
+
     template<typename H5File, typename Particles>
     static void write(H5File& h5file, Particles const& particles, std::string const& path)
     {
-        auto constexpr dim = Particles::dimension;
-        using Packer       = core::ParticlePacker<dim>;
-
-        Packer packer(particles);
-        core::ContiguousParticles<dim> copy{particles.size()};
-        packer.pack(copy);
-
-        std::size_t part_idx = 0;
-        core::apply(copy.as_tuple(), [&](auto const& arg) {
-            auto data_path = path + packer.keys()[part_idx++];
-            h5file.template write_data_set_flat<2>(data_path, arg.data());
-        });
+        core::ParticlePacker<Particles::dimension> packer(particles);
+        packer.pack_chunks(chunk_size, writeChunk_(h5file, path));
+    }
+
+
+    // writes only the particles for which select(index, particle) is true, without copying
+    // the others
+    template<typename H5File, typename Particles, typename Select>
+    static void write(H5File& h5file, Particles const& particles, std::string const& path,
+                      Select const& select)
+    {
+        core::ParticlePacker<Particles::dimension> packer(particles);
+        packer.pack_chunks(chunk_size, select, writeChunk_(h5file, path));
     }
 
 
+    // writes the particles from the row offset of datasets holding several particle arrays
+    template<typename H5File, typename Particles>
+    static void write_at(H5File& h5file, Particles const& particles, std::string const& path,
+                         std::size_t offset)
+    {
+        core::ParticlePacker<Particles::dimension> packer(particles);
+        packer.pack_chunks(chunk_size, writeChunk_(h5file, path, offset));
+    }
+
 
 
     template<std::size_t dim, typename T, typename Size>
@@ -45,6 +58,23 @@ public:
         else /* not an array so value one of type T*/
             return std::vector<std::size_t>{n_particles, 1};
     }
+
+private:
+    template<typename H5File>
+    static auto writeChunk_(H5File& h5file, std::string const& path, std::size_t offset = 0)
+    {
+        return [&h5file, path, offset](auto const& chunk, std::size_t first, std::size_t size) {
+            auto constexpr dim = std::decay_t<decltype(chunk)>::dimension;
+            auto const& keys   = core::ParticlePacker<dim>::keys();
+            std::size_t part_idx = 0;
+            core::apply(chunk.as_tuple(), [&](auto const& arg) {
+                auto data_path           = path + keys[part_idx++];
+                auto const nbrComponents = arg.size() / chunk.size();
+                h5file.template write_data_set_flat_selection<2>(
+                    data_path, {offset + first, 0}, {size, nbrComponents}, arg.data());
+            });
+        };
+    }
 };
 
 
@@ -0,0 +1,149 @@
+#ifndef PHARE_INITIALIZER_INIT_FUNCTION_CACHE_HPP
+#define PHARE_INITIALIZER_INIT_FUNCTION_CACHE_HPP
+
+#include "core/utilities/span.hpp"
+#include "core/utilities/types.hpp"
+#include "initializer/data_provider.hpp"
+
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <unordered_map>
+
+namespace PHARE::initializer
+{
+/** \brief InitFunctionCache evaluates an InitFunction for the coordinates of many patches in a
+ * single call, and keeps the values of each set of coordinates.
+ *
+ * Init functions are usually Python functions, for which each call costs a round trip through
+ * the interpreter. prefetch concatenates the coordinates of all patches not cached yet and
+ * evaluates the function once over them, the values for the coordinates of a patch being
+ * then found by operator(), which evaluates and caches coordinates that were not prefetched.
+ */
+template<std::size_t dim>
+class InitFunctionCache
+{
+public:
+    using Coords = core::tuple_fixed_type<std::vector<double>, dim>;
+    using Values = std::shared_ptr<core::Span<double>>;
+
+    explicit InitFunctionCache(InitFunction<dim> function)
+        : function_{std::move(function)}
+    {
+    }
+
+
+    // an InitFunction reading the cache of function, prefetched for coords
+    static InitFunction<dim> prefetched(InitFunction<dim> const& function,
+                                        std::vector<Coords> const& coords)
+    {
+        auto cache = std::make_shared<InitFunctionCache>(function);
+        cache->prefetch(coords);
+        return [cache](auto const&... xyz) { return (*cache)(xyz...); };
+    }
+
+
+    void prefetch(std::vector<Coords> const& coords)
+    {
+        Coords all;
+        std::vector<Coords const*> missing;
+        for (auto const& patchCoords : coords)
+            if (!find_(patchCoords))
+            {
+                missing.push_back(&patchCoords);
+                append_(all, patchCoords, std::make_index_sequence<dim>{});
+            }
+
+        if (missing.empty())
+            return;
+
+        auto const values = std::apply([&](auto const&... xyz) { return function_(xyz...); }, all);
+        double const* first = values->data();
+        for (auto const* patchCoords : missing)
+        {
+            auto const size = std::get<0>(*patchCoords).size();
+            store_(*patchCoords, std::vector<double>(first, first + size));
+            first += size;
+        }
+    }
+
+
+    template<typename... Xyz>
+    Values operator()(Xyz const&... xyz)
+    {
+        static_assert(sizeof...(Xyz) == dim);
+
+        Coords const coords{xyz...};
+        if (auto values = find_(coords))
+            return values;
+
+        auto const values = function_(xyz...);
+        return store_(coords, std::vector<double>(values->data(), values->data() + values->size()));
+    }
+
+
+private:
+    struct Entry
+    {
+        Coords coords;
+        Values values;
+    };
+
+
+    template<std::size_t... iDims>
+    static void append_(Coords& to, Coords const& from, std::index_sequence<iDims...>)
+    {
+        (std::get<iDims>(to).insert(std::get<iDims>(to).end(), std::get<iDims>(from).begin(),
+                                    std::get<iDims>(from).end()),
+         ...);
+    }
+
+
+    static std::size_t hash_(Coords const& coords)
+    {
+        std::size_t hash = 0;
+        std::apply(
+            [&](auto const&... xyz) {
+                for (auto const* values : {&xyz...})
+                    for (auto const value : *values)
+                    {
+                        std::uint64_t bits;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        hash ^= std::hash<std::uint64_t>{}(bits) + 0x9E3779B97F4A7C15
+                                + (hash << 6) + (hash >> 2);
+                    }
+            },
+            coords);
+        return hash;
+    }
+
+
+    Values find_(Coords const& coords) const
+    {
+        auto const it = entries_.find(hash_(coords));
+        if (it != entries_.end())
+            for (auto const& entry : it->second)
+                if (entry.coords == coords)
+                    return entry.values;
+        return nullptr;
+    }
+
+
+    Values store_(Coords const& coords, std::vector<double>&& values)
+    {
+        auto span = std::make_shared<core::VectorSpan<double>>(std::move(values));
+        entries_[hash_(coords)].push_back(Entry{coords, span});
+        return span;
+    }
+
+
+    InitFunction<dim> function_;
+    std::unordered_map<std::size_t, std::vector<Entry>> entries_;
+};
+
+
+} // namespace PHARE::initializer
+
+#endif // PHARE_INITIALIZER_INIT_FUNCTION_CACHE_HPP
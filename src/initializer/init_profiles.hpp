@@ -0,0 +1,238 @@
+#ifndef PHARE_INITIALIZER_INIT_PROFILES_HPP
+#define PHARE_INITIALIZER_INIT_PROFILES_HPP
+
+#include "core/utilities/span.hpp"
+#include "initializer/data_provider.hpp"
+
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace PHARE::initializer
+{
+/** \brief InitProfiles builds init functions evaluated in C++ from closed form profiles,
+ * selected by name with their parameters (see pyphare.pharein.profiles), so that initializing
+ * a patch does not need the Python interpreter.
+ *
+ * A profile dict holds its "name" and parameters, "axis" being the index of the coordinate a
+ * one dimensional profile depends on:
+ *   - uniform   : value
+ *   - tanh      : offset + amplitude * tanh((x - center) / width)
+ *   - cosh      : offset + amplitude / cosh((x - center) / width)^2
+ *   - harris    : background + amplitude * sum_i f((x - centers_i) / width), f being 1/cosh^2
+ *                 for the "density" kind, and the tanh of alternate signs for "field"
+ *   - gaussian  : offset + amplitude * exp(-sum_d (x_d - center_d)^2 / (2 sigma_d^2))
+ *   - piecewise : values_i for bounds_{i-1} <= x < bounds_i
+ *   - sum       : sum of the nbr_terms profiles of terms/0, terms/1...
+ * Other profiles can be registered with add().
+ */
+template<std::size_t dim>
+class InitProfiles
+{
+public:
+    using Coords  = std::array<std::vector<double> const*, dim>;
+    using Builder = std::function<InitFunction<dim>(PHAREDict const&)>;
+
+
+    static InitFunction<dim> make(PHAREDict const& dict)
+    {
+        auto const name = dict["name"].template to<std::string>();
+        auto const& registry = registry_();
+        if (auto it = registry.find(name); it != registry.end())
+            return it->second(dict);
+        throw std::runtime_error("InitProfiles: unknown profile " + name);
+    }
+
+
+    static void add(std::string const& name, Builder builder)
+    {
+        registry_()[name] = std::move(builder);
+    }
+
+
+    // init function computing the values at the coordinates with compute(coords, values)
+    template<typename Compute>
+    static InitFunction<dim> function(Compute compute)
+    {
+        return [compute](auto const&... xyz) {
+            Coords const coords{&xyz...};
+            std::vector<double> values(coords[0]->size());
+            compute(coords, values);
+            return std::make_shared<core::VectorSpan<double>>(std::move(values));
+        };
+    }
+
+
+private:
+    static auto& registry_()
+    {
+        static std::unordered_map<std::string, Builder> registry{
+            {"uniform", uniform_},   {"tanh", tanh_},         {"cosh", cosh_},
+            {"harris", harris_},     {"gaussian", gaussian_}, {"piecewise", piecewise_},
+            {"sum", sum_}};
+        return registry;
+    }
+
+
+    static double get_(PHAREDict const& dict, std::string const& key, double default_)
+    {
+        return dict.contains(key) ? dict[key].template to<double>() : default_;
+    }
+
+    static std::size_t axis_(PHAREDict const& dict)
+    {
+        auto const axis = dict["axis"].template to<std::size_t>();
+        if (axis >= dim)
+            throw std::runtime_error("InitProfiles: invalid axis " + std::to_string(axis));
+        return axis;
+    }
+
+
+    // offset + amplitude * shape((x - center) / width), x along the axis of the profile
+    template<typename Shape>
+    static InitFunction<dim> alongAxis_(PHAREDict const& dict, Shape shape)
+    {
+        auto const axis      = axis_(dict);
+        auto const center    = dict["center"].template to<double>();
+        auto const width     = dict["width"].template to<double>();
+        auto const amplitude = get_(dict, "amplitude", 1);
+        auto const offset    = get_(dict, "offset", 0);
+        return function([=](Coords const& coords, std::vector<double>& values) {
+            auto const& x = *coords[axis];
+            for (std::size_t i = 0; i < values.size(); ++i)
+                values[i] = offset + amplitude * shape((x[i] - center) / width);
+        });
+    }
+
+
+    static InitFunction<dim> uniform_(PHAREDict const& dict)
+    {
+        auto const value = dict["value"].template to<double>();
+        return function([=](Coords const&, std::vector<double>& values) {
+            std::fill(values.begin(), values.end(), value);
+        });
+    }
+
+    static InitFunction<dim> tanh_(PHAREDict const& dict)
+    {
+        return alongAxis_(dict, [](double u) { return std::tanh(u); });
+    }
+
+    static InitFunction<dim> cosh_(PHAREDict const& dict)
+    {
+        return alongAxis_(dict, [](double u) { return 1. / (std::cosh(u) * std::cosh(u)); });
+    }
+
+
+    static InitFunction<dim> harris_(PHAREDict const& dict)
+    {
+        auto const axis       = axis_(dict);
+        auto const centers    = dict["centers"].template to<std::vector<double>>();
+        auto const width      = dict["width"].template to<double>();
+        auto const amplitude  = get_(dict, "amplitude", 1);
+        auto const background = get_(dict, "background", 0);
+        auto const density    = dict["kind"].template to<std::string>() == "density";
+        return function([=](Coords const& coords, std::vector<double>& values) {
+            auto const& x = *coords[axis];
+            std::fill(values.begin(), values.end(), background);
+            for (std::size_t iSheet = 0; iSheet < centers.size(); ++iSheet)
+            {
+                double const sign = iSheet % 2 == 0 ? 1 : -1;
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    auto const u = (x[i] - centers[iSheet]) / width;
+                    values[i] += amplitude
+                                 * (density ? 1. / (std::cosh(u) * std::cosh(u))
+                                            : sign * std::tanh(u));
+                }
+            }
+        });
+    }
+
+
+    static InitFunction<dim> gaussian_(PHAREDict const& dict)
+    {
+        auto const center    = dict["center"].template to<std::vector<double>>();
+        auto const sigma     = dict["sigma"].template to<std::vector<double>>();
+        auto const amplitude = get_(dict, "amplitude", 1);
+        auto const offset    = get_(dict, "offset", 0);
+        if (center.size() != dim or sigma.size() != dim)
+            throw std::runtime_error("InitProfiles: gaussian center and sigma need dim values");
+        return function([=](Coords const& coords, std::vector<double>& values) {
+            std::fill(values.begin(), values.end(), 0.);
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            {
+                auto const& x = *coords[iDim];
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    auto const u = (x[i] - center[iDim]) / sigma[iDim];
+                    values[i] += .5 * u * u;
+                }
+            }
+            for (auto& value : values)
+                value = offset + amplitude * std::exp(-value);
+        });
+    }
+
+
+    static InitFunction<dim> piecewise_(PHAREDict const& dict)
+    {
+        auto const axis   = axis_(dict);
+        auto const bounds = dict["bounds"].template to<std::vector<double>>();
+        auto const pieces = dict["values"].template to<std::vector<double>>();
+        if (pieces.size() != bounds.size() + 1 or !std::is_sorted(bounds.begin(), bounds.end()))
+            throw std::runtime_error("InitProfiles: piecewise needs one more value than bounds");
+        return function([=](Coords const& coords, std::vector<double>& values) {
+            auto const& x = *coords[axis];
+            for (std::size_t i = 0; i < values.size(); ++i)
+                values[i] = pieces[static_cast<std::size_t>(
+                    std::upper_bound(bounds.begin(), bounds.end(), x[i]) - bounds.begin())];
+        });
+    }
+
+
+    static InitFunction<dim> sum_(PHAREDict const& dict)
+    {
+        std::vector<InitFunction<dim>> terms;
+        auto const nbrTerms = dict["nbr_terms"].template to<std::size_t>();
+        for (std::size_t iTerm = 0; iTerm < nbrTerms; ++iTerm)
+            terms.push_back(make(dict["terms"][std::to_string(iTerm)]));
+        return function([=](Coords const& coords, std::vector<double>& values) {
+            std::fill(values.begin(), values.end(), 0.);
+            for (auto const& term : terms)
+            {
+                auto const termValues
+                    = std::apply([&](auto const*... xyz) { return term(*xyz...); }, coords);
+                auto const* data = termValues->data();
+                for (std::size_t i = 0; i < values.size(); ++i)
+                    values[i] += data[i];
+            }
+        });
+    }
+};
+
+
+
+/** the init function of a dict entry, either a function set from Python, or a dict selecting
+ * a profile of InitProfiles
+ */
+template<std::size_t dim>
+InitFunction<dim> initFunction(PHAREDict const& entry)
+{
+    if (entry.isNode())
+        return InitProfiles<dim>::make(entry);
+    return entry.template to<InitFunction<dim>>();
+}
+
+
+} // namespace PHARE::initializer
+
+#endif // PHARE_INITIALIZER_INIT_PROFILES_HPP
@@ -76,4 +76,5 @@ int main(int argc, char** argv)
         std::cout << simulator->currentTime() << "\n";
         //    time += simulator.timeStep();
     }
+    simulator->drain();
 }
@@ -29,7 +29,15 @@ class SamraiLifeCycle
 public:
     SamraiLifeCycle(int argc = 0, char** argv = nullptr)
     {
-        SAMRAI::tbox::SAMRAI_MPI::init(&argc, &argv);
+        // MPI_THREAD_MULTIPLE allows diagnostics to be written from an I/O thread
+        // without it, asynchronous writers are synchronous, see core::makeAsyncWorker
+        int provided = 0;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+        SAMRAI::tbox::SAMRAI_MPI::init(MPI_COMM_WORLD);
+        if (provided < MPI_THREAD_MULTIPLE and core::mpi::rank() == 0)
+            std::cout << "WARNING: MPI_THREAD_MULTIPLE not provided, asynchronous diagnostics "
+                         "and restarts are synchronous"
+                      << std::endl;
         SAMRAI::tbox::SAMRAIManager::initialize();
         SAMRAI::tbox::SAMRAIManager::startup();
         // SAMRAI::tbox::SAMRAI_MPI::setCallAbortInParallelInsteadOfMPIAbort();
@@ -42,6 +50,7 @@ public:
         SAMRAI::tbox::SAMRAIManager::shutdown();
         SAMRAI::tbox::SAMRAIManager::finalize();
         SAMRAI::tbox::SAMRAI_MPI::finalize();
+        MPI_Finalize(); // SAMRAI only finalizes MPI if it initialized it
     }
 
     static void reset()
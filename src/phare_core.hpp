@@ -34,7 +34,8 @@ struct PHARE_Types
     static auto constexpr dimension    = dimension_;
     static auto constexpr interp_order = interp_order_;
 
-    using Array_t      = PHARE::core::NdArrayVector<dimension>;
+    using Array_t
+        = PHARE::core::NdArrayVector<dimension, double, true, PHARE::core::ndarray_row_padding>;
     using VecField_t   = PHARE::core::VecField<Array_t, PHARE::core::HybridQuantity>;
     using Field_t      = PHARE::core::Field<Array_t, PHARE::core::HybridQuantity::Scalar>;
     using Electromag_t = PHARE::core::Electromag<VecField_t>;
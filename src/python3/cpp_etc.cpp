@@ -1,5 +1,6 @@
 
 #include "python3/pybind_def.hpp"
+#include "python3/cpp_simulator.hpp" // for declare_essential
 #include "simulator/simulator.hpp"
 
 
@@ -31,6 +32,8 @@ auto samrai_version()
 
 PYBIND11_MODULE(cpp_etc, m)
 {
+    declare_essential(m);
+
     py::class_<core::Span<double>, std::shared_ptr<core::Span<double>>>(m, "Span");
     py::class_<PyArrayWrapper<double>, std::shared_ptr<PyArrayWrapper<double>>, core::Span<double>>(
         m, "PyWrapper");
@@ -11,16 +11,11 @@ namespace PHARE::pydata
 {
 PYBIND11_MODULE(PHARE_CPP_MOD_NAME, m)
 {
-    declare_essential(m);
+    import_essential(m);
 
-    declareDim<1>(m);
-    declareDim<2>(m);
-    declareDim<3>(m);
-
-    core::apply(core::possibleSimulators(), [&](auto const& simType) { declare_all(m, simType); });
-
-    declarePatchData<std::vector<double>, 1>(m, "PatchDataVectorDouble_1D");
-    declarePatchData<std::vector<double>, 2>(m, "PatchDataVectorDouble_2D");
-    declarePatchData<std::vector<double>, 3>(m, "PatchDataVectorDouble_3D");
+    core::apply(core::possibleSimulators(), [&](auto const& simType) {
+        if constexpr (isModuleSimulator<std::decay_t<decltype(simType)>>())
+            declare_all(m, simType);
+    });
 }
 } // namespace PHARE::pydata
@@ -56,10 +56,15 @@ void declareDim(py::module& m)
         .def_readwrite("weight", &CP::weight)
         .def_readwrite("charge", &CP::charge)
         .def_readwrite("v", &CP::v)
+        .def_readwrite("id", &CP::id)
         .def("size", &CP::size);
 
     name = "PatchData" + name;
     declarePatchData<CP, dim>(m, name.c_str());
+
+    // see particleArrays
+    name = "PatchDataParticleArrays_" + std::to_string(dim);
+    declarePatchData<py::dict, dim>(m, name.c_str());
 }
 
 template<typename Simulator, typename PyClass>
@@ -74,7 +79,8 @@ void declareSimulator(PyClass&& sim)
         .def("to_str", &Simulator::to_str)
         .def("domain_box", &Simulator::domainBox)
         .def("cell_width", &Simulator::cellWidth)
-        .def("dump", &Simulator::dump, py::arg("timestamp"), py::arg("timestep"));
+        .def("dump", &Simulator::dump, py::arg("timestamp"), py::arg("timestep"))
+        .def("drain", &Simulator::drain);
 }
 
 template<typename _dim, typename _interp, typename _nbRefinedPart>
@@ -93,34 +99,43 @@ void declare_etc(py::module& m)
     py::class_<DW, std::shared_ptr<DW>>(m, name.c_str())
         .def(py::init<std::shared_ptr<Sim> const&, std::shared_ptr<amr::Hierarchy> const&>())
         .def(py::init<std::shared_ptr<ISimulator> const&, std::shared_ptr<amr::Hierarchy> const&>())
-        .def("sync_merge", &DW::sync_merge)
+        .def("sync_merge", &DW::sync_merge, py::arg("input"), py::arg("primal"),
+             py::arg("root") = -1)
         .def("getPatchLevel", &DW::getPatchLevel)
         .def("getNumberOfLevels", &DW::getNumberOfLevels);
 
     using PL = PatchLevel<dim, interp, nbRefinedPart>;
     name     = "PatchLevel_" + type_string;
 
+    // fields are numpy views of the patch memory unless copy is true, see fieldArray
+    auto const copy = py::arg("copy") = false;
     py::class_<PL, std::shared_ptr<PL>>(m, name.c_str())
-        .def("getEM", &PL::getEM)
-        .def("getE", &PL::getE)
-        .def("getB", &PL::getB)
-        .def("getBx", &PL::getBx)
-        .def("getBy", &PL::getBy)
-        .def("getBz", &PL::getBz)
-        .def("getEx", &PL::getEx)
-        .def("getEy", &PL::getEy)
-        .def("getEz", &PL::getEz)
-        .def("getVix", &PL::getVix)
-        .def("getViy", &PL::getViy)
-        .def("getViz", &PL::getViz)
-        .def("getDensity", &PL::getDensity)
-        .def("getBulkVelocity", &PL::getBulkVelocity)
-        .def("getPopDensities", &PL::getPopDensities)
-        .def("getPopFluxes", &PL::getPopFlux)
-        .def("getFx", &PL::getFx)
-        .def("getFy", &PL::getFy)
-        .def("getFz", &PL::getFz)
-        .def("getParticles", &PL::getParticles, py::arg("userPopName") = "all");
+        .def("getEM", &PL::getEM, copy)
+        .def("getE", &PL::getE, py::arg("componentName"), copy)
+        .def("getB", &PL::getB, py::arg("componentName"), copy)
+        .def("getBx", &PL::getBx, copy)
+        .def("getBy", &PL::getBy, copy)
+        .def("getBz", &PL::getBz, copy)
+        .def("getEx", &PL::getEx, copy)
+        .def("getEy", &PL::getEy, copy)
+        .def("getEz", &PL::getEz, copy)
+        .def("getVix", &PL::getVix, copy)
+        .def("getViy", &PL::getViy, copy)
+        .def("getViz", &PL::getViz, copy)
+        .def("getDensity", &PL::getDensity, copy)
+        .def("getBulkVelocity", &PL::getBulkVelocity, copy)
+        .def("getPopDensities", &PL::getPopDensities, copy)
+        .def("getPopFluxes", &PL::getPopFlux, copy)
+        .def("getFx", &PL::getFx, py::arg("pop"), copy)
+        .def("getFy", &PL::getFy, py::arg("pop"), copy)
+        .def("getFz", &PL::getFz, py::arg("pop"), copy)
+        .def("getParticles", py::overload_cast<std::string>(&PL::getParticles),
+             py::arg("userPopName") = "all")
+        .def("getParticles",
+             py::overload_cast<std::string, std::string, typename PL::CellBox, std::size_t>(
+                 &PL::getParticles),
+             py::arg("pop"), py::arg("kind"), py::arg("box") = py::none(),
+             py::arg("stride") = 1);
 
     using _Splitter
         = PHARE::amr::Splitter<_dim, _interp, core::RefinedParticlesConst<nbRefinedPart>>;
@@ -169,6 +184,21 @@ void declare_all(py::module& m, std::tuple<Dimension, InterpOrder, NbRefinedPart
     });
 }
 
+// whether the module declares the simulators of this option of possibleSimulators, all of them
+// but for the modules cpp_<dim>_<interp> of -DsimulatorLibs=ON
+template<typename SimulatorOption>
+constexpr bool isModuleSimulator()
+{
+#if defined(PHARE_CPP_DIM)
+    return std::tuple_element_t<0, SimulatorOption>{}() == PHARE_CPP_DIM
+           and std::tuple_element_t<1, SimulatorOption>{}() == PHARE_CPP_INTERP;
+#else
+    return true;
+#endif
+}
+
+// types and functions independent of the simulators, declared by the module cpp_etc only:
+// pybind registers a type once per process, and several simulator modules can be imported
 void declare_essential(py::module& m)
 {
     py::class_<SamraiLifeCycle, std::shared_ptr<SamraiLifeCycle>>(m, "SamraiLifeCycle")
@@ -181,6 +211,23 @@ void declare_essential(py::module& m)
     m.def("mpi_size", []() { return core::mpi::size(); });
     m.def("mpi_rank", []() { return core::mpi::rank(); });
     m.def("mpi_barrier", []() { core::mpi::barrier(); });
+
+    declareDim<1>(m);
+    declareDim<2>(m);
+    declareDim<3>(m);
+
+    declarePatchData<py::array_t<double>, 1>(m, "PatchDataPyArrayDouble_1D");
+    declarePatchData<py::array_t<double>, 2>(m, "PatchDataPyArrayDouble_2D");
+    declarePatchData<py::array_t<double>, 3>(m, "PatchDataPyArrayDouble_3D");
+}
+
+// the simulator modules expose what cpp_etc declares as their own, e.g. cpp.mpi_rank()
+void import_essential(py::module& m)
+{
+    auto etc = py::module::import("pybindlibs.cpp_etc");
+    for (auto const& [name, value] : etc.attr("__dict__").cast<py::dict>())
+        if (auto const key = name.cast<std::string>(); key.rfind("__", 0) != 0)
+            m.attr(name) = value;
 }
 
 
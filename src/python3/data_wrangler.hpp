@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -85,77 +86,131 @@ public:
             *hierarchy_, *simulator_.getHybridModel(), lvl};
     }
 
-    auto sort_merge_1d(std::vector<PatchData<std::vector<double>, dimension>> const&& input,
-                       bool shared_patch_border = false)
+    /** \brief the patch datas of all processes, gathered on all of them, or on root if root >= 0
+     *
+     * The patches of each process are packed into a single buffer of doubles, one after the
+     * other as: lower, upper (dimension values each), nGhosts, shape of the data (dimension
+     * values) and the data, gathered with one MPI_Gatherv (MPI_Allgatherv).
+     * The patch IDs and origins are not gathered.
+     */
+    auto sync(std::vector<FieldPatchData<dimension>> const& input, int root = -1)
     {
-        std::vector<std::pair<double, const PatchData<std::vector<double>, dimension>*>> sorted;
-        for (auto const& data : input)
-            sorted.emplace_back(core::Point<double, 1>::fromString(data.origin)[0], &data);
-        std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) { return a.first < b.first; });
-        std::vector<double> ret;
-        for (size_t i = 0; i < sorted.size(); i++)
-        { // skip empty patches in case of unequal patches across MPI domains
-            if (!sorted[i].second->data.size())
+        std::vector<double> buffer;
+        for (auto const& patch_data : input)
+        {
+            if (patch_data.data.size() == 0)
                 continue;
-            auto& data   = sorted[i].second->data;
-            auto& ghosts = sorted[i].second->nGhosts;
-            auto end     = ghosts;
-            // primal nodes share a cell wall when patches touch so drop duplicate value if so
-            if (shared_patch_border)
-                end = i == sorted.size() - 1 ? end : end + 1;
-            ret.insert(std::end(ret), std::begin(data) + ghosts, std::end(data) - end);
+            auto const values = py_array_t<double>::ensure(patch_data.data); // contiguous
+            auto const* lower = patch_data.lower.data();
+            auto const* upper = patch_data.upper.data();
+            buffer.insert(buffer.end(), lower, lower + dimension);
+            buffer.insert(buffer.end(), upper, upper + dimension);
+            buffer.push_back(patch_data.nGhosts);
+            buffer.insert(buffer.end(), values.shape(), values.shape() + dimension);
+            buffer.insert(buffer.end(), values.data(), values.data() + values.size());
         }
-        return ret;
-    }
 
-    auto sync(std::vector<PatchData<std::vector<double>, dimension>> const& input)
-    {
-        int mpi_size = core::mpi::size();
-        std::vector<PatchData<std::vector<double>, dimension>> collected;
-
-        auto reinterpret_array = [&](auto& py_array) {
-            return reinterpret_cast<std::array<std::size_t, dimension>&>(
-                *static_cast<std::size_t*>(py_array.request().ptr));
-        };
-
-        auto collect = [&](PatchData<std::vector<double>, dimension> const& patch_data) {
-            auto patchIDs = core::mpi::collect(patch_data.patchID, mpi_size);
-            auto origins  = core::mpi::collect(patch_data.origin, mpi_size);
-            auto lower    = core::mpi::collect_raw(makeSpan(patch_data.lower), mpi_size);
-            auto upper    = core::mpi::collect_raw(makeSpan(patch_data.upper), mpi_size);
-            auto ghosts   = core::mpi::collect(patch_data.nGhosts, mpi_size);
-            auto datas    = core::mpi::collect(patch_data.data, mpi_size);
-
-            for (int i = 0; i < mpi_size; i++)
+        auto const gathered = core::mpi::gather(buffer, root);
+
+        std::vector<FieldPatchData<dimension>> collected;
+        for (auto it = gathered.vec.begin(); it != gathered.vec.end();)
+        {
+            auto& data = collected.emplace_back();
+            std::array<std::size_t, dimension> lower, upper;
+            std::vector<pybind11::ssize_t> shape(dimension);
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
             {
-                auto& data = collected.emplace_back();
-                setPatchData(data, patchIDs[i], origins[i], lower[i], upper[i]);
-                data.nGhosts = ghosts[i];
-                data.data    = std::move(datas[i]);
+                lower[iDim] = static_cast<std::size_t>(it[iDim]);
+                upper[iDim] = static_cast<std::size_t>(it[dimension + iDim]);
+                shape[iDim] = static_cast<pybind11::ssize_t>(it[2 * dimension + 1 + iDim]);
             }
-        };
+            setPatchData(data, "", "", lower, upper);
+            data.nGhosts = static_cast<std::size_t>(it[2 * dimension]);
+            it += 3 * dimension + 1;
+
+            data.data = pybind11::array_t<double>(shape);
+            auto const size = static_cast<std::size_t>(data.data.size());
+            std::copy(it, it + size, data.data.mutable_data());
+            it += size;
+        }
+        return collected;
+    }
 
-        std::size_t max = core::mpi::max(input.size(), mpi_size);
 
-        PatchData<std::vector<double>, dimension> empty;
+    /** \brief array of the values of a field over a level, assembled from the patch datas of all
+     * processes, see sync(), on all processes, or on root only if root >= 0, other processes
+     * then getting an empty array
+     *
+     * The array covers the bounding box of the patches, without ghosts, the centering of each
+     * direction being found from the shape of the patch datas. Nodes not covered by any patch,
+     * e.g. on refined levels, are NaN. Patches touching on primal nodes share their values.
+     * primal is kept for compatibility, the centering being known from the data.
+     */
+    auto sync_merge(std::vector<FieldPatchData<dimension>> const& input,
+                    [[maybe_unused]] bool primal, int root = -1)
+    {
+        auto const patchDatas = sync(input, root);
+        if (patchDatas.empty())
+            return pybind11::array_t<double>{};
 
-        for (size_t i = 0; i < max; i++)
+        std::array<std::size_t, dimension> lower, upper, nodes, strides;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
         {
-            if (i < input.size())
-                collect(input[i]);
-            else
-                collect(empty);
+            lower[iDim] = patchDatas[0].lower.data()[iDim];
+            upper[iDim] = patchDatas[0].upper.data()[iDim];
+            for (auto const& patchData : patchDatas)
+            {
+                lower[iDim] = std::min(lower[iDim], patchData.lower.data()[iDim]);
+                upper[iDim] = std::max(upper[iDim], patchData.upper.data()[iDim]);
+            }
         }
-        return collected;
-    }
 
-    auto sync_merge(std::vector<PatchData<std::vector<double>, dimension>> const& input,
-                    [[maybe_unused]] bool primal)
-    {
-        if constexpr (dimension == 1)
-            return sort_merge_1d(sync(input), primal);
+        auto const& first = patchDatas[0];
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            auto const cells = first.upper.data()[iDim] - first.lower.data()[iDim] + 1;
+            auto const isPrimal
+                = static_cast<std::size_t>(first.data.shape(iDim)) > cells + 2 * first.nGhosts;
+            nodes[iDim] = upper[iDim] - lower[iDim] + 1 + (isPrimal ? 1 : 0);
+        }
+        strides[dimension - 1] = 1;
+        for (int iDim = static_cast<int>(dimension) - 2; iDim >= 0; --iDim)
+            strides[iDim] = strides[iDim + 1] * nodes[iDim + 1];
+
+        pybind11::array_t<double> merged(std::vector<std::size_t>(nodes.begin(), nodes.end()));
+        auto* values = merged.mutable_data();
+        std::fill(values, values + merged.size(), std::numeric_limits<double>::quiet_NaN());
+
+        for (auto const& patchData : patchDatas)
+        {
+            // physical nodes of the patch, in the patch data and in the merged array
+            std::array<std::size_t, dimension> patchNodes, patchStrides, offset;
+            std::size_t patchStride = 1, nbrNodes = 1;
+            for (int iDim = static_cast<int>(dimension) - 1; iDim >= 0; --iDim)
+            {
+                auto const shape   = static_cast<std::size_t>(patchData.data.shape(iDim));
+                patchNodes[iDim]   = shape - 2 * patchData.nGhosts;
+                patchStrides[iDim] = patchStride;
+                offset[iDim]       = patchData.lower.data()[iDim] - lower[iDim];
+                patchStride *= shape;
+                nbrNodes *= patchNodes[iDim];
+            }
 
-        throw std::runtime_error("Not handled for >1 dim");
+            auto const* patchValues = patchData.data.data();
+            for (std::size_t iNode = 0; iNode < nbrNodes; ++iNode)
+            {
+                std::size_t from = 0, to = 0, rest = iNode;
+                for (int iDim = static_cast<int>(dimension) - 1; iDim >= 0; --iDim)
+                {
+                    auto const index = rest % patchNodes[iDim];
+                    rest /= patchNodes[iDim];
+                    from += (index + patchData.nGhosts) * patchStrides[iDim];
+                    to += (index + offset[iDim]) * strides[iDim];
+                }
+                values[to] = patchValues[from];
+            }
+        }
+        return merged;
     }
 
 private:
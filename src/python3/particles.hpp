@@ -1,9 +1,14 @@
 #ifndef PHARE_PYTHON_PARTICLES_HPP
 #define PHARE_PYTHON_PARTICLES_HPP
 
+#include <vector>
 #include <cassert>
 #include <cstddef>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
 #include <tuple>
+#include <cstdint>
 #include "amr/data/particles/refine/particles_data_split.hpp"
 #include "core/data/particles/particle_packer.hpp"
 #include "core/data/particles/particle.hpp"
@@ -13,24 +18,31 @@
 
 namespace PHARE::pydata
 {
+// python particles have no id, ids are given in a separate array
 template<std::size_t dim, typename PyArrayTuple>
-core::ContiguousParticlesView<dim> contiguousViewFrom(PyArrayTuple const& py_particles)
+core::ContiguousParticlesView<dim> contiguousViewFrom(PyArrayTuple const& py_particles,
+                                                      std::vector<std::uint64_t>& ids)
 {
-    return {makeSpan<int>(std::get<0>(py_particles)),     // iCell
-            makeSpan<double>(std::get<1>(py_particles)),  // delta
-            makeSpan<double>(std::get<2>(py_particles)),  // weight
-            makeSpan<double>(std::get<3>(py_particles)),  // charge
-            makeSpan<double>(std::get<4>(py_particles))}; // v
+    using float_type = core::particle_float_t;
+
+    return {makeSpan<int>(std::get<0>(py_particles)),        // iCell
+            makeSpan<float_type>(std::get<1>(py_particles)), // delta
+            makeSpan<double>(std::get<2>(py_particles)),     // weight
+            makeSpan<double>(std::get<3>(py_particles)),     // charge
+            makeSpan<float_type>(std::get<4>(py_particles)), // v
+            core::Span<std::uint64_t>{ids.data(), ids.size()}};
 }
 
 template<std::size_t dim>
 pyarray_particles_t makePyArrayTuple(std::size_t const size)
 {
-    return std::make_tuple(py_array_t<int>(size * dim),    // iCell
-                           py_array_t<double>(size * dim), // delta
-                           py_array_t<double>(size),       // weight
-                           py_array_t<double>(size),       // charge
-                           py_array_t<double>(size * 3));  // v
+    using float_type = core::particle_float_t;
+
+    return std::make_tuple(py_array_t<int>(size * dim),        // iCell
+                           py_array_t<float_type>(size * dim), // delta
+                           py_array_t<double>(size),           // weight
+                           py_array_t<double>(size),           // charge
+                           py_array_t<float_type>(size * 3));  // v
 }
 
 
@@ -67,9 +79,12 @@ pyarray_particles_t splitPyArrayParticles(pyarray_particles_crt const& py_partic
 
     PHARE_DEBUG_DO(assertParticlePyArraySizes<dim>(py_particles));
 
-    auto particlesInView  = contiguousViewFrom<dim>(py_particles);
+    std::vector<std::uint64_t> idsIn(std::get<2>(py_particles).size());
+    std::vector<std::uint64_t> idsOut(idsIn.size() * nbRefinedPart);
+
+    auto particlesInView  = contiguousViewFrom<dim>(py_particles, idsIn);
     auto particlesOut     = makePyArrayTuple<dim>(particlesInView.size() * nbRefinedPart);
-    auto particlesOutView = contiguousViewFrom<dim>(particlesOut);
+    auto particlesOutView = contiguousViewFrom<dim>(particlesOut, idsOut);
 
     Splitter splitter;
 
@@ -80,6 +95,83 @@ pyarray_particles_t splitPyArrayParticles(pyarray_particles_crt const& py_partic
     return particlesOut;
 }
 
+
+
+/** \brief numpy arrays of the particles of a ParticleArray, one per attribute, in a dict of
+ * keys weight, charge, iCell, delta, v and id
+ *
+ * If a box is given, only the particles of its cells are selected, from the cell map of the
+ * array. One particle every stride selected particles is kept. The arrays are allocated once
+ * for the number of kept particles and filled from the particles, iCell and delta of shape
+ * (size, dim) and v of shape (size, 3).
+ */
+template<typename ParticleArray>
+pybind11::dict
+particleArrays(ParticleArray const& particles,
+               std::optional<core::Box<int, ParticleArray::dimension>> const& box,
+               std::size_t stride = 1)
+{
+    constexpr auto dim = ParticleArray::dimension;
+    using float_type   = core::particle_float_t;
+    using Shape        = std::vector<pybind11::ssize_t>;
+
+    if (stride == 0)
+        throw std::runtime_error("particleArrays: stride must be positive");
+
+    auto const selection = box ? *box * particles.box() : std::nullopt;
+    std::size_t const nbrSelected
+        = box ? (selection ? particles.nbr_particles_in(*selection) : 0) : particles.size();
+    auto const size = static_cast<pybind11::ssize_t>((nbrSelected + stride - 1) / stride);
+
+    py_array_t<double> weight(size);
+    py_array_t<double> charge(size);
+    py_array_t<int> iCell(Shape{size, dim});
+    py_array_t<float_type> delta(Shape{size, dim});
+    py_array_t<float_type> v(Shape{size, 3});
+    py_array_t<std::uint64_t> id(size);
+
+    auto* weights = weight.mutable_data();
+    auto* charges = charge.mutable_data();
+    auto* iCells  = iCell.mutable_data();
+    auto* deltas  = delta.mutable_data();
+    auto* vs      = v.mutable_data();
+    auto* ids     = id.mutable_data();
+
+    std::size_t iSelected = 0, iKept = 0;
+    auto keep = [&](auto const& particle) {
+        if (iSelected++ % stride != 0)
+            return;
+        weights[iKept] = particle.weight;
+        charges[iKept] = particle.charge;
+        std::copy(particle.iCell.begin(), particle.iCell.end(), iCells + iKept * dim);
+        std::copy(particle.delta.begin(), particle.delta.end(), deltas + iKept * dim);
+        std::copy(particle.v.begin(), particle.v.end(), vs + iKept * 3);
+        ids[iKept] = particle.id;
+        ++iKept;
+    };
+
+    if (selection)
+    {
+        for (auto const& cell : *selection)
+            for (auto const index : particles.indexes_in(cell))
+                keep(particles[index]);
+    }
+    else if (!box)
+    {
+        for (auto const& particle : particles)
+            keep(particle);
+    }
+
+    pybind11::dict arrays;
+    arrays["weight"] = weight;
+    arrays["charge"] = charge;
+    arrays["iCell"]  = iCell;
+    arrays["delta"]  = delta;
+    arrays["v"]      = v;
+    arrays["id"]     = id;
+    return arrays;
+}
+
 } // namespace PHARE::pydata
 
 #endif /*PHARE_PYTHON_PARTICLES_H*/
@@ -3,8 +3,10 @@
 
 #include <array>
 #include <string>
+#include <vector>
 #include <cstring>
 #include <utility>
+#include <algorithm>
 
 #include "pybind_def.hpp"
 
@@ -50,14 +52,52 @@ void setPatchDataFromGrid(PatchData& pdata, GridLayout& grid, std::string patchI
                  grid.AMRBox().upper.template toArray<std::size_t>());
 }
 
-template<typename PatchData, typename Field, typename GridLayout>
+
+// patch data of a field, whose data is a numpy array of the shape of the field, ghosts included
+template<std::size_t dim>
+using FieldPatchData = PatchData<pybind11::array_t<double>, dim>;
+
+
+/** \brief numpy array of the values of a field
+ *
+ * Unless copy is true, the array is a read only view of the memory of the field, without
+ * copy, strided over the padding of the field if any. The owner, e.g. the patch holding the
+ * field, is then kept alive by the array, which shows the values the field has when read.
+ */
+template<typename Field, typename Owner>
+pybind11::array_t<double> fieldArray(Field const& field, Owner const& owner, bool copy)
+{
+    auto const& fieldShape = field.shape();
+    std::vector<pybind11::ssize_t> shape(fieldShape.begin(), fieldShape.end());
+
+    if (copy)
+    {
+        pybind11::array_t<double> array(shape);
+        auto const contiguous = core::contiguous(field);
+        std::copy(contiguous.begin(), contiguous.end(), array.mutable_data());
+        return array;
+    }
+
+    std::vector<pybind11::ssize_t> strides;
+    for (auto const stride : field.strides())
+        strides.push_back(static_cast<pybind11::ssize_t>(stride * sizeof(double)));
+
+    pybind11::capsule keepAlive{new Owner{owner},
+                                [](void* ptr) { delete static_cast<Owner*>(ptr); }};
+    pybind11::array_t<double> array(shape, strides, field.data(), keepAlive);
+    array.attr("setflags")(pybind11::arg("write") = false);
+    return array;
+}
+
+
+template<typename PatchData, typename Field, typename GridLayout, typename Owner>
 void setPatchDataFromField(PatchData& pdata, Field const& field, GridLayout& grid,
-                           std::string patchID)
+                           std::string patchID, Owner const& owner, bool copy)
 {
     setPatchDataFromGrid(pdata, grid, patchID);
     pdata.nGhosts = static_cast<std::size_t>(
         GridLayout::nbrGhosts(GridLayout::centering(field.physicalQuantity())[0]));
-    pdata.data.assign(field.data(), field.data() + field.size());
+    pdata.data = fieldArray(field, owner, copy);
 }
 
 
@@ -6,7 +6,11 @@
 #include <cstddef>
 #include <string>
 #include <utility>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
 #include "phare_solver.hpp"
+#include "python3/particles.hpp"
 
 
 namespace PHARE::pydata
@@ -24,6 +28,9 @@ public:
 
     using GridLayout = typename HybridModel::gridlayout_type;
 
+    // cells (lower, upper) of a particle selection, in AMR indexes
+    using CellBox = std::optional<std::array<std::array<int, dimension>, 2>>;
+
     PatchLevel(amr::Hierarchy& hierarchy, HybridModel& model, std::size_t lvl)
         : lvl_(lvl)
         , hierarchy_{hierarchy}
@@ -31,48 +38,47 @@ public:
     {
     }
 
-    auto getDensity()
+    auto getDensity(bool copy = false)
     {
-        std::vector<PatchData<std::vector<double>, dimension>> patchDatas;
+        std::vector<FieldPatchData<dimension>> patchDatas;
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
-            setPatchDataFromField(patchDatas.emplace_back(), ions.density(), grid, patchID);
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
+            setPatchDataFromField(patchDatas.emplace_back(), ions.density(), grid, patchID, patch,
+                                  copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return patchDatas;
     }
 
-    auto getPopDensities()
+    auto getPopDensities(bool copy = false)
     {
         using Inner = decltype(getDensity());
 
         std::unordered_map<std::string, Inner> pop_data;
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             for (auto const& pop : ions)
             {
                 if (!pop_data.count(pop.name()))
                     pop_data.emplace(pop.name(), Inner());
 
                 setPatchDataFromField(pop_data.at(pop.name()).emplace_back(), pop.density(), grid,
-                                      patchID);
+                                      patchID, patch, copy);
             }
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return pop_data;
     }
 
-    template<typename VecField, typename Map>
+    template<typename VecField, typename Map, typename Patch>
     auto getVecFields(VecField& vecField, Map& container, GridLayout& grid, std::string patchID,
-                      std::string outer_key)
+                      std::string outer_key, Patch const& patch, bool copy)
     {
         if (!container.count(outer_key))
             container.emplace(outer_key, typename Map::mapped_type());
@@ -86,17 +92,18 @@ public:
             if (!inner.count(field.name()))
                 inner.emplace(field.name(), decltype(getDensity())());
 
-            setPatchDataFromField(inner.at(field.name()).emplace_back(), field, grid, patchID);
+            setPatchDataFromField(inner.at(field.name()).emplace_back(), field, grid, patchID,
+                                  patch, copy);
         }
     }
 
-    auto getBulkVelocity()
+    auto getBulkVelocity(bool copy = false)
     {
         decltype(getPopDensities()) bulkV;
 
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             for (auto& [id, type] : core::Components::componentMap)
             {
                 auto& field = ions.velocity().getComponent(type);
@@ -104,17 +111,17 @@ public:
                 if (!bulkV.count(field.name()))
                     bulkV.emplace(field.name(), decltype(getDensity())());
 
-                setPatchDataFromField(bulkV.at(field.name()).emplace_back(), field, grid, patchID);
+                setPatchDataFromField(bulkV.at(field.name()).emplace_back(), field, grid, patchID,
+                                      patch, copy);
             }
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return bulkV;
     }
 
-    auto getPopFlux()
+    auto getPopFlux(bool copy = false)
     {
         using Inner = decltype(getPopDensities());
 
@@ -122,18 +129,17 @@ public:
 
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             for (auto const& pop : ions)
-                getVecFields(pop.flux(), pop_data, grid, patchID, pop.name());
+                getVecFields(pop.flux(), pop_data, grid, patchID, pop.name(), patch, copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return pop_data;
     }
 
-    auto getEM()
+    auto getEM(bool copy = false)
     {
         using Inner = decltype(getPopDensities());
 
@@ -141,92 +147,91 @@ public:
 
         auto& em = model_.state.electromag;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             for (auto& vecFieldPtr : {&em.B, &em.E})
             {
-                getVecFields(*vecFieldPtr, em_data, grid, patchID, vecFieldPtr->name());
+                getVecFields(*vecFieldPtr, em_data, grid, patchID, vecFieldPtr->name(), patch,
+                             copy);
             }
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, em);
+        visitLevel_(visit, em);
 
         return em_data;
     }
 
 
-    auto getB(std::string componentName)
+    auto getB(std::string componentName, bool copy = false)
     {
-        std::vector<PatchData<std::vector<double>, dimension>> patchDatas;
+        std::vector<FieldPatchData<dimension>> patchDatas;
 
         auto& B = model_.state.electromag.B;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             auto compo = PHARE::core::Components::componentMap.at(componentName);
-            setPatchDataFromField(patchDatas.emplace_back(), B.getComponent(compo), grid, patchID);
+            setPatchDataFromField(patchDatas.emplace_back(), B.getComponent(compo), grid,
+                                  patchID, patch, copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, B);
+        visitLevel_(visit, B);
 
         return patchDatas;
     }
 
 
-    auto getE(std::string componentName)
+    auto getE(std::string componentName, bool copy = false)
     {
-        std::vector<PatchData<std::vector<double>, dimension>> patchDatas;
+        std::vector<FieldPatchData<dimension>> patchDatas;
 
         auto& E = model_.state.electromag.E;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             auto compo = PHARE::core::Components::componentMap.at(componentName);
-            setPatchDataFromField(patchDatas.emplace_back(), E.getComponent(compo), grid, patchID);
+            setPatchDataFromField(patchDatas.emplace_back(), E.getComponent(compo), grid,
+                                  patchID, patch, copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, E);
+        visitLevel_(visit, E);
 
         return patchDatas;
     }
 
 
 
-    auto getVi(std::string componentName)
+    auto getVi(std::string componentName, bool copy = false)
     {
-        std::vector<PatchData<std::vector<double>, dimension>> patchDatas;
+        std::vector<FieldPatchData<dimension>> patchDatas;
 
         auto& V = model_.state.ions.velocity();
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             auto compo = PHARE::core::Components::componentMap.at(componentName);
-            setPatchDataFromField(patchDatas.emplace_back(), V.getComponent(compo), grid, patchID);
+            setPatchDataFromField(patchDatas.emplace_back(), V.getComponent(compo), grid,
+                                  patchID, patch, copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, V);
+        visitLevel_(visit, V);
 
         return patchDatas;
     }
 
 
 
-    auto getPopFluxCompo(std::string component, std::string popName)
+    auto getPopFluxCompo(std::string component, std::string popName, bool copy = false)
     {
-        std::vector<PatchData<std::vector<double>, dimension>> patchDatas;
+        std::vector<FieldPatchData<dimension>> patchDatas;
 
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& patch) {
             auto compo = PHARE::core::Components::componentMap.at(component);
             for (auto const& pop : ions)
                 if (pop.name() == popName)
                     setPatchDataFromField(patchDatas.emplace_back(), pop.flux().getComponent(compo),
-                                          grid, patchID);
+                                          grid, patchID, patch, copy);
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return patchDatas;
     }
@@ -234,21 +239,21 @@ public:
 
 
 
-    auto getEx() { return getE("x"); }
-    auto getEy() { return getE("y"); }
-    auto getEz() { return getE("z"); }
+    auto getEx(bool copy = false) { return getE("x", copy); }
+    auto getEy(bool copy = false) { return getE("y", copy); }
+    auto getEz(bool copy = false) { return getE("z", copy); }
 
-    auto getBx() { return getB("x"); }
-    auto getBy() { return getB("y"); }
-    auto getBz() { return getB("z"); }
+    auto getBx(bool copy = false) { return getB("x", copy); }
+    auto getBy(bool copy = false) { return getB("y", copy); }
+    auto getBz(bool copy = false) { return getB("z", copy); }
 
-    auto getVix() { return getVi("x"); }
-    auto getViy() { return getVi("y"); }
-    auto getViz() { return getVi("z"); }
+    auto getVix(bool copy = false) { return getVi("x", copy); }
+    auto getViy(bool copy = false) { return getVi("y", copy); }
+    auto getViz(bool copy = false) { return getVi("z", copy); }
 
-    auto getFx(std::string pop) { return getPopFluxCompo("x", pop); }
-    auto getFy(std::string pop) { return getPopFluxCompo("y", pop); }
-    auto getFz(std::string pop) { return getPopFluxCompo("z", pop); }
+    auto getFx(std::string pop, bool copy = false) { return getPopFluxCompo("x", pop, copy); }
+    auto getFy(std::string pop, bool copy = false) { return getPopFluxCompo("y", pop, copy); }
+    auto getFz(std::string pop, bool copy = false) { return getPopFluxCompo("z", pop, copy); }
 
 
 
@@ -275,7 +280,7 @@ public:
 
         auto& ions = model_.state.ions;
 
-        auto visit = [&](GridLayout& grid, std::string patchID, std::size_t /*iLevel*/) {
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& /*patch*/) {
             for (auto& pop : ions)
             {
                 if ((userPopName != "" and userPopName == pop.name()) or userPopName == "all")
@@ -292,13 +297,70 @@ public:
             }
         };
 
-        PHARE::amr::visitLevel<GridLayout>(*hierarchy_.getPatchLevel(lvl_),
-                                           *model_.resourcesManager, visit, ions);
+        visitLevel_(visit, ions);
 
         return pop_particles;
     }
 
+
+    // the particles of the given kind ("domain", "patchGhost" or "levelGhost") of a population,
+    // for each patch of the level, as numpy arrays filled from the particle arrays of the patch
+    // (see particleArrays), e.g. for analysis during the simulation
+    auto getParticles(std::string popName, std::string kind, CellBox box, std::size_t stride)
+    {
+        std::vector<PatchData<pybind11::dict, dimension>> patchDatas;
+        std::optional<core::Box<int, dimension>> selection;
+        if (box)
+            selection = core::Box<int, dimension>{(*box)[0], (*box)[1]};
+
+        auto& ions = model_.state.ions;
+        if (std::none_of(ions.begin(), ions.end(),
+                         [&](auto const& pop) { return pop.name() == popName; }))
+            throw std::runtime_error("getParticles: no population " + popName);
+
+        auto visit = [&](GridLayout& grid, std::string patchID, auto const& /*patch*/) {
+            for (auto& pop : ions)
+                if (pop.name() == popName)
+                {
+                    auto& patch_data = patchDatas.emplace_back();
+                    setPatchDataFromGrid(patch_data, grid, patchID);
+                    patch_data.data = particleArrays(particlesOf_(pop, kind), selection, stride);
+                }
+        };
+
+        visitLevel_(visit, ions);
+
+        return patchDatas;
+    }
+
 private:
+    template<typename Population>
+    static auto& particlesOf_(Population& pop, std::string const& kind)
+    {
+        if (kind == "domain")
+            return pop.domainParticles();
+        if (kind == "patchGhost")
+            return pop.patchGhostParticles();
+        if (kind == "levelGhost")
+            return pop.levelGhostParticles();
+        throw std::runtime_error("getParticles: invalid kind " + kind
+                                 + ", valid are domain, patchGhost, levelGhost");
+    }
+
+
+    // as amr::visitLevel, the action also getting the patch, which keeps the views of its fields
+    template<typename Action, typename... Args>
+    void visitLevel_(Action&& action, Args&&... args)
+    {
+        for (auto& patch : *hierarchy_.getPatchLevel(lvl_))
+        {
+            auto guard        = model_.resourcesManager->setOnPatch(*patch, args...);
+            GridLayout layout = amr::layoutFromPatch<GridLayout>(*patch);
+            action(layout, amr::to_string(patch->getGlobalId()), patch);
+        }
+    }
+
+
     std::size_t lvl_;
     amr::Hierarchy& hierarchy_;
     HybridModel& model_;
@@ -7,6 +7,7 @@
 #include <stdexcept>
 
 #include "core/utilities/span.hpp"
+#include "core/data/particles/particle.hpp"
 
 #include "pybind11/stl.h"
 #include "pybind11/numpy.h"
@@ -17,12 +18,14 @@ template<typename T>
 using py_array_t = pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>;
 
 
-using pyarray_particles_t = std::tuple<py_array_t<int32_t>, py_array_t<double>, py_array_t<double>,
-                                       py_array_t<double>, py_array_t<double>>;
+using pyarray_particles_t
+    = std::tuple<py_array_t<int32_t>, py_array_t<core::particle_float_t>, py_array_t<double>,
+                 py_array_t<double>, py_array_t<core::particle_float_t>>;
 
 using pyarray_particles_crt
-    = std::tuple<py_array_t<int32_t> const&, py_array_t<double> const&, py_array_t<double> const&,
-                 py_array_t<double> const&, py_array_t<double> const&>;
+    = std::tuple<py_array_t<int32_t> const&, py_array_t<core::particle_float_t> const&,
+                 py_array_t<double> const&, py_array_t<double> const&,
+                 py_array_t<core::particle_float_t> const&>;
 
 template<typename PyArrayInfo>
 std::size_t ndSize(PyArrayInfo const& ar_info)
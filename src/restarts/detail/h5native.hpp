@@ -0,0 +1,555 @@
+#ifndef PHARE_DETAIL_RESTART_NATIVE_HPP
+#define PHARE_DETAIL_RESTART_NATIVE_HPP
+
+#include "core/logger.hpp"
+#include "core/utilities/types.hpp"
+#include "core/utilities/box/box.hpp"
+#include "core/utilities/mpi_utils.hpp"
+#include "core/data/particles/particle.hpp"
+#include "core/data/particles/particle_packer.hpp"
+
+#include "restarts/restarts_props.hpp"
+
+#include "hdf5/detail/h5/h5_file.hpp"
+#include "hdf5/writer/particle_writer.hpp"
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <vector>
+#include <unordered_map>
+
+namespace PHARE::restarts::h5
+{
+/*
+ * PHARE native restart file, a single HDF5 file per restart time written by all MPI processes
+ *
+ * /phare                      attributes serialized_simulation, format, time
+ * /pl#/lower, /pl#/upper      (nbrPatches, dimension) AMR boxes of the patches of level #
+ * /pl#/EM_(B,E)_(x,y,z)       component values of all patches, ghosts included, patch after
+ *                             patch, with /pl#/<component>_offset (nbrPatches) the first value
+ *                             and /pl#/<component>_shape (nbrPatches, dimension) the shape of
+ *                             each patch
+ * /pl#/ions/pop/<name>/(weight, charge, iCell, delta, v)
+ *                             domain particles of all patches, patch after patch, with
+ *                             offset and count (nbrPatches) the particles of each patch
+ *
+ * Patches are ordered by MPI rank, then in the order each rank visits them. The position of
+ * each rank in the datasets is given by a single exchange of sizes.
+ * A restart reads the patches of the file overlapping its own, whatever the number of MPI
+ * processes, or the patches, that wrote the file.
+ */
+struct NativeRestart
+{
+    static constexpr auto format = "phareh5";
+
+    static auto filePath(std::string const& directory) { return directory + "/restart.h5"; }
+
+    static auto levelPath(std::size_t iLevel) { return "/pl" + std::to_string(iLevel); }
+
+    static auto popPath(std::size_t iLevel, std::string const& popName)
+    {
+        return levelPath(iLevel) + "/ions/pop/" + popName + "/";
+    }
+
+    template<typename Electromag>
+    static auto fieldNames(Electromag const& electromag)
+    {
+        std::vector<std::string> names;
+        for (auto const* vecField : {&electromag.B, &electromag.E})
+            for (auto const component : {core::Component::X, core::Component::Y,
+                                         core::Component::Z})
+                names.emplace_back(vecField->getComponentName(component));
+        return names;
+    }
+
+    // in the order of fieldNames, the electromagnetic field must be set on a patch
+    template<typename Electromag>
+    static auto fields(Electromag& electromag)
+    {
+        using Field = std::decay_t<decltype(electromag.B[0])>;
+        std::vector<Field*> fields;
+        for (auto* vecField : {&electromag.B, &electromag.E})
+            for (std::size_t iComponent = 0; iComponent < 3; ++iComponent)
+                fields.push_back(&(*vecField)[iComponent]);
+        return fields;
+    }
+};
+
+
+
+template<typename ModelView>
+class NativeWriter
+{
+    static constexpr auto dimension = ModelView::dimension;
+    using GridLayout                = typename ModelView::GridLayout;
+    using Packer                    = core::ParticlePacker<dimension>;
+    using Sizes                     = std::vector<std::size_t>;
+
+public:
+    NativeWriter(ModelView& modelView)
+        : modelView_{modelView}
+    {
+    }
+
+    void dump(std::string const& directory, RestartsProperties const& properties,
+              double timestamp)
+    {
+        write_(directory, properties, timestamp, /*staged=*/false);
+    }
+
+    /* the file and its datasets are created as by dump, but the data to write is copied, the
+     * copy being the snapshot of the restart. The returned function does the writes and closes
+     * the file, so that the simulation can advance meanwhile.
+     */
+    std::function<void()> stage(std::string const& directory,
+                                RestartsProperties const& properties, double timestamp)
+    {
+        std::shared_ptr<hdf5::h5::HighFiveFile> file
+            = write_(directory, properties, timestamp, /*staged=*/true);
+        return [writes = file->close_write_stage(), file]() mutable {
+            PHARE_LOG_SCOPE("NativeWriter::stagedWrites");
+            for (auto const& write : writes)
+                write();
+            file.reset();
+        };
+    }
+
+private:
+    std::unique_ptr<hdf5::h5::HighFiveFile> write_(std::string const& directory,
+                                                   RestartsProperties const& properties,
+                                                   double timestamp, bool staged);
+
+    ModelView& modelView_;
+};
+
+
+
+template<typename ModelView>
+std::unique_ptr<hdf5::h5::HighFiveFile>
+NativeWriter<ModelView>::write_(std::string const& directory, RestartsProperties const& properties,
+                                double timestamp, bool staged)
+{
+    PHARE_LOG_SCOPE("NativeWriter::write_");
+
+    struct Level
+    {
+        std::size_t nbrPatches = 0;
+        std::vector<int> lower, upper;
+        std::vector<std::vector<double>> data; // per field
+        std::vector<Sizes> offsets, shapes;    // per field
+        std::vector<Sizes> nbrParticles;       // per population
+    };
+
+    auto& electromag    = modelView_.getElectromag();
+    auto& ions          = modelView_.getIons();
+    auto const names    = NativeRestart::fieldNames(electromag);
+    auto const nbrPops  = ions.nbrPopulations();
+    auto const nbrLevel = static_cast<std::size_t>(modelView_.nbrLevels());
+
+    std::vector<Level> levels(nbrLevel);
+    for (auto& level : levels)
+    {
+        level.data.resize(names.size());
+        level.offsets.resize(names.size());
+        level.shapes.resize(names.size());
+        level.nbrParticles.resize(nbrPops);
+    }
+
+    modelView_.visitHierarchy([&](GridLayout& layout, std::string, std::size_t iLevel) {
+        auto& level = levels[iLevel];
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            level.lower.push_back(layout.AMRBox().lower[iDim]);
+            level.upper.push_back(layout.AMRBox().upper[iDim]);
+        }
+
+        auto const fields = NativeRestart::fields(electromag);
+        for (std::size_t iField = 0; iField < fields.size(); ++iField)
+        {
+            auto const& field = *fields[iField];
+            auto& data        = level.data[iField];
+            level.offsets[iField].push_back(data.size());
+            auto const contiguous = core::contiguous(field);
+            data.insert(data.end(), contiguous.begin(), contiguous.end());
+            for (auto const n : field.shape())
+                level.shapes[iField].push_back(n);
+        }
+
+        std::size_t iPop = 0;
+        for (auto const& pop : ions)
+            level.nbrParticles[iPop++].push_back(pop.domainParticles().size());
+
+        ++level.nbrPatches;
+    });
+
+    // per level, the number of patches, the size of each field then of each population
+    Sizes localSizes;
+    for (auto const& level : levels)
+    {
+        localSizes.push_back(level.nbrPatches);
+        for (auto const& data : level.data)
+            localSizes.push_back(data.size());
+        for (auto const& nbrParticles : level.nbrParticles)
+            localSizes.push_back(core::sum(nbrParticles, std::size_t{0}));
+    }
+
+    auto const perRank = core::mpi::collect(localSizes);
+    auto const rank    = static_cast<std::size_t>(core::mpi::rank());
+    Sizes start(localSizes.size(), 0), total(localSizes.size(), 0);
+    for (std::size_t iRank = 0; iRank < perRank.size(); ++iRank)
+        for (std::size_t entry = 0; entry < localSizes.size(); ++entry)
+        {
+            if (iRank < rank)
+                start[entry] += perRank[iRank][entry];
+            total[entry] += perRank[iRank][entry];
+        }
+    auto const entriesPerLevel = 1 + names.size() + nbrPops;
+
+
+    modelView_.makeDirectory(directory);
+    core::mpi::barrier();
+
+    using HiFile = hdf5::h5::HiFile;
+    auto file    = std::make_unique<hdf5::h5::HighFiveFile>(
+        NativeRestart::filePath(directory), HiFile::ReadWrite | HiFile::Create | HiFile::Truncate);
+    auto& h5File = *file;
+
+    // all processes create all datasets and attributes, with the totals known to each
+    h5File.file().createGroup("/phare");
+    h5File.write_attribute("/phare", "serialized_simulation",
+                           properties.fileAttributes["serialized_simulation"]
+                               .template to<std::string>());
+    h5File.write_attribute("/phare", "format", std::string{NativeRestart::format});
+    h5File.write_attribute("/phare", "time", timestamp);
+
+    for (std::size_t iLevel = 0; iLevel < nbrLevel; ++iLevel)
+    {
+        auto const entry      = iLevel * entriesPerLevel;
+        auto const nbrPatches = total[entry];
+        auto const path       = NativeRestart::levelPath(iLevel) + "/";
+
+        h5File.create_data_set<int>(path + "lower", Sizes{nbrPatches, dimension});
+        h5File.create_data_set<int>(path + "upper", Sizes{nbrPatches, dimension});
+        for (std::size_t iField = 0; iField < names.size(); ++iField)
+        {
+            auto const& name = names[iField];
+            h5File.create_data_set<double>(path + name, total[entry + 1 + iField]);
+            h5File.create_data_set<std::size_t>(path + name + "_offset", nbrPatches);
+            h5File.create_data_set<std::size_t>(path + name + "_shape",
+                                                         Sizes{nbrPatches, dimension});
+        }
+
+        std::size_t iPop = 0;
+        for (auto const& pop : ions)
+        {
+            auto const popPath      = NativeRestart::popPath(iLevel, pop.name());
+            auto const nbrParticles = total[entry + 1 + names.size() + iPop++];
+            std::size_t part_idx    = 0;
+            core::apply(Packer::empty(), [&](auto const& arg) {
+                using ValueType = std::decay_t<decltype(arg)>;
+                auto const key  = popPath + Packer::keys()[part_idx++];
+                auto shape      = hdf5::ParticleWriter::size_for<dimension>(arg, nbrParticles);
+                if constexpr (hdf5::is_array_dataset<ValueType, dimension>)
+                    h5File.create_data_set<typename ValueType::value_type>(key, shape);
+                else
+                    h5File.create_data_set<ValueType>(key, shape);
+            });
+            h5File.create_data_set<std::size_t>(popPath + "offset", nbrPatches);
+            h5File.create_data_set<std::size_t>(popPath + "count", nbrPatches);
+        }
+    }
+
+    // each process writes its patches
+    if (staged)
+        h5File.open_write_stage();
+
+    std::vector<std::vector<std::size_t>> particleOffsets(nbrLevel);
+    for (std::size_t iLevel = 0; iLevel < nbrLevel; ++iLevel)
+    {
+        auto const& level = levels[iLevel];
+        auto const entry  = iLevel * entriesPerLevel;
+        auto const path   = NativeRestart::levelPath(iLevel) + "/";
+        if (level.nbrPatches == 0)
+            continue;
+
+        Sizes const patchOffset{start[entry], 0}, patchCount{level.nbrPatches, dimension};
+        h5File.write_data_set_flat_selection<2>(path + "lower", patchOffset,
+                                                         patchCount, level.lower.data());
+        h5File.write_data_set_flat_selection<2>(path + "upper", patchOffset,
+                                                         patchCount, level.upper.data());
+
+        for (std::size_t iField = 0; iField < names.size(); ++iField)
+        {
+            auto const& name = names[iField];
+            auto const& data = level.data[iField];
+            auto const first = start[entry + 1 + iField];
+
+            Sizes offsets = level.offsets[iField];
+            for (auto& offset : offsets)
+                offset += first;
+
+            h5File.write_data_set_flat_selection(path + name, {first}, {data.size()},
+                                                 data.data());
+            h5File.write_data_set_flat_selection(path + name + "_offset", {start[entry]},
+                                                 {level.nbrPatches}, offsets.data());
+            h5File.write_data_set_flat_selection<2>(path + name + "_shape",
+                                                             patchOffset, patchCount,
+                                                             level.shapes[iField].data());
+        }
+
+        std::size_t iPop = 0;
+        for (auto const& pop : ions)
+        {
+            auto const& counts = level.nbrParticles[iPop];
+            Sizes offsets(counts.size());
+            auto offset = start[entry + 1 + names.size() + iPop++];
+            for (std::size_t iPatch = 0; iPatch < counts.size(); ++iPatch)
+            {
+                offsets[iPatch] = offset;
+                offset += counts[iPatch];
+            }
+            auto const popPath = NativeRestart::popPath(iLevel, pop.name());
+            h5File.write_data_set_flat_selection(popPath + "offset", {start[entry]},
+                                                 {level.nbrPatches}, offsets.data());
+            h5File.write_data_set_flat_selection(popPath + "count", {start[entry]},
+                                                 {level.nbrPatches}, counts.data());
+            particleOffsets[iLevel].insert(particleOffsets[iLevel].end(), offsets.begin(),
+                                           offsets.end());
+        }
+    }
+
+    // particles are written from the particle arrays, patches are visited in the same order
+    std::vector<std::size_t> iPatches(nbrLevel, 0);
+    modelView_.visitHierarchy([&](GridLayout&, std::string, std::size_t iLevel) {
+        auto const& level = levels[iLevel];
+        auto const iPatch = iPatches[iLevel]++;
+        std::size_t iPop  = 0;
+        for (auto const& pop : ions)
+        {
+            auto const offset = particleOffsets[iLevel][iPop++ * level.nbrPatches + iPatch];
+            hdf5::ParticleWriter::write_at(h5File, pop.domainParticles(),
+                                           NativeRestart::popPath(iLevel, pop.name()), offset);
+        }
+    });
+
+    return file;
+}
+
+
+
+
+template<typename ModelView>
+class NativeReader
+{
+    static constexpr auto dimension = ModelView::dimension;
+    using GridLayout                = typename ModelView::GridLayout;
+    using level_t                   = typename ModelView::level_t;
+    using Box_t                     = core::Box<int, dimension>;
+    using Sizes                     = std::vector<std::size_t>;
+
+public:
+    template<typename Hierarchy, typename Model>
+    NativeReader(Hierarchy& hierarchy, Model& model, std::string const& directory)
+        : path_{NativeRestart::filePath(directory)}
+        , modelView_{hierarchy, model}
+    {
+    }
+
+    // the loader of HybridModel::restartLoader
+    template<typename Hierarchy, typename Model>
+    static auto make_loader(Hierarchy& hierarchy, Model& model, std::string const& directory)
+    {
+        auto reader = std::make_shared<NativeReader>(hierarchy, model, directory);
+        return [reader](level_t& level) { return reader->load(level); };
+    }
+
+    bool load(level_t& level);
+
+private:
+    template<typename Field>
+    void copyField_(Field& field, Box_t const& box, std::vector<double> const& saved,
+                    Box_t const& savedBox, std::size_t const* savedShape) const;
+
+    std::string const path_;
+    ModelView modelView_;
+};
+
+
+
+/*
+ * The electromagnetic field of the level is overwritten where the patches of the file overlap
+ * the patches of the level, and the domain particles of the cells the file covers are replaced
+ * by the particles of the file.
+ */
+template<typename ModelView>
+bool NativeReader<ModelView>::load(level_t& level)
+{
+    PHARE_LOG_SCOPE("NativeReader::load");
+
+    auto const iLevel = static_cast<std::size_t>(level.getLevelNumber());
+    auto const path   = NativeRestart::levelPath(iLevel);
+
+    hdf5::h5::HighFiveFile h5File{path_, hdf5::h5::HiFile::ReadOnly};
+    if (!h5File.file().exist(path))
+        return false;
+
+    auto const lower = h5File.read_data_set_flat<int>(path + "/lower");
+    auto const upper = h5File.read_data_set_flat<int>(path + "/upper");
+    std::vector<Box_t> savedBoxes(lower.size() / dimension);
+    for (std::size_t iSaved = 0; iSaved < savedBoxes.size(); ++iSaved)
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            savedBoxes[iSaved].lower[iDim] = lower[iSaved * dimension + iDim];
+            savedBoxes[iSaved].upper[iDim] = upper[iSaved * dimension + iDim];
+        }
+
+    auto& electromag = modelView_.getElectromag();
+    auto& ions       = modelView_.getIons();
+    auto const names = NativeRestart::fieldNames(electromag);
+
+    std::vector<Sizes> fieldOffsets, fieldShapes;
+    for (auto const& name : names)
+    {
+        fieldOffsets.push_back(
+            h5File.read_data_set_flat<std::size_t>(path + "/" + name + "_offset"));
+        fieldShapes.push_back(
+            h5File.read_data_set_flat<std::size_t>(path + "/" + name + "_shape"));
+    }
+
+    // patches of the file are read once, even if they overlap several patches of this rank
+    std::vector<std::unordered_map<std::size_t, std::vector<double>>> fieldData(names.size());
+    auto savedField = [&](std::size_t iField, std::size_t iSaved) -> auto const& {
+        auto& data = fieldData[iField];
+        if (!data.count(iSaved))
+        {
+            auto const* shape = fieldShapes[iField].data() + iSaved * dimension;
+            auto const size   = core::product(std::vector<std::size_t>(shape, shape + dimension),
+                                              std::size_t{1});
+            data[iSaved]      = h5File.read_data_set_flat_selection<double>(
+                path + "/" + names[iField], {fieldOffsets[iField][iSaved]}, {size});
+        }
+        return data[iSaved];
+    };
+
+    std::vector<Sizes> popOffsets, popCounts;
+    for (auto const& pop : ions)
+    {
+        auto const popPath = NativeRestart::popPath(iLevel, pop.name());
+        popOffsets.push_back(h5File.read_data_set_flat<std::size_t>(popPath + "offset"));
+        popCounts.push_back(h5File.read_data_set_flat<std::size_t>(popPath + "count"));
+    }
+
+    modelView_.visitLevel(level, [&](GridLayout& layout, std::string, std::size_t) {
+        auto const box = layout.AMRBox();
+
+        std::vector<std::size_t> overlaps;
+        std::vector<Box_t> covered;
+        for (std::size_t iSaved = 0; iSaved < savedBoxes.size(); ++iSaved)
+            if (auto overlap = box * savedBoxes[iSaved])
+            {
+                overlaps.push_back(iSaved);
+                covered.push_back(*overlap);
+            }
+
+        auto const fields = NativeRestart::fields(electromag);
+        for (std::size_t iField = 0; iField < fields.size(); ++iField)
+            for (auto const iSaved : overlaps)
+                copyField_(*fields[iField], box, savedField(iField, iSaved), savedBoxes[iSaved],
+                           fieldShapes[iField].data() + iSaved * dimension);
+
+        std::size_t iPop = 0;
+        for (auto& pop : ions)
+        {
+            auto& particles     = pop.domainParticles();
+            auto const popPath  = NativeRestart::popPath(iLevel, pop.name());
+            auto const& offsets = popOffsets[iPop];
+            auto const& counts  = popCounts[iPop++];
+
+            std::vector<core::Particle<dimension>> kept;
+            for (auto const& particle : particles)
+                if (!core::isIn(core::Point<int, dimension>{particle.iCell}, covered))
+                    kept.push_back(particle);
+            particles.clear();
+            for (auto const& particle : kept)
+                particles.push_back(particle);
+
+            using float_type = typename core::Particle<dimension>::float_type;
+            for (auto const iSaved : overlaps)
+            {
+                auto const offset = offsets[iSaved], count = counts[iSaved];
+                auto read         = [&](auto type, std::string const& key, std::size_t n) {
+                    return h5File.read_data_set_flat_selection<decltype(type)>(
+                        popPath + key, {offset, 0}, {count, n});
+                };
+                auto const weight = read(double{}, "weight", 1);
+                auto const charge = read(double{}, "charge", 1);
+                auto const iCell  = read(int{}, "iCell", dimension);
+                auto const delta  = read(float_type{}, "delta", dimension);
+                auto const v      = read(float_type{}, "v", 3);
+                auto const id     = read(std::uint64_t{}, "id", 1);
+
+                for (std::size_t idx = 0; idx < count; ++idx)
+                {
+                    core::Particle<dimension> particle;
+                    particle.weight = weight[idx];
+                    particle.charge = charge[idx];
+                    particle.id     = id[idx];
+                    for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    {
+                        particle.iCell[iDim] = iCell[idx * dimension + iDim];
+                        particle.delta[iDim] = delta[idx * dimension + iDim];
+                    }
+                    for (std::size_t iV = 0; iV < 3; ++iV)
+                        particle.v[iV] = v[idx * 3 + iV];
+
+                    if (core::isIn(core::Point<int, dimension>{particle.iCell}, box))
+                        particles.push_back(particle);
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
+
+
+// copies the physical nodes of field the saved patch has
+template<typename ModelView>
+template<typename Field>
+void NativeReader<ModelView>::copyField_(Field& field, Box_t const& box,
+                                         std::vector<double> const& saved,
+                                         Box_t const& savedBox,
+                                         std::size_t const* savedShape) const
+{
+    auto const centering = GridLayout::centering(field.physicalQuantity());
+    auto const ghosts    = static_cast<int>(GridLayout::nbrGhosts());
+
+    Box_t nodes;
+    for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+    {
+        auto const primal = centering[iDim] == core::QtyCentering::primal ? 1 : 0;
+        nodes.lower[iDim] = std::max(box.lower[iDim], savedBox.lower[iDim]);
+        nodes.upper[iDim] = std::min(box.upper[iDim], savedBox.upper[iDim]) + primal;
+    }
+
+    for (auto const& node : nodes)
+    {
+        std::array<std::uint32_t, dimension> local;
+        std::size_t savedIndex = 0;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            local[iDim] = static_cast<std::uint32_t>(node[iDim] - box.lower[iDim] + ghosts);
+            savedIndex  = savedIndex * savedShape[iDim]
+                         + static_cast<std::size_t>(node[iDim] - savedBox.lower[iDim] + ghosts);
+        }
+        field(local) = saved[savedIndex];
+    }
+}
+
+
+
+} // namespace PHARE::restarts::h5
+
+#endif /* PHARE_DETAIL_RESTART_NATIVE_HPP */
@@ -4,13 +4,37 @@
 
 #include "core/logger.hpp"
 #include "core/utilities/types.hpp"
+#include "core/utilities/mpi_utils.hpp"
+#include "core/utilities/async_worker.hpp"
 
 #include "restarts/restarts_props.hpp"
+#include "restarts/detail/h5native.hpp"
 
 #include "hdf5/detail/h5/h5_file.hpp"
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <filesystem>
+
 namespace PHARE::restarts::h5
 {
+/*
+ * Restarts are written in directories named after their time, in path, see
+ * ModelView::restartFilePathForTime.
+ *
+ * Options
+ *   async     : the restart is written while the simulation advances, the next restart waiting
+ *               for it. For the native format, the data to write is copied in memory and
+ *               written to the file by a worker thread. For the samrai format, only the copy
+ *               from local_dir is asynchronous.
+ *   local_dir : samrai format only, the restart files of each process are written in
+ *               local_dir, e.g. on node local storage, then copied in path and removed
+ *   keep      : see RestartsProperties, the directories of the restarts written by this run
+ *               beyond the last keep are removed, the restart being written excepted until
+ *               the writer is drained, which the simulator does at its end
+ */
 template<typename ModelView>
 class Writer
 {
@@ -18,29 +42,136 @@ public:
     using This = Writer<ModelView>;
 
     template<typename Hierarchy, typename Model>
-    Writer(Hierarchy const& hier, Model const& model, std::string const filePath)
+    Writer(Hierarchy& hier, Model& model, std::string const filePath,
+           std::string const format = "samrai", bool const async = false,
+           std::string const localDir = "")
         : path_{filePath}
+        , format_{format}
+        , localDir_{localDir}
         , modelView_{hier, model}
     {
+        if (format_ != "samrai" and format_ != NativeRestart::format)
+            throw std::runtime_error("Unknown restart format " + format_);
+        if (!localDir_.empty() and format_ != "samrai")
+            throw std::runtime_error("Restarts local_dir needs the samrai format");
+
+        // HDF5 performs MPI-IO from the worker thread for the native format
+        bool const mpiFromThread = format_ == NativeRestart::format;
+        if (async)
+            worker_ = core::makeAsyncWorker("restarts", mpiFromThread);
     }
 
-    ~Writer() {}
+    // the simulator drains before destruction, a restart still in flight is only waited for,
+    // without collectives as the other processes may not be destroying their writer, and its
+    // errors are logged
+    ~Writer()
+    {
+        if (!pending_)
+            return;
+        try
+        {
+            worker_->wait();
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "restarts writer: " << e.what() << std::endl;
+        }
+    }
 
 
     template<typename Hierarchy, typename Model>
-    static auto make_unique(Hierarchy const& hier, Model const& model,
-                            initializer::PHAREDict const& dict)
+    static auto make_unique(Hierarchy& hier, Model& model, initializer::PHAREDict const& dict)
     {
         std::string filePath = dict["filePath"].template to<std::string>();
-        return std::make_unique<This>(hier, model, filePath);
+        std::string format   = "samrai";
+        if (dict.contains("format"))
+            format = dict["format"].template to<std::string>();
+        bool const async = dict.contains("async") and dict["async"].template to<int>() > 0;
+        std::string localDir;
+        if (dict.contains("local_dir"))
+            localDir = dict["local_dir"].template to<std::string>();
+        return std::make_unique<This>(hier, model, filePath, format, async, localDir);
     }
 
 
-    void dump(RestartsProperties const& properties, double timestamp)
+    void dump(RestartsProperties const& properties, double timestamp);
+
+    // waits for the restart in flight, if any, then removes the restarts beyond keep
+    void drain()
     {
-        auto restart_file
-            = modelView_.writeRestartFile(ModelView::restartFilePathForTime(path_, timestamp));
+        if (!pending_)
+            return;
+        pending_ = false; // the worker rethrows the errors of the restart once
+        worker_->wait();
+        core::mpi::barrier(); // the restart is complete on all processes
+        removeOldest_(keep_);
+    }
+
+    auto& modelView() { return modelView_; }
+
+
+private:
+    void dumpSamrai_(std::string const& directory, RestartsProperties const& properties,
+                     double timestamp);
+
+    void removeOldest_(std::size_t keep);
 
+    std::string const path_;
+    std::string const format_;
+    std::string const localDir_;
+    ModelView modelView_;
+    std::deque<std::string> written_; // restarts of this run, the oldest first
+    std::size_t keep_ = 0;            // see RestartsProperties
+    std::unique_ptr<core::AsyncWorker> worker_; // null if restarts are synchronous
+    bool pending_ = false; // a restart submitted to the worker is not drained yet
+};
+
+
+
+template<typename ModelView>
+void Writer<ModelView>::dump(RestartsProperties const& properties, double timestamp)
+{
+    keep_ = properties.keep;
+    drain();
+
+    auto const directory = ModelView::restartFilePathForTime(path_, timestamp);
+    if (format_ != NativeRestart::format)
+        dumpSamrai_(directory, properties, timestamp);
+    else if (worker_)
+    {
+        worker_->submit(NativeWriter<ModelView>{modelView_}.stage(directory, properties,
+                                                                  timestamp));
+        pending_ = true;
+    }
+    else
+        NativeWriter<ModelView>{modelView_}.dump(directory, properties, timestamp);
+    written_.push_back(directory);
+
+    // nothing in flight, e.g. asynchronous samrai restarts without local_dir
+    if (!pending_)
+    {
+        core::mpi::barrier();
+        removeOldest_(keep_);
+    }
+}
+
+
+
+template<typename ModelView>
+void Writer<ModelView>::dumpSamrai_(std::string const& directory,
+                                    RestartsProperties const& properties, double timestamp)
+{
+    auto const localDirectory = ModelView::restartFilePathForTime(localDir_, timestamp);
+    auto const& writeDirectory = localDir_.empty() ? directory : localDirectory;
+
+    // local directories may not be shared, SAMRAI creates directories on the first process
+    if (!localDir_.empty())
+        std::filesystem::create_directories(
+            std::filesystem::path{ModelView::restartFilePath(writeDirectory)}.parent_path());
+
+    auto restart_file = modelView_.writeRestartFile(writeDirectory);
+
+    {
         // write model patch_data_ids to file with highfive
         // SAMRAI restart files are PER RANK
         PHARE::hdf5::h5::HighFiveFile h5File{restart_file, HighFive::File::ReadWrite,
@@ -53,17 +184,42 @@ public:
         h5File.write_attribute(
             "/phare", "serialized_simulation",
             properties.fileAttributes["serialized_simulation"].template to<std::string>());
+    }
 
-        core::mpi::barrier();
+    if (localDir_.empty())
+        return;
+
+    // each process moves its own file, as the local directories may not be shared
+    auto move = [from = restart_file, to = ModelView::restartFilePath(directory),
+                 local = localDirectory]() {
+        PHARE_LOG_SCOPE("Writer::copyRestart");
+        namespace fs = std::filesystem;
+        fs::create_directories(fs::path{to}.parent_path());
+        fs::copy_file(from, to, fs::copy_options::overwrite_existing);
+        fs::remove_all(local);
+    };
+    if (worker_)
+    {
+        worker_->submit(std::move(move));
+        pending_ = true;
     }
+    else
+        move();
+}
 
-    auto& modelView() { return modelView_; }
 
 
-private:
-    std::string const path_;
-    ModelView const modelView_;
-};
+// restart directories are removed by the first process, once written by all processes
+template<typename ModelView>
+void Writer<ModelView>::removeOldest_(std::size_t keep)
+{
+    while (keep > 0 and written_.size() > keep)
+    {
+        if (core::mpi::rank() == 0)
+            std::filesystem::remove_all(written_.front());
+        written_.pop_front();
+    }
+}
 
 
 
@@ -28,6 +28,10 @@ struct NullOpRestartsManager : public IRestartsManager
     {
         throw std::runtime_error("NOOP");
     }
+
+    bool needsDump(double /*timeStamp*/, double /*timeStep*/) override { return false; }
+
+    void drain() override {}
 };
 
 struct RestartsManagerResolver
@@ -42,6 +46,22 @@ struct RestartsManagerResolver
         return RestartsManager<Writer_t>::make_unique(hier, model, dict);
 #else
         return std::make_unique<NullOpRestartsManager>();
+#endif
+    }
+
+    // restarts from a native restart file are loaded as the hierarchy is initialized
+    template<typename Hierarchy, typename Model>
+    static void set_loader(Hierarchy& hier, Model& model, initializer::PHAREDict const& dict)
+    {
+        if (!dict.contains("loadPath") or !dict.contains("format"))
+            return;
+#if PHARE_HAS_HIGHFIVE
+        if (dict["format"].template to<std::string>() == h5::NativeRestart::format)
+        {
+            using Reader_t = h5::NativeReader<ModelView<Hierarchy, Model>>;
+            model.restartLoader
+                = Reader_t::make_loader(hier, model, dict["loadPath"].template to<std::string>());
+        }
 #endif
     }
 };
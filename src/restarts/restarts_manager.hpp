@@ -3,6 +3,7 @@
 #define PHARE_RESTART_MANAGER_HPP_
 
 #include "core/logger.hpp"
+#include "core/utilities/mpi_utils.hpp"
 #include "core/data/particles/particle_array.hpp"
 
 #include "initializer/data_provider.hpp"
@@ -11,8 +12,11 @@
 
 
 #include <cmath>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <algorithm>
 
 
 
@@ -21,7 +25,9 @@ namespace PHARE::restarts
 class IRestartsManager
 {
 public:
-    virtual void dump(double timeStamp, double timeStep) = 0;
+    virtual void dump(double timeStamp, double timeStep)      = 0;
+    virtual bool needsDump(double timeStamp, double timeStep) = 0;
+    virtual void drain()                                      = 0;
     inline virtual ~IRestartsManager();
 };
 IRestartsManager::~IRestartsManager() {}
@@ -34,6 +40,15 @@ class RestartsManager : public IRestartsManager
 public:
     void dump(double timeStamp, double timeStep) override;
 
+    bool needsDump(double timeStamp, double timeStep) override
+    {
+        return restarts_properties_ and needsWrite_(*restarts_properties_, timeStamp, timeStep);
+    }
+
+
+    // waits for a pending asynchronous restart, e.g. before other HDF5 files are used
+    void drain() override { writer_->drain(); }
+
 
 
     RestartsManager(std::unique_ptr<Writer>&& writer_ptr)
@@ -76,7 +91,8 @@ private:
     }
 
 
-    bool needsWrite_(RestartsProperties const& rest, double const timeStamp, double const timeStep)
+    bool needsTimestamp_(RestartsProperties const& rest, double const timeStamp,
+                         double const timeStep)
     {
         auto const& nextWrite = nextWrite_;
 
@@ -85,9 +101,53 @@ private:
     }
 
 
+    /* The wall clock triggers use the elapsed time of the slowest process, so that all
+     * processes take the same decision. The restart before the time limit is written once the
+     * time left is less than twice the longest time step so far, which includes restarts.
+     */
+    bool needsWallClock_(RestartsProperties const& rest)
+    {
+        if (rest.elapsedInterval <= 0 and rest.timeLimit <= 0)
+            return false;
+
+        auto const local = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() - start_)
+                               .count();
+        auto const elapsed = core::mpi::max(static_cast<std::size_t>(local)) / 1e3;
+        if (lastCheck_ >= 0)
+            longestStep_ = std::max(longestStep_, elapsed - lastCheck_);
+        lastCheck_ = elapsed;
+
+        bool const interval
+            = rest.elapsedInterval > 0 and elapsed - lastWrite_ >= rest.elapsedInterval;
+        bool const limit = rest.timeLimit > 0 and !beforeLimit_
+                           and elapsed + 2 * longestStep_ >= rest.timeLimit;
+        beforeLimit_ = beforeLimit_ or limit;
+        return interval or limit;
+    }
+
+
+    // evaluated once per time step, as the wall clock triggers are collective
+    bool needsWrite_(RestartsProperties const& rest, double const timeStamp, double const timeStep)
+    {
+        if (checkedTime_ != timeStamp)
+        {
+            checkedTime_ = timeStamp;
+            writeNeeded_ = needsTimestamp_(rest, timeStamp, timeStep) or needsWallClock_(rest);
+        }
+        return writeNeeded_;
+    }
+
+
     std::unique_ptr<RestartsProperties> restarts_properties_;
     std::unique_ptr<Writer> writer_;
     std::size_t nextWrite_ = 0;
+
+    std::chrono::steady_clock::time_point const start_ = std::chrono::steady_clock::now();
+    double lastCheck_ = -1, lastWrite_ = 0, longestStep_ = 0; // seconds since start_
+    bool beforeLimit_ = false;
+    double checkedTime_ = std::numeric_limits<double>::quiet_NaN();
+    bool writeNeeded_   = false;
 };
 
 
@@ -103,6 +163,13 @@ RestartsManager<Writer>::addRestartDict(initializer::PHAREDict const& params)
     restarts_properties_->writeTimestamps
         = params["write_timestamps"].template to<std::vector<double>>();
 
+    if (params.contains("elapsed_interval"))
+        restarts_properties_->elapsedInterval = params["elapsed_interval"].template to<double>();
+    if (params.contains("time_limit"))
+        restarts_properties_->timeLimit = params["time_limit"].template to<double>();
+    if (params.contains("keep"))
+        restarts_properties_->keep = params["keep"].template to<std::size_t>();
+
     assert(params.contains("serialized_simulation"));
 
     restarts_properties_->fileAttributes["serialized_simulation"]
@@ -123,7 +190,9 @@ void RestartsManager<Writer>::dump(double timeStamp, double timeStep)
     if (needsWrite_(*restarts_properties_, timeStamp, timeStep))
     {
         writer_->dump(*restarts_properties_, timeStamp);
-        ++nextWrite_;
+        if (needsTimestamp_(*restarts_properties_, timeStamp, timeStep))
+            ++nextWrite_;
+        lastWrite_ = lastCheck_;
     }
 }
 
@@ -8,6 +8,8 @@
 #include "amr/physical_models/hybrid_model.hpp"
 #include "hdf5/phare_hdf5.hpp"
 
+#include <SAMRAI/tbox/Utilities.h>
+
 
 namespace PHARE::restarts
 {
@@ -28,7 +30,11 @@ template<typename Hierarchy, typename Model, std::enable_if_t<is_hybrid_model<Mo
 class ModelView : public IModelView
 {
 public:
-    ModelView(Hierarchy const& hierarchy, Model const& model)
+    using GridLayout                = typename Model::gridlayout_type;
+    using level_t                   = typename Model::level_t;
+    static constexpr auto dimension = Model::dimension;
+
+    ModelView(Hierarchy& hierarchy, Model& model)
         : model_{model}
         , hierarchy_{hierarchy}
     {
@@ -46,9 +52,45 @@ public:
         return Hierarchy::restartFilePathForTime(path, timestamp);
     }
 
+    // the SAMRAI restart file of this process in directory
+    auto static restartFilePath(std::string const& directory)
+    {
+        return Hierarchy::getRestartFileFullPath(directory);
+    }
+
 
     auto patch_data_ids() const { return model_.patch_data_ids(); }
 
+    // created by the first MPI process, with its parent directories
+    static void makeDirectory(std::string const& path)
+    {
+        SAMRAI::tbox::Utilities::recursiveMkdir(path);
+    }
+
+
+    auto& getElectromag() const { return model_.state.electromag; }
+
+    auto& getIons() const { return model_.state.ions; }
+
+    auto nbrLevels() const { return hierarchy_.getNumberOfLevels(); }
+
+
+    // action(layout, patchID, iLevel) on each local patch of the level, the model set on it
+    template<typename Action>
+    void visitLevel(level_t& level, Action&& action)
+    {
+        PHARE::amr::visitLevel<GridLayout>(level, *model_.resourcesManager,
+                                           std::forward<Action>(action), model_);
+    }
+
+    template<typename Action>
+    void visitHierarchy(Action&& action)
+    {
+        PHARE::amr::visitHierarchy<GridLayout>(hierarchy_, *model_.resourcesManager,
+                                               std::forward<Action>(action), 0,
+                                               hierarchy_.getNumberOfLevels() - 1, model_);
+    }
+
 
     ModelView(ModelView const&) = delete;
     ModelView(ModelView&&)      = delete;
@@ -56,8 +98,8 @@ public:
     ModelView& operator=(ModelView&&) = delete;
 
 protected:
-    Model const& model_;
-    Hierarchy const& hierarchy_;
+    Model& model_;
+    Hierarchy& hierarchy_;
 };
 
 
@@ -15,6 +15,12 @@ struct RestartsProperties
 
     std::vector<double> writeTimestamps;
 
+    // wall clock triggers, in seconds since the start of the simulation, 0 if unused
+    double elapsedInterval = 0; // a restart every elapsedInterval
+    double timeLimit       = 0; // a single restart before timeLimit, the job time limit
+
+    std::size_t keep = 0; // number of restarts kept by the writer, 0 keeps all of them
+
     FileAttributes fileAttributes{};
 };
 
@@ -11,7 +11,13 @@ std::unique_ptr<PHARE::ISimulator> getSimulator(std::shared_ptr<PHARE::amr::Hier
     auto interpOrder   = theDict["simulation"]["interp_order"].template to<int>();
     auto nbRefinedPart = theDict["simulation"]["refined_particle_nbr"].template to<int>();
 
-    return core::makeAtRuntime<SimulatorMaker>(dim, interpOrder, nbRefinedPart,
-                                               SimulatorMaker{hierarchy});
+    auto simulator = core::makeAtRuntime<SimulatorMaker>(dim, interpOrder, nbRefinedPart,
+                                                         SimulatorMaker{hierarchy});
+    if (!simulator)
+        throw std::runtime_error("no simulator of dimension " + std::to_string(dim)
+                                 + ", interpolation order " + std::to_string(interpOrder)
+                                 + " and " + std::to_string(nbRefinedPart)
+                                 + " refined particles, see -Dsimulators");
+    return simulator;
 }
 } /* namespace PHARE */
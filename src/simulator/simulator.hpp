@@ -39,6 +39,9 @@ public:
 
     virtual ~ISimulator() {}
     virtual bool dump(double timestamp, double timestep) { return false; } // overriding optional
+
+    // waits for the asynchronous diagnostics and restarts in flight, rethrowing their errors
+    virtual void drain() {}
 };
 
 template<std::size_t _dimension, std::size_t _interp_order, std::size_t _nbRefinedPart>
@@ -67,7 +70,12 @@ public:
     {
         if (rMan)
         {
+            // HDF5 is not used concurrently by asynchronous diagnostics and restarts
+            if (dMan and rMan->needsDump(timestamp, timestep))
+                dMan->drain();
             rMan->dump(timestamp, timestep);
+            if (dMan and dMan->needsDump(timestamp, timestep))
+                rMan->drain();
         }
 
         if (dMan)
@@ -76,6 +84,14 @@ public:
         return false;
     }
 
+    void drain() override
+    {
+        if (dMan)
+            dMan->drain();
+        if (rMan)
+            rMan->drain();
+    }
+
     Simulator(PHARE::initializer::PHAREDict const& dict,
               std::shared_ptr<PHARE::amr::Hierarchy> const& hierarchy);
     ~Simulator()
@@ -205,6 +221,7 @@ template<std::size_t dim, std::size_t _interp, std::size_t nbRefinedPart>
 double Simulator<dim, _interp, nbRefinedPart>::restarts_init(initializer::PHAREDict const& dict)
 {
     rMan = restarts::RestartsManagerResolver::make_unique(*hierarchy_, *hybridModel_, dict);
+    restarts::RestartsManagerResolver::set_loader(*hierarchy_, *hybridModel_, dict);
 
     if (dict.contains("restart_time"))
         return (currentTime_ = dict["restart_time"].template to<double>());
@@ -349,6 +366,9 @@ void Simulator<_dimension, _interp_order, _nbRefinedPart>::initialize()
 
     isInitialized = true;
 
+    // levels created later are not loaded from the restart file
+    hybridModel_->restartLoader = nullptr;
+
     if (hierarchy_->isFromRestart())
         hierarchy_->closeRestartFile();
 }
@@ -446,6 +466,19 @@ makeSimulator(std::shared_ptr<amr::Hierarchy> const& hierarchy)
 }
 
 
+// with -DsimulatorInstances=ON, the simulators are only instantiated by phare_simulator, each
+// dim_interp in its own translation unit (see simulator_instance.cpp.in), so that each target
+// including this header does not compile them again
+#if defined(PHARE_EXTERN_SIMULATORS)
+#define PHARE_EXTERN_SIMULATOR(dim, interp, nbRefinedPart)                                         \
+    extern template class Simulator<dim, interp, nbRefinedPart>;
+
+PHARE_SIMULATOR_INSTANCES(PHARE_EXTERN_SIMULATOR)
+
+#undef PHARE_EXTERN_SIMULATOR
+#endif
+
+
 } // namespace PHARE
 
 #endif /*PHARE_SIMULATOR_SIMULATOR_H*/
@@ -1,6 +1,8 @@
 #include <cstdint>
+#include <vector>
 
 #include "core/utilities/types.hpp"
+#include "core/data/particles/particle.hpp"
 #include "amr/data/particles/refine/split.hpp"
 
 #include "gmock/gmock.h"
@@ -20,7 +22,8 @@ struct SplitterTest : public ::testing::Test
     SplitterTest() { Splitter splitter; }
 };
 
-using Splitters = testing::Types<Splitter<1, 1, 2>, Splitter<2, 1, 8> /*, Splitter<3, 1, 27>*/>;
+using Splitters = testing::Types<Splitter<1, 1, 2>, Splitter<2, 1, 8>, Splitter<3, 1, 8>,
+                                 Splitter<3, 1, 27>, Splitter<3, 2, 27>, Splitter<3, 3, 27>>;
 
 TYPED_TEST_SUITE(SplitterTest, Splitters);
 
@@ -29,4 +32,34 @@ TYPED_TEST(SplitterTest, constexpr_init)
     constexpr TypeParam param{};
 }
 
+TYPED_TEST(SplitterTest, conservesTheWeightAndPositionOfSplitParticles)
+{
+    constexpr auto dim = TypeParam::dimension;
+    TypeParam splitter;
+
+    PHARE::core::Particle<dim> particle;
+    particle.weight = 1;
+    particle.charge = 1;
+    particle.iCell.fill(10);
+    particle.delta.fill(.3);
+    particle.v = {1, 2, 3};
+
+    std::vector<PHARE::core::Particle<dim>> refined(TypeParam::nbRefinedPart);
+    splitter(particle, refined);
+
+    double weight = 0;
+    std::array<double, dim> position{};
+    for (auto const& fine : refined)
+    {
+        weight += fine.weight;
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            position[iDim] += fine.weight * (fine.iCell[iDim] + fine.delta[iDim]);
+    }
+
+    // the weight of refined particles is scaled by the number of fine cells of a coarse one
+    EXPECT_NEAR(weight, 1 << dim, 1e-4);
+    for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        EXPECT_NEAR(position[iDim] / weight, 10.3, 1e-5);
+}
+
 } // namespace
@@ -1,4 +1,6 @@
 
+#include <set>
+#include <cstdint>
 #include <type_traits>
 
 
@@ -79,6 +81,190 @@ TEST_F(AMaxwellianParticleInitializer1D, loadsParticlesInTheDomain)
 
 
 
+TEST_F(AMaxwellianParticleInitializer1D, givesDistinctIdsToItsParticles)
+{
+    initializer->loadParticles(particles, layout);
+    std::set<std::uint64_t> ids;
+    for (auto const& particle : particles)
+        ids.insert(particle.id);
+    EXPECT_EQ(particles.size(), ids.size());
+}
+
+
+
+
+TEST(ACounterBasedMaxwellianParticleInitializer1D, loadsTheSameParticlesForAnyPatchesOrThreads)
+{
+    using GridLayoutT       = GridLayout<GridLayoutImplYee<1, 1>>;
+    using ParticleArrayT    = ParticleArray<1>;
+    using InitFunctionArray = std::array<InitFunction<1>, 3>;
+    using Initializer       = MaxwellianParticleInitializer<ParticleArrayT, GridLayoutT>;
+
+    // uniform profiles, as coordinates of patches of different origins may differ by rounding
+    InitFunction<1> const one = [](std::vector<double> const& x) {
+        return std::make_shared<VectorSpan<double>>(std::vector<double>(x.size(), 1.));
+    };
+
+    auto load = [&](GridLayoutT const& layout, std::size_t nbrThreads) {
+        CounterBasedLoading counterBased{true, /*population=*/0, nbrThreads};
+        Initializer initializer{one, InitFunctionArray{one, one, one},
+                                InitFunctionArray{one, one, one}, 1., 100, 1337,
+                                Basis::Cartesian, InitFunctionArray{nullptr, nullptr, nullptr},
+                                counterBased};
+        ParticleArrayT particles{layout.AMRBox()};
+        initializer.loadParticles(particles, layout);
+        return particles;
+    };
+
+    GridLayoutT whole{{{0.1}}, {{50}}, Point{0.}, Box{Point{50}, Point{99}}};
+    GridLayoutT lower{{{0.1}}, {{25}}, Point{0.}, Box{Point{50}, Point{74}}};
+    GridLayoutT upper{{{0.1}}, {{25}}, Point{2.5}, Box{Point{75}, Point{99}}};
+
+    auto const expected = load(whole, 1);
+    EXPECT_EQ(5000u, expected.size());
+    EXPECT_EQ(100u, expected.nbr_particles_in(Box<int, 1>{Point{60}, Point{60}}));
+    EXPECT_TRUE(expected == load(whole, 4));
+
+    auto halves       = load(lower, 1);
+    auto const second = load(upper, 3);
+    for (auto const& particle : second)
+        halves.push_back(particle);
+    EXPECT_TRUE(expected == halves);
+
+    // ids are not compared by ==, they are the same too, and distinct
+    std::set<std::uint64_t> ids;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(expected[i].id, halves[i].id);
+        ids.insert(expected[i].id);
+    }
+    EXPECT_EQ(expected.size(), ids.size());
+}
+
+
+
+TEST(ACounterBasedMaxwellianParticleInitializer1D, samplesTheMaxwellianWithAnOddNumberOfParticles)
+{
+    using GridLayoutT       = GridLayout<GridLayoutImplYee<1, 1>>;
+    using ParticleArrayT    = ParticleArray<1>;
+    using InitFunctionArray = std::array<InitFunction<1>, 3>;
+    using Initializer       = MaxwellianParticleInitializer<ParticleArrayT, GridLayoutT>;
+
+    InitFunction<1> const one = [](std::vector<double> const& x) {
+        return std::make_shared<VectorSpan<double>>(std::vector<double>(x.size(), 1.));
+    };
+
+    // the third normals pair the two halves of a cell, the last particle drawing its own
+    std::uint32_t constexpr nbrParticlesPerCell = 101;
+    Initializer initializer{one,
+                            InitFunctionArray{one, one, one},
+                            InitFunctionArray{one, one, one},
+                            1.,
+                            nbrParticlesPerCell,
+                            1337,
+                            Basis::Cartesian,
+                            InitFunctionArray{nullptr, nullptr, nullptr},
+                            CounterBasedLoading{true, /*population=*/0, /*nbrThreads=*/1}};
+    GridLayoutT layout{{{0.1}}, {{1000}}, Point{0.}, Box{Point{0}, Point{999}}};
+    ParticleArrayT particles{layout.AMRBox()};
+    initializer.loadParticles(particles, layout);
+    ASSERT_EQ(1000u * nbrParticlesPerCell, particles.size());
+
+    for (std::size_t comp = 0; comp < 3; comp++)
+    {
+        double mean = 0, variance = 0;
+        for (auto const& particle : particles)
+            mean += particle.v[comp] / particles.size();
+        for (auto const& particle : particles)
+            variance += (particle.v[comp] - mean) * (particle.v[comp] - mean) / particles.size();
+        EXPECT_NEAR(1., mean, 0.01);
+        EXPECT_NEAR(1., std::sqrt(variance), 0.01);
+    }
+}
+
+
+
+TEST(APrefetchingMaxwellianParticleInitializer1D, evaluatesProfilesOnceForAllLayouts)
+{
+    using GridLayoutT       = GridLayout<GridLayoutImplYee<1, 1>>;
+    using ParticleArrayT    = ParticleArray<1>;
+    using InitFunctionArray = std::array<InitFunction<1>, 3>;
+    using Initializer       = MaxwellianParticleInitializer<ParticleArrayT, GridLayoutT>;
+
+    std::size_t nbrCalls       = 0;
+    InitFunction<1> const vx_n = [&](std::vector<double> const& x) {
+        ++nbrCalls;
+        return vx(x);
+    };
+    auto makeInitializer = [&]() {
+        return Initializer{density, InitFunctionArray{vx_n, vy, vz},
+                           InitFunctionArray{vthx, vthy, vthz}, 1., 10, 1337};
+    };
+
+    std::vector<GridLayoutT> layouts{{{{0.1}}, {{25}}, Point{0.}, Box{Point{50}, Point{74}}},
+                                     {{{0.1}}, {{25}}, Point{2.5}, Box{Point{75}, Point{99}}}};
+
+    auto prefetching = makeInitializer();
+    prefetching.prefetch(layouts);
+    EXPECT_EQ(1u, nbrCalls);
+
+    for (auto const& layout : layouts)
+    {
+        ParticleArrayT prefetched{layout.AMRBox()}, expected{layout.AMRBox()};
+        prefetching.loadParticles(prefetched, layout);
+        makeInitializer().loadParticles(expected, layout);
+        EXPECT_TRUE(expected == prefetched);
+    }
+    EXPECT_EQ(3u, nbrCalls); // the two non prefetched initializers
+}
+
+
+
+TEST(AMaxwellianBatch, samplesTheMaxwellianAndTransformsAsPerParticle)
+{
+    std::size_t constexpr nbrParticles = 100001;
+    std::array<double, 3> const V{1., -2., 3.}, Vth{.5, 1., 2.};
+
+    MaxwellianBatch batch;
+    batch.resize(nbrParticles);
+    std::mt19937_64 generator{1337};
+    std::uniform_real_distribution<> uniform;
+    std::array<std::vector<double>, 3> uniforms;
+    for (auto& u : uniforms)
+        for (std::size_t i = 0; i < nbrParticles; ++i)
+            u.push_back(uniform(generator));
+    Philox::boxMuller(uniforms[0].data(), uniforms[1].data(), batch.v[0].data(), batch.v[1].data(),
+                      nbrParticles);
+    // an odd number of particles, the last normal needs another uniform number
+    Philox::boxMuller(uniforms[2].data(), uniform(generator), batch.v[2].data(), nbrParticles);
+    batch.maxwellian(V, Vth);
+
+    for (std::size_t comp = 0; comp < 3; comp++)
+    {
+        double mean = 0, variance = 0;
+        for (auto const v : batch.v[comp])
+            mean += v / nbrParticles;
+        for (auto const v : batch.v[comp])
+            variance += (v - mean) * (v - mean) / nbrParticles;
+        EXPECT_NEAR(V[comp], mean, 0.02);
+        EXPECT_NEAR(Vth[comp], std::sqrt(variance), 0.02);
+    }
+
+    std::array<std::array<double, 3>, 3> basis;
+    localMagneticBasis({.3, -1., 2.}, basis);
+    auto const cartesian = batch.v;
+    batch.basisTransform(basis);
+    for (std::size_t i = 0; i < nbrParticles; i += 1000)
+    {
+        auto const expected
+            = basisTransform(basis, {cartesian[0][i], cartesian[1][i], cartesian[2][i]});
+        for (std::size_t comp = 0; comp < 3; comp++)
+            EXPECT_DOUBLE_EQ(expected[comp], batch.v[comp][i]);
+    }
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
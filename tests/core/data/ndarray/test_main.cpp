@@ -1,6 +1,9 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
 #include <random>
 #include <string>
 
@@ -392,6 +395,163 @@ TEST(MaskedView2d, maskOps2)
                                                                   + Mask{0u}.nCells(array));
 }
 
+TEST(MaskedView3d, maskOps)
+{
+    constexpr std::size_t dim       = 3;
+    constexpr std::uint32_t size0   = 20, size1 = 22, size2 = 24;
+    constexpr std::uint32_t sizeCub = size0 * size1 * size2;
+    using Mask                      = NdArrayMask;
+    NdArrayVector<dim> array{size0, size1, size2};
+
+    auto shell = [](std::uint32_t nx, std::uint32_t ny, std::uint32_t nz) {
+        return nx * ny * nz - (nx - 2) * (ny - 2) * (nz - 2);
+    };
+
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), 0);
+
+    std::fill(array.begin(), array.end(), 1);
+
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), sizeCub);
+
+    Mask oneCellOffset2{2u};
+    array[oneCellOffset2] = 2;
+
+    EXPECT_EQ(shell(16, 18, 20), oneCellOffset2.nCells(array));
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0),
+              sizeCub + oneCellOffset2.nCells(array));
+
+    Mask twoCellsOffset5{5u, 6u};
+    array[twoCellsOffset5] = 2;
+
+    EXPECT_EQ(shell(10, 12, 14) + shell(8, 10, 12), twoCellsOffset5.nCells(array));
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0),
+              sizeCub + oneCellOffset2.nCells(array) + twoCellsOffset5.nCells(array));
+
+    EXPECT_EQ(array(0, 0, 0), 1);
+    EXPECT_EQ(array(size0 - 1, size1 - 1, size2 - 1), 1);
+    array[Mask{5u}] >> array[Mask{0u}];
+    EXPECT_EQ(array(0, 0, 0), 2);
+    EXPECT_EQ(array(size0 - 1, size1 - 1, size2 - 1), 2);
+
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), sizeCub + oneCellOffset2.nCells(array)
+                                                                  + twoCellsOffset5.nCells(array)
+                                                                  + Mask{0u}.nCells(array));
+}
+
+
+TEST(MaskedView3d, nearestInnerNodesAreCopiedOutwards)
+{
+    constexpr std::uint32_t nx = 6, ny = 7, nz = 8;
+    NdArrayVector<3, double, true, 8> array{nx, ny, nz}; // padded rows
+    for (std::uint32_t i = 0; i < nx; ++i)
+        for (std::uint32_t j = 0; j < ny; ++j)
+            for (std::uint32_t k = 0; k < nz; ++k)
+                array(i, j, k) = i * 100. + j * 10. + k;
+
+    array[NdArrayMask{1u}] >> array[NdArrayMask{0u}];
+
+    auto nearest = [](std::uint32_t i, std::uint32_t n) { return std::clamp(i, 1u, n - 2); };
+    for (std::uint32_t i = 0; i < nx; ++i)
+        for (std::uint32_t j = 0; j < ny; ++j)
+            for (std::uint32_t k = 0; k < nz; ++k)
+                EXPECT_DOUBLE_EQ(nearest(i, nx) * 100. + nearest(j, ny) * 10. + nearest(k, nz),
+                                 array(i, j, k));
+}
+
+
+TEST(NdArrayVector, bufferIsAligned)
+{
+    NdArrayVector<1> a1{13u};
+    NdArrayVector<2> a2{13u, 7u};
+    NdArrayVector<3, double, true, 8> a3{5u, 3u, 7u};
+
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(a1.data()) % ndarray_alignment);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(a2.data()) % ndarray_alignment);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(a3.data()) % ndarray_alignment);
+}
+
+
+TEST(NdArrayVector, paddedRowsAreAligned)
+{
+    std::uint32_t constexpr nx = 5, ny = 13;
+    NdArrayVector<2, double, true, 8> array{nx, ny};
+
+    EXPECT_TRUE(array.isPadded());
+    EXPECT_EQ(nx * ny, array.size());
+    EXPECT_EQ(nx * 16u, array.memorySize());
+    EXPECT_EQ((std::array<std::uint32_t, 2>{nx, 16u}), array.memoryShape());
+    EXPECT_EQ((std::array<std::size_t, 2>{16u, 1u}), array.strides());
+
+    for (std::uint32_t i = 0; i < nx; ++i)
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(&array(i, 0u)) % ndarray_alignment);
+
+    NdArrayVector<2> notPadded{nx, ny};
+    EXPECT_FALSE(notPadded.isPadded());
+    EXPECT_EQ((std::array<std::size_t, 2>{ny, 1u}), notPadded.strides());
+}
+
+
+TEST(NdArrayVector, paddedArrayPacksAndUnpacksWithoutPadding)
+{
+    std::uint32_t constexpr nx = 4, ny = 3, nz = 5;
+    NdArrayVector<3, double, true, 8> array{nx, ny, nz};
+    NdArrayVector<3> reference{nx, ny, nz};
+
+    double value = 0;
+    for (std::uint32_t i = 0; i < nx; ++i)
+        for (std::uint32_t j = 0; j < ny; ++j)
+            for (std::uint32_t k = 0; k < nz; ++k)
+            {
+                array(i, j, k)     = value;
+                reference(i, j, k) = value;
+                value += 1;
+            }
+
+    auto const contiguous = packed(array);
+    ASSERT_EQ(reference.size(), contiguous.size());
+    EXPECT_TRUE(std::equal(contiguous.begin(), contiguous.end(), reference.begin()));
+
+    auto view = array.view();
+    EXPECT_EQ(array.strides(), view.strides());
+    EXPECT_EQ(array(3u, 2u, 4u), view(3u, 2u, 4u));
+
+    NdArrayVector<3, double, true, 8> copy{nx, ny, nz};
+    unpack(contiguous.data(), copy);
+    for (std::uint32_t i = 0; i < nx; ++i)
+        for (std::uint32_t j = 0; j < ny; ++j)
+            for (std::uint32_t k = 0; k < nz; ++k)
+                EXPECT_EQ(reference(i, j, k), copy(i, j, k));
+}
+
+
+
+TEST(NdArrayVector, iteratesOverTheElementsWithoutPadding)
+{
+    std::uint32_t constexpr nx = 4, ny = 3, nz = 5;
+    NdArrayVector<3, double, true, 8> array{nx, ny, nz};
+    std::iota(array.begin(), array.end(), 0.);
+
+    EXPECT_EQ(array.size(), static_cast<std::size_t>(std::distance(array.begin(), array.end())));
+    double value = 0;
+    for (std::uint32_t i = 0; i < nx; ++i)
+        for (std::uint32_t j = 0; j < ny; ++j)
+            for (std::uint32_t k = 0; k < nz; ++k)
+                EXPECT_EQ(value++, array(i, j, k));
+
+    auto const padded = contiguous(array);
+    ASSERT_EQ(array.size(), padded.size());
+    EXPECT_NE(array.data(), padded.data());
+    EXPECT_TRUE(std::equal(padded.begin(), padded.end(), array.begin()));
+
+    NdArrayVector<3> notPadded{nx, ny, nz};
+    std::iota(notPadded.begin(), notPadded.end(), 0.);
+    auto const inPlace = contiguous(notPadded);
+    EXPECT_EQ(notPadded.data(), inPlace.data()); // no copy
+    EXPECT_TRUE(std::equal(inPlace.begin(), inPlace.end(), padded.begin()));
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
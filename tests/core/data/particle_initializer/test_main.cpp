@@ -7,11 +7,13 @@
 #include "core/data/ions/particle_initializers/particle_initializer_factory.hpp"
 #include "core/data/particles/particle_array.hpp"
 #include "initializer/data_provider.hpp"
+#include "initializer/init_profiles.hpp"
 
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <vector>
 #include <type_traits>
 
@@ -50,6 +52,82 @@ TEST(AParticleIinitializerFactory, takesAPHAREDictToCreateAParticleVectorInitial
     auto initializer = ParticleInitializerFactory<ParticleArrayT, GridLayoutT>::create(dict);
 }
 
+
+TEST(InitProfiles, evaluateTheirClosedFormInCpp)
+{
+    PHAREDict harris, gaussian, piecewise, sum;
+    harris["name"]       = std::string{"harris"};
+    harris["axis"]       = std::size_t{1};
+    harris["centers"]    = std::vector<double>{2., 8.};
+    harris["width"]      = .5;
+    harris["background"] = -1.;
+    harris["kind"]       = std::string{"field"};
+
+    gaussian["name"]   = std::string{"gaussian"};
+    gaussian["center"] = std::vector<double>{1., 2.};
+    gaussian["sigma"]  = std::vector<double>{1., 2.};
+
+    piecewise["name"]   = std::string{"piecewise"};
+    piecewise["axis"]   = std::size_t{0};
+    piecewise["bounds"] = std::vector<double>{1., 3.};
+    piecewise["values"] = std::vector<double>{4., 5., 6.};
+
+    sum["name"]                = std::string{"sum"};
+    sum["nbr_terms"]           = std::size_t{2};
+    sum["terms"]["0"]          = piecewise;
+    sum["terms"]["1"]["name"]  = std::string{"uniform"};
+    sum["terms"]["1"]["value"] = 1.;
+
+    std::vector<double> const x{0., 1., 2., 3.}, y{5., 2., 8., 4.};
+    auto values = [&](PHAREDict const& dict) {
+        auto const span = initFunction<2>(dict)(x, y);
+        return std::vector<double>(span->data(), span->data() + span->size());
+    };
+
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(values(harris)[i],
+                         -1. + std::tanh((y[i] - 2.) / .5) - std::tanh((y[i] - 8.) / .5));
+        EXPECT_DOUBLE_EQ(values(gaussian)[i], std::exp(-.5 * (x[i] - 1.) * (x[i] - 1.)
+                                                        - .125 * (y[i] - 2.) * (y[i] - 2.)));
+    }
+    EXPECT_EQ((std::vector<double>{4., 5., 5., 6.}), values(piecewise));
+    EXPECT_EQ((std::vector<double>{5., 6., 6., 7.}), values(sum));
+
+    PHAREDict unknown;
+    unknown["name"] = std::string{"unknown"};
+    EXPECT_THROW(values(unknown), std::runtime_error);
+}
+
+
+TEST(AParticleIinitializerFactory, createsMaxwelliansFromNativeProfiles)
+{
+    PHAREDict dict;
+    auto uniform = [&](std::string const& key, double value) {
+        dict[key]["name"]  = std::string{"uniform"};
+        dict[key]["value"] = value;
+    };
+    dict["name"] = std::string{"maxwellian"};
+    uniform("density", 2.);
+    for (auto const& key : {"bulk_velocity_x", "bulk_velocity_y", "bulk_velocity_z"})
+        uniform(key, 0.);
+    for (auto const& key : {"thermal_velocity_x", "thermal_velocity_y", "thermal_velocity_z"})
+        uniform(key, .1);
+    dict["charge"]            = 1.;
+    dict["nbr_part_per_cell"] = int{10};
+    dict["basis"]             = std::string{"cartesian"};
+
+    GridLayoutT layout{{{0.1}}, {{50}}, Point{0.}, Box{Point{50}, Point{99}}};
+    ParticleArrayT particles{layout.AMRBox()};
+    ParticleInitializerFactory<ParticleArrayT, GridLayoutT>::create(dict)->loadParticles(particles,
+                                                                                         layout);
+
+    EXPECT_EQ(500u, particles.size());
+    for (auto const& particle : particles)
+        EXPECT_DOUBLE_EQ(.2, particle.weight);
+}
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
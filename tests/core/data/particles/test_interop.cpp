@@ -3,6 +3,10 @@
 #include "core/data/particles/particle.hpp"
 #include "core/data/particles/particle_array.hpp"
 #include "core/data/particles/particle_packer.hpp"
+#include "core/data/particles/particle_selector.hpp"
+
+#include <numeric>
+#include <algorithm>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -32,9 +36,11 @@ TYPED_TEST(ParticleListTest, SoAandAoSInterop)
         view.weight = 1 + i;
         view.charge = 1 + i;
         view.iCell  = ConstArray<int, dim>(i);
-        view.delta  = ConstArray<double, dim>(i + 1);
-        view.v      = ConstArray<double, 3>(view.weight + 2);
+        view.delta  = ConstArray<particle_float_t, dim>(i + 1);
+        view.v      = ConstArray<particle_float_t, 3>(view.weight + 2);
+        view.id     = 100 + i;
         EXPECT_EQ(std::copy(view), view);
+        EXPECT_EQ(std::copy(view).id, view.id);
     }
     EXPECT_EQ(contiguous.size(), size);
 
@@ -51,6 +57,7 @@ TYPED_TEST(ParticleListTest, SoAandAoSInterop)
         auto i = particleArray.size();
         particleArray.emplace_back(std::copy(view));
         EXPECT_EQ(contiguous[i], particleArray.back());
+        EXPECT_EQ(contiguous[i].id, particleArray.back().id);
     }
     EXPECT_EQ(particleArray.size(), size);
     EXPECT_EQ(contiguous.size(), particleArray.size());
@@ -60,7 +67,150 @@ TYPED_TEST(ParticleListTest, SoAandAoSInterop)
 
     std::size_t i = 0;
     for (auto const& particle : AoSFromSoA)
+    {
+        EXPECT_EQ(particle.id, particleArray[i].id);
         EXPECT_EQ(particle, particleArray[i++]);
+    }
+}
+
+TYPED_TEST(ParticleListTest, PackingByChunksOrFieldsGivesTheSameValuesAsPackingAll)
+{
+    using Particle             = TypeParam;
+    constexpr auto dim         = Particle::dimension;
+    constexpr std::size_t size = 10;
+    constexpr Box<int, dim> domain{ConstArray<int, dim>(0), ConstArray<int, dim>(size - 1)};
+
+    ParticleArray<dim> particleArray{domain};
+    for (std::size_t i = 0; i < size; i++)
+    {
+        Particle particle;
+        particle.weight = 1 + i;
+        particle.charge = 2 + i;
+        particle.iCell  = ConstArray<int, dim>(i);
+        particle.delta  = ConstArray<particle_float_t, dim>(.1 * i);
+        particle.v      = {{1. * i, 2. * i, 3. * i}};
+        particle.id     = 1000 + i;
+        particleArray.push_back(particle);
+    }
+
+    ContiguousParticles<dim> all{size};
+    ParticlePacker<dim> packer{particleArray};
+    packer.pack(all);
+
+    std::vector<std::vector<double>> expected; // per field
+    PHARE::core::apply(all.as_tuple(), [&](auto const& field) {
+        expected.emplace_back(field.begin(), field.end());
+    });
+
+    std::size_t nbrChunks = 0;
+    packer.pack_chunks(3, [&](auto const& chunk, std::size_t first, std::size_t count) {
+        EXPECT_EQ(chunk.size(), 3u);
+        EXPECT_EQ(count, std::min<std::size_t>(3, size - first));
+        std::size_t part_idx = 0;
+        PHARE::core::apply(chunk.as_tuple(), [&](auto const& field) {
+            auto const nbrComponents = field.size() / chunk.size();
+            for (std::size_t i = 0; i < count * nbrComponents; ++i)
+                EXPECT_EQ(field[i], expected[part_idx][first * nbrComponents + i]);
+            ++part_idx;
+        });
+        ++nbrChunks;
+    });
+    EXPECT_EQ(nbrChunks, 4u);
+
+    std::size_t part_idx = 0;
+    packer.pack_fields([&](auto const& key, auto const& values) {
+        EXPECT_EQ(key, packer.keys()[part_idx]);
+        EXPECT_EQ(std::vector<double>(values.begin(), values.end()), expected[part_idx]);
+        ++part_idx;
+    });
+    EXPECT_EQ(part_idx, 6u);
+}
+
+TYPED_TEST(ParticleListTest, PackingSelectedChunksOnlyCopiesSelectedParticles)
+{
+    using Particle             = TypeParam;
+    constexpr auto dim         = Particle::dimension;
+    constexpr std::size_t size = 20;
+    constexpr Box<int, dim> domain{ConstArray<int, dim>(0), ConstArray<int, dim>(size - 1)};
+
+    ParticleArray<dim> particleArray{domain};
+    for (std::size_t i = 0; i < size; i++)
+    {
+        Particle particle;
+        particle.weight = 1 + i;
+        particle.charge = 1;
+        particle.iCell  = ConstArray<int, dim>(i);
+        particle.delta  = ConstArray<particle_float_t, dim>(.5);
+        particle.v      = {{1. * i, 0., 0.}};
+        particleArray.push_back(particle);
+    }
+
+    ParticleSelector<dim> selector;
+    EXPECT_TRUE(selector.all());
+    EXPECT_EQ(selector.count(particleArray), size);
+
+    selector.stride    = 2;                                // 0, 2, 4, ..., 18
+    selector.minEnergy = 0.5 * 4 * 4;                      // v >= 4
+    selector.boxes.emplace_back(ConstArray<double, dim>(0), // position < 15
+                                ConstArray<double, dim>(15));
+    EXPECT_EQ(selector.count(particleArray), 6u); // 4, 6, ..., 14
+
+    std::vector<double> weights;
+    ParticlePacker<dim>{particleArray}.pack_chunks(
+        4, selector, [&](auto const& chunk, std::size_t first, std::size_t count) {
+            EXPECT_EQ(first, weights.size());
+            weights.insert(weights.end(), chunk.weight.begin(), chunk.weight.begin() + count);
+        });
+    EXPECT_EQ(weights, (std::vector<double>{5, 7, 9, 11, 13, 15}));
+
+    for (std::size_t i = 0; i < size; i++)
+        particleArray[i].id = derivedParticleId(1, i);
+
+    ParticleSelector<dim> sampler;
+    sampler.fraction = .5;
+    EXPECT_EQ(sampler(0, particleArray[3]), sampler(7, particleArray[3]));
+    EXPECT_GT(sampler.count(particleArray), 0u);
+    EXPECT_LT(sampler.count(particleArray), size);
+}
+
+
+TYPED_TEST(ParticleListTest, SamplingFollowsTheParticleIdNotItsState)
+{
+    using Particle             = TypeParam;
+    constexpr auto dim         = Particle::dimension;
+    constexpr std::size_t size = 1000;
+
+    std::vector<Particle> particles(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        particles[i].weight = 1;
+        particles[i].charge = 1;
+        particles[i].id     = derivedParticleId(42, i);
+    }
+
+    ParticleSelector<dim> sampler;
+    sampler.fraction = .25;
+
+    std::vector<bool> selected;
+    for (auto const& particle : particles)
+        selected.push_back(sampler(0, particle));
+
+    auto const nbrSelected = std::count(selected.begin(), selected.end(), true);
+    EXPECT_GT(nbrSelected, 0.2 * size);
+    EXPECT_LT(nbrSelected, 0.3 * size);
+
+    // pushed and refined particles, in another order, are selected as before
+    std::vector<std::size_t> order(size);
+    std::iota(order.rbegin(), order.rend(), 0);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        auto particle   = particles[order[idx]];
+        particle.weight = .125;
+        particle.iCell  = ConstArray<int, dim>(static_cast<int>(idx));
+        particle.delta  = ConstArray<particle_float_t, dim>(.75);
+        particle.v      = {{-1., 2., .5}};
+        EXPECT_EQ(sampler(idx, particle), selected[order[idx]]);
+    }
 }
 
 int main(int argc, char** argv)
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstddef>
 #include <fstream>
+#include <limits>
 #include <list>
 #include <random>
 
@@ -335,6 +336,132 @@ TYPED_TEST(A1DInterpolator, canComputeAllEMfieldsAtParticle)
 
 
 
+template<typename InterpolatorT>
+class ACollocatedGather : public ::testing::Test
+{
+public:
+    static constexpr auto dimension    = InterpolatorT::dimension;
+    static constexpr auto interp_order = InterpolatorT::interp_order;
+    static constexpr std::uint32_t nx  = 30;
+
+    using PHARE_TYPES     = PHARE::core::PHARE_Types<dimension, interp_order>;
+    using GridLayout_t    = typename PHARE_TYPES::GridLayout_t;
+    using NdArray_t       = typename PHARE_TYPES::Array_t;
+    using ParticleArray_t = typename PHARE_TYPES::ParticleArray_t;
+    using Field_t         = Field<NdArray_t, typename HybridQuantity::Scalar>;
+    using VF              = VecField<NdArray_t, HybridQuantity>;
+
+    GridLayout_t layout{ConstArray<double, dimension>(0.1),
+                        ConstArray<std::uint32_t, dimension>(nx),
+                        ConstArray<double, dimension>(0.)};
+    Electromag<VF> em{"EM"};
+    ParticleArray_t particles{layout.AMRBox()};
+
+    Field_t ex_{"EM_E_x", HybridQuantity::Scalar::Ex, layout.allocSize(HybridQuantity::Scalar::Ex)};
+    Field_t ey_{"EM_E_y", HybridQuantity::Scalar::Ey, layout.allocSize(HybridQuantity::Scalar::Ey)};
+    Field_t ez_{"EM_E_z", HybridQuantity::Scalar::Ez, layout.allocSize(HybridQuantity::Scalar::Ez)};
+    Field_t bx_{"EM_B_x", HybridQuantity::Scalar::Bx, layout.allocSize(HybridQuantity::Scalar::Bx)};
+    Field_t by_{"EM_B_y", HybridQuantity::Scalar::By, layout.allocSize(HybridQuantity::Scalar::By)};
+    Field_t bz_{"EM_B_z", HybridQuantity::Scalar::Bz, layout.allocSize(HybridQuantity::Scalar::Bz)};
+
+    static constexpr std::array<double, 4> deltas{0.05, 0.32, 0.5, 0.77};
+
+    // the B-spline stencils and the projection on primal nodes are both exact
+    // for linear profiles, so that both gather modes must agree with the profile
+    template<typename Position>
+    static double linear(Position const& position, std::size_t component)
+    {
+        double value = 1. + component;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            value += (2. + iDim) * position[iDim];
+        return value;
+    }
+
+    ACollocatedGather()
+    {
+        auto const origin = ConstArray<double, dimension>(0.);
+        std::size_t component = 0;
+        for (auto* field : {&ex_, &ey_, &ez_, &bx_, &by_, &bz_})
+        {
+            if constexpr (dimension == 1)
+                for (auto ix = 0u; ix < field->shape()[0]; ++ix)
+                    (*field)(ix)
+                        = linear(layout.fieldNodeCoordinates(*field, origin, ix), component);
+            if constexpr (dimension == 2)
+                for (auto ix = 0u; ix < field->shape()[0]; ++ix)
+                    for (auto iy = 0u; iy < field->shape()[1]; ++iy)
+                        (*field)(ix, iy) = linear(
+                            layout.fieldNodeCoordinates(*field, origin, ix, iy), component);
+            ++component;
+        }
+
+        em.E.setBuffer("EM_E_x", &ex_);
+        em.E.setBuffer("EM_E_y", &ey_);
+        em.E.setBuffer("EM_E_z", &ez_);
+        em.B.setBuffer("EM_B_x", &bx_);
+        em.B.setBuffer("EM_B_y", &by_);
+        em.B.setBuffer("EM_B_z", &bz_);
+
+        for (auto const& cell : layout.AMRBox())
+            for (std::size_t iDelta = 0; iDelta < deltas.size(); ++iDelta)
+            {
+                Particle<dimension> particle;
+                particle.iCell = cell.template toArray<int>();
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                    particle.delta[iDim] = deltas[(iDelta + iDim) % deltas.size()];
+                particles.push_back(particle);
+            }
+    }
+};
+
+using CollocatedGatherInterpolators
+    = ::testing::Types<Interpolator<1, 1>, Interpolator<1, 2>, Interpolator<1, 3>,
+                       Interpolator<2, 1>, Interpolator<2, 2>, Interpolator<2, 3>>;
+
+TYPED_TEST_SUITE(ACollocatedGather, CollocatedGatherInterpolators);
+
+
+
+TYPED_TEST(ACollocatedGather, givesSameFieldsAsStaggeredGatherForLinearProfiles)
+{
+    TypeParam staggered;
+    TypeParam collocated{FieldGather::collocated};
+
+    auto staggeredParticles  = this->particles;
+    auto collocatedParticles = this->particles;
+
+    staggered.prepareGather(this->em, this->layout);
+    collocated.prepareGather(this->em, this->layout);
+
+    staggered(makeIndexRange(staggeredParticles), this->em, this->layout);
+    collocated(makeIndexRange(collocatedParticles), this->em, this->layout);
+
+    for (std::size_t i = 0; i < this->particles.size(); ++i)
+    {
+        auto const& sPart = staggeredParticles[i];
+        auto const& cPart = collocatedParticles[i];
+        std::array<double, TestFixture::dimension> position;
+        for (std::size_t iDim = 0; iDim < position.size(); ++iDim)
+            position[iDim]
+                = (sPart.iCell[iDim] + sPart.delta[iDim]) * this->layout.meshSize()[iDim];
+
+        // deltas stored as particle_float_t are rounded to its epsilon
+        auto const expected  = this->linear(position, 0);
+        auto const tolerance
+            = 1e-12 + 4 * std::numeric_limits<particle_float_t>::epsilon() * std::abs(expected);
+
+        EXPECT_NEAR(sPart.Ex, expected, tolerance);
+        EXPECT_NEAR(cPart.Ex, expected, tolerance);
+        EXPECT_NEAR(cPart.Ey, sPart.Ey, tolerance);
+        EXPECT_NEAR(cPart.Ez, sPart.Ez, tolerance);
+        EXPECT_NEAR(cPart.Bx, sPart.Bx, tolerance);
+        EXPECT_NEAR(cPart.By, sPart.By, tolerance);
+        EXPECT_NEAR(cPart.Bz, sPart.Bz, tolerance);
+    }
+}
+
+
+
 template<typename InterpolatorT>
 class A2DInterpolator : public ::testing::Test
 {
@@ -800,7 +927,7 @@ struct ACollectionOfParticles_2d : public ::testing::Test
             {
                 auto& part  = particles.emplace_back();
                 part.iCell  = {i, j};
-                part.delta  = ConstArray<double, dim>(.5);
+                part.delta  = ConstArray<particle_float_t, dim>(.5);
                 part.weight = 1.;
                 part.v[0]   = +2.;
                 part.v[1]   = -1.;
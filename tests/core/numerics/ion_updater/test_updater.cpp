@@ -940,6 +940,51 @@ TYPED_TEST(IonUpdaterTest, momentsAreChangedInMomentsOnlyMode)
 
 
 
+TYPED_TEST(IonUpdaterTest, depositingWhilePushingGivesSameMomentsAsDepositingAfter)
+{
+    using IonUpdater = typename IonUpdaterTest<TypeParam>::IonUpdater;
+
+    // population control disables the fused push and deposit, it is given bounds
+    // that no cell reaches so that particles are left untouched
+    PHARE::initializer::PHAREDict unfusedDict;
+    unfusedDict["pusher"]["name"]                   = std::string{"modified_boris"};
+    unfusedDict["population_control"]["target_ppc"] = int{2};
+    unfusedDict["population_control"]["max_ppc"]    = int{100 * nbrPartPerCell};
+    IonUpdater fusedUpdater{init_dict["simulation"]["algo"]["ion_updater"]};
+    IonUpdater unfusedUpdater{unfusedDict};
+
+    IonsBuffers ionsBufferCpy{this->ionsBuffers, this->layout};
+    typename IonUpdaterTest<TypeParam>::Ions unfusedIons{init_dict["ions"]};
+    ionsBufferCpy.setBuffers(unfusedIons);
+
+    fusedUpdater.updatePopulations(this->ions, this->EM, this->layout, this->dt, UpdaterMode::all);
+    unfusedUpdater.updatePopulations(unfusedIons, this->EM, this->layout, this->dt,
+                                     UpdaterMode::all);
+
+    auto ix0 = this->layout.physicalStartIndex(QtyCentering::primal, Direction::X);
+    auto ix1 = this->layout.physicalEndIndex(QtyCentering::primal, Direction::X);
+
+    auto check = [&](auto const& fused, auto const& unfused) {
+        for (auto ix = ix0; ix <= ix1; ++ix)
+            EXPECT_NEAR(fused(ix), unfused(ix), 1e-12 * (1. + std::abs(unfused(ix))));
+    };
+
+    auto& fusedPops   = this->ions.getRunTimeResourcesUserList();
+    auto& unfusedPops = unfusedIons.getRunTimeResourcesUserList();
+    for (std::size_t iPop = 0; iPop < fusedPops.size(); ++iPop)
+    {
+        EXPECT_EQ(fusedPops[iPop].domainParticles().size(),
+                  unfusedPops[iPop].domainParticles().size());
+
+        check(fusedPops[iPop].density(), unfusedPops[iPop].density());
+        for (auto component : {Component::X, Component::Y, Component::Z})
+            check(fusedPops[iPop].flux().getComponent(component),
+                  unfusedPops[iPop].flux().getComponent(component));
+    }
+}
+
+
+
 TYPED_TEST(IonUpdaterTest, thatNoNaNsExistOnPhysicalNodesMoments)
 {
     typename IonUpdaterTest<TypeParam>::IonUpdater ionUpdater{
@@ -2,12 +2,16 @@
 #include "gtest/gtest.h"
 
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "core/data/particles/particle_array.hpp"
@@ -87,6 +91,27 @@ public:
 };
 
 
+// mock of an Interpolator giving a uniform magnetic field and no electric field
+// in which case the Boris pusher must conserve the particle kinetic energy
+class MagneticInterpolator
+{
+public:
+    template<typename ParticleRange, typename Electromag, typename GridLayout>
+    void operator()(ParticleRange particles, Electromag const&, GridLayout&)
+    {
+        for (auto currPart = std::begin(particles); currPart != std::end(particles); ++currPart)
+        {
+            currPart->Ex = 0.;
+            currPart->Ey = 0.;
+            currPart->Ez = 0.;
+            currPart->Bx = 0.3;
+            currPart->By = -0.7;
+            currPart->Bz = 1.;
+        }
+    }
+};
+
+
 // mock of electromag just so that the Pusher gives something to
 // the Interpolator
 class Electromag
@@ -161,6 +186,13 @@ protected:
 
     std::array<std::vector<float>, dim> actual;
     std::array<double, dim> dxyz;
+
+    // the reference integration error, plus the rounding of the deltas stored as
+    // particle_float_t, which accumulates over the steps
+    double trajectoryTolerance() const
+    {
+        return 1e-5 + nt * std::numeric_limits<particle_float_t>::epsilon() * dxyz[0];
+    }
 };
 
 
@@ -190,9 +222,10 @@ TEST_F(APusher3D, trajectoryIsOk)
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(actual[0], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
-    EXPECT_THAT(actual[1], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.y));
-    EXPECT_THAT(actual[2], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.z));
+    auto const near = ::testing::DoubleNear(trajectoryTolerance());
+    EXPECT_THAT(actual[0], ::testing::Pointwise(near, expectedTrajectory.x));
+    EXPECT_THAT(actual[1], ::testing::Pointwise(near, expectedTrajectory.y));
+    EXPECT_THAT(actual[2], ::testing::Pointwise(near, expectedTrajectory.z));
 }
 
 
@@ -218,8 +251,9 @@ TEST_F(APusher2D, trajectoryIsOk)
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(actual[0], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
-    EXPECT_THAT(actual[1], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.y));
+    auto const near = ::testing::DoubleNear(trajectoryTolerance());
+    EXPECT_THAT(actual[0], ::testing::Pointwise(near, expectedTrajectory.x));
+    EXPECT_THAT(actual[1], ::testing::Pointwise(near, expectedTrajectory.y));
 }
 
 
@@ -240,7 +274,86 @@ TEST_F(APusher1D, trajectoryIsOk)
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(actual[0], ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
+    auto const near = ::testing::DoubleNear(trajectoryTolerance());
+    EXPECT_THAT(actual[0], ::testing::Pointwise(near, expectedTrajectory.x));
+}
+
+
+
+// relative kinetic energy drift of a particle pushed nt times in a uniform magnetic field
+// particles deltas and velocities may be stored in float (PHARE_PARTICLE_FLOATS)
+// while the pusher computes in double
+double magneticKineticEnergyDrift()
+{
+    using Pusher_ = BorisPusher<1, IndexRange<ParticleArray<1>>, Electromag, MagneticInterpolator,
+                                BoundaryCondition<1, 1>, DummyLayout<1>>;
+
+    DummyLayout<1> layout;
+    ParticleArray<1> particlesIn{layout.AMRBox()};
+    ParticleArray<1> particlesOut{layout.AMRBox()};
+    particlesIn.emplace_back(Particle<1>{1., 1., {5}, {0.3}, {1.2, -0.4, 0.7}});
+    particlesOut.emplace_back(Particle<1>{1., 1., {5}, {0.3}, {1.2, -0.4, 0.7}});
+
+    Pusher_ pusher;
+    pusher.setMeshAndTimeStep({0.05}, 0.001);
+
+    Electromag em;
+    MagneticInterpolator interpolator;
+    DummySelector selector;
+
+    auto kineticEnergy = [](auto const& particle) {
+        double energy = 0;
+        for (auto const vi : particle.v)
+            energy += static_cast<double>(vi) * vi;
+        return 0.5 * particle.weight * energy;
+    };
+
+    auto const energy0 = kineticEnergy(particlesIn[0]);
+
+    auto rangeIn  = makeIndexRange(particlesIn);
+    auto rangeOut = makeIndexRange(particlesOut);
+
+    std::size_t const nt = 10000;
+    for (std::size_t i = 0; i < nt; ++i)
+    {
+        pusher.move(rangeIn, rangeOut, em, 1., interpolator, layout, selector, selector);
+        std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
+    }
+
+    return std::abs(kineticEnergy(particlesIn[0]) - energy0) / energy0;
+}
+
+
+// the energy drift must stay at the level of the storage precision
+TEST(APusherInAMagneticField, conservesKineticEnergy)
+{
+    auto const tolerance = std::is_same_v<particle_float_t, float> ? 1e-4 : 1e-10;
+
+    EXPECT_LT(magneticKineticEnergyDrift(), tolerance);
+}
+
+
+// the double build (test-pusher) writes its drift, which the float build (test-pusher-float)
+// compares to its own, see CMakeLists.txt
+TEST(APusherInAMagneticField, driftsInFloatAsInDouble)
+{
+    auto const drift = magneticKineticEnergyDrift();
+    std::string const driftFile{"pusher_double_energy_drift.txt"};
+
+    if constexpr (!std::is_same_v<particle_float_t, float>)
+    {
+        std::ofstream{driftFile} << std::setprecision(17) << drift;
+        return;
+    }
+
+    double doubleDrift = 0;
+    std::ifstream file{driftFile};
+    if (!(file >> doubleDrift))
+        GTEST_SKIP() << "no drift of a double build in " << driftFile;
+
+    // float storage adds the rounding of the velocity at each of the 10000 steps, a random
+    // walk of about sqrt(10000) epsilons (3.9e-6 against 2.6e-12 in double when written)
+    EXPECT_NEAR(doubleDrift, drift, 4 * std::sqrt(1e4) * std::numeric_limits<float>::epsilon());
 }
 
 
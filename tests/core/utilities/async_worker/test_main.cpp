@@ -0,0 +1,74 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/utilities/async_worker.hpp"
+
+
+using namespace PHARE::core;
+
+
+
+TEST(AsyncWorker, runsTasksInSubmissionOrder)
+{
+    std::vector<int> order;
+    {
+        AsyncWorker worker;
+        for (int i = 0; i < 10; ++i)
+            worker.submit([&order, i]() { order.push_back(i); });
+    } // destructor drains
+
+    ASSERT_EQ(10u, order.size());
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(i, order[i]);
+}
+
+
+
+TEST(AsyncWorker, submitWaitsForThePreviousTask)
+{
+    std::atomic<bool> release{false};
+    std::atomic<int> nbrDone{0};
+
+    AsyncWorker worker;
+    worker.submit([&]() {
+        while (!release)
+            std::this_thread::yield();
+        ++nbrDone;
+    });
+    EXPECT_TRUE(worker.busy());
+
+    std::thread submitter{[&]() { worker.submit([&]() { ++nbrDone; }); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(0, nbrDone);
+
+    release = true;
+    submitter.join();
+    worker.wait();
+    EXPECT_EQ(2, nbrDone);
+    EXPECT_FALSE(worker.busy());
+}
+
+
+
+TEST(AsyncWorker, rethrowsTaskErrorsOnWait)
+{
+    AsyncWorker worker;
+    worker.submit([]() { throw std::runtime_error("write failed"); });
+    EXPECT_THROW(worker.wait(), std::runtime_error);
+    EXPECT_NO_THROW(worker.wait());
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
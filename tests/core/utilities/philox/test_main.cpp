@@ -0,0 +1,100 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "core/utilities/philox.hpp"
+
+
+using namespace PHARE::core;
+
+
+
+// known answers of the Random123 implementation of Philox4x32-10
+TEST(Philox, matchesTheReferenceImplementation)
+{
+    EXPECT_EQ((Philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}),
+              Philox::generate({0, 0, 0, 0}, {0, 0}));
+
+    EXPECT_EQ((Philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}),
+              Philox::generate({~0u, ~0u, ~0u, ~0u}, {~0u, ~0u}));
+
+    EXPECT_EQ((Philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}),
+              Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                               {0xa4093822, 0x299f31d0}));
+}
+
+
+
+TEST(CounterStream, drawsTheSameNumbersForTheSameCounter)
+{
+    CounterStream first{{1, 2}, {3, 4, 5, 0}}, second{{1, 2}, {3, 4, 5, 0}};
+    for (std::size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(first.normal(), second.normal());
+}
+
+
+
+TEST(CounterStream, drawsUniformAndNormalNumbers)
+{
+    std::size_t constexpr size = 100000;
+    CounterStream stream{{1337, 0}, {0, 0, 0, 0}};
+
+    double sum = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto const value = stream.uniform();
+        EXPECT_TRUE(value >= 0 and value < 1);
+        sum += value;
+    }
+    EXPECT_NEAR(0.5, sum / size, 0.01);
+
+    double mean = 0, variance = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto const value = stream.normal();
+        mean += value;
+        variance += value * value;
+    }
+    EXPECT_NEAR(0., mean / size, 0.01);
+    EXPECT_NEAR(1., variance / size, 0.02);
+}
+
+
+
+TEST(Philox, drawsANormalPerUniformNumberByPairingTheHalvesOfTheArray)
+{
+    for (std::size_t const size : {std::size_t{6}, std::size_t{7}})
+    {
+        CounterStream stream{{7, 0}, {0, 0, 0, 0}};
+        std::vector<double> u(size), normals(size), cosines(size / 2), sines(size / 2);
+        for (auto& value : u)
+            value = stream.uniform();
+        auto const uLast = stream.uniform();
+
+        Philox::boxMuller(u.data(), uLast, normals.data(), size);
+
+        Philox::boxMuller(u.data(), u.data() + size / 2, cosines.data(), sines.data(), size / 2);
+        for (std::size_t i = 0; i < size / 2; ++i)
+        {
+            EXPECT_EQ(cosines[i], normals[i]);
+            EXPECT_EQ(sines[i], normals[i + size / 2]);
+        }
+        if (size % 2 == 1)
+        {
+            double last, unused;
+            Philox::boxMuller(&u.back(), &uLast, &last, &unused, 1);
+            EXPECT_EQ(last, normals.back());
+        }
+    }
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
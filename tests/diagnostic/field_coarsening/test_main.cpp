@@ -0,0 +1,134 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "core/data/field/field.hpp"
+#include "core/data/grid/gridlayout.hpp"
+#include "core/data/grid/gridlayout_impl.hpp"
+#include "core/data/ndarray/ndarray_vector.hpp"
+#include "diagnostic/detail/field_coarsening.hpp"
+
+
+using namespace PHARE::core;
+using PHARE::diagnostic::FieldCoarsening;
+
+using GridLayout1D = GridLayout<GridLayoutImplYee<1, 1>>;
+using GridLayout2D = GridLayout<GridLayoutImplYee<2, 1>>;
+using Field1D      = Field<NdArrayVector<1>, HybridQuantity::Scalar>;
+using Field2D      = Field<NdArrayVector<2>, HybridQuantity::Scalar>;
+
+static constexpr auto rho = HybridQuantity::Scalar::rho; // primal
+static constexpr auto Ex  = HybridQuantity::Scalar::Ex;  // dual along x
+
+
+
+// the weights of a stencil are symmetric and sum to 1, so that coarsening a field linear in
+// its local index gives the value at the center of the stencil
+class AFieldCoarsening1D : public ::testing::Test
+{
+protected:
+    GridLayout1D layout{{{.1}}, {{10}}, Point{0.}};
+    Field1D density{"density", rho, layout.allocSize(rho)};
+    Field1D electric{"Ex", Ex, layout.allocSize(Ex)};
+
+    AFieldCoarsening1D()
+    {
+        for (auto* field : {&density, &electric})
+            for (std::uint32_t i = 0; i < field->shape()[0]; ++i)
+                (*field)(i) = i;
+    }
+};
+
+
+TEST_F(AFieldCoarsening1D, withARatioOfOneGivesThePhysicalNodes)
+{
+    for (auto* field : {&density, &electric})
+    {
+        FieldCoarsening<GridLayout1D> const coarsening{*field, 1};
+        auto const start = layout.physicalStartIndex(*field, Direction::X);
+        auto const end   = layout.physicalEndIndex(*field, Direction::X);
+
+        std::vector<double> expected;
+        for (auto i = start; i <= end; ++i)
+            expected.push_back(i);
+        EXPECT_THAT(coarsening.shape(), ::testing::ElementsAre(end - start + 1));
+        EXPECT_THAT(coarsening(*field), ::testing::ElementsAreArray(expected));
+    }
+}
+
+
+TEST_F(AFieldCoarsening1D, hasACoarseNodePerRatioFineCells)
+{
+    // 10 cells coarsened by 2 are 5 cells, 6 primal nodes, 5 dual nodes
+    EXPECT_THAT((FieldCoarsening<GridLayout1D>{density, 2}.shape()), ::testing::ElementsAre(6));
+    EXPECT_THAT((FieldCoarsening<GridLayout1D>{electric, 2}.shape()), ::testing::ElementsAre(5));
+
+    // an incomplete last coarse cell counts
+    EXPECT_THAT((FieldCoarsening<GridLayout1D>{density, 3}.shape()), ::testing::ElementsAre(5));
+    EXPECT_THAT((FieldCoarsening<GridLayout1D>{electric, 3}.shape()), ::testing::ElementsAre(4));
+}
+
+
+TEST_F(AFieldCoarsening1D, primalNodesAreCenteredOnTheirFineNode)
+{
+    auto const start  = layout.physicalStartIndex(density, Direction::X);
+    auto const values = FieldCoarsening<GridLayout1D>{density, 2}(density);
+
+    ASSERT_EQ(6u, values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        EXPECT_DOUBLE_EQ(start + 2. * i, values[i]);
+}
+
+
+TEST_F(AFieldCoarsening1D, dualNodesAreCenteredOnTheirFineCells)
+{
+    auto const start  = layout.physicalStartIndex(electric, Direction::X);
+    auto const values = FieldCoarsening<GridLayout1D>{electric, 2}(electric);
+
+    ASSERT_EQ(5u, values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        EXPECT_DOUBLE_EQ(start + 2. * i + .5, values[i]);
+}
+
+
+TEST_F(AFieldCoarsening1D, keepsAConstantFieldConstantBeyondTheGhosts)
+{
+    for (std::uint32_t i = 0; i < density.shape()[0]; ++i)
+        density(i) = 3.;
+
+    for (std::size_t ratio : {2, 3, 4, 7})
+        for (auto const value : FieldCoarsening<GridLayout1D>{density, ratio}(density))
+            EXPECT_DOUBLE_EQ(3., value);
+}
+
+
+
+
+TEST(AFieldCoarsening2D, givesTheCoarseNodesInRowMajorOrder)
+{
+    GridLayout2D layout{{{.1, .1}}, {{4, 6}}, Point{0., 0.}};
+    Field2D density{"density", rho, layout.allocSize(rho)};
+    for (std::uint32_t i = 0; i < density.shape()[0]; ++i)
+        for (std::uint32_t j = 0; j < density.shape()[1]; ++j)
+            density(i, j) = i + 100. * j;
+
+    FieldCoarsening<GridLayout2D> const coarsening{density, 2};
+    auto const values = coarsening(density);
+    auto const startX = layout.physicalStartIndex(density, Direction::X);
+    auto const startY = layout.physicalStartIndex(density, Direction::Y);
+
+    EXPECT_THAT(coarsening.shape(), ::testing::ElementsAre(3, 4));
+    ASSERT_EQ(12u, values.size());
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+            EXPECT_DOUBLE_EQ((startX + 2. * i) + 100. * (startY + 2. * j), values[i * 4 + j]);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
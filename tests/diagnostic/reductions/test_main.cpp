@@ -0,0 +1,178 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "core/data/field/field.hpp"
+#include "core/data/grid/gridlayout.hpp"
+#include "core/data/grid/gridlayout_impl.hpp"
+#include "core/data/ndarray/ndarray_vector.hpp"
+#include "core/data/particles/particle.hpp"
+#include "core/utilities/box/box.hpp"
+#include "diagnostic/detail/reductions.hpp"
+
+
+using namespace PHARE::core;
+using PHARE::diagnostic::Reduction;
+
+using GridLayout1D = GridLayout<GridLayoutImplYee<1, 1>>;
+using GridLayout2D = GridLayout<GridLayoutImplYee<2, 1>>;
+using Field2D      = Field<NdArrayVector<2>, HybridQuantity::Scalar>;
+
+
+
+// 10 cells of width 0.5, one particle per cell from cell 0 to cell 4
+class AHistogram : public ::testing::Test
+{
+protected:
+    GridLayout1D layout{{{0.5}}, {{10}}, Point{0.}, Box<int, 1>{Point{0}, Point{9}}};
+    std::vector<Particle<1>> particles{
+        {1., 1., {{0}}, {{.5}}, {{-1.5, 0., 0.}}}, //
+        {2., 1., {{1}}, {{.5}}, {{-.5, 0., 0.}}},  //
+        {3., 1., {{6}}, {{.5}}, {{.5, 0., 0.}}},   //
+        {4., 1., {{3}}, {{.5}}, {{1.75, 0., 0.}}}, //
+        {5., 1., {{4}}, {{.5}}, {{2.5, 0., 0.}}},  // beyond all ranges
+    };
+
+    Reduction<1> reduction_(std::vector<std::string> axes, std::vector<std::size_t> bins,
+                            std::vector<double> lower, std::vector<double> upper)
+    {
+        Reduction<1> reduction;
+        reduction.kind  = "histogram";
+        reduction.axes  = axes;
+        reduction.bins  = bins;
+        reduction.lower = lower;
+        reduction.upper = upper;
+        reduction.sums.resize(product(bins, std::size_t{1}), 0);
+        reduction.counts.resize(reduction.sums.size(), 0);
+        return reduction;
+    }
+};
+
+
+TEST_F(AHistogram, sumsTheWeightsOfTheParticlesOfEachBin)
+{
+    auto reduction = reduction_({"vx"}, {4}, {-2.}, {2.});
+    reduction.histogram(layout, particles, 1.);
+
+    EXPECT_THAT(reduction.sums, ::testing::ElementsAre(1., 2., 3., 4.));
+}
+
+
+TEST_F(AHistogram, flattensTheBinsOfSeveralAxesInRowMajorOrder)
+{
+    // energy = 0.5 * mass * vx^2 = vx^2 for a mass of 2
+    // (x, energy) = (0.25, 2.25), (0.75, 0.25), (3.25, 0.25), (1.75, 3.0625), (2.25, 6.25)
+    auto reduction = reduction_({"x", "energy"}, {2, 2}, {0., 0.}, {5., 4.});
+    reduction.histogram(layout, particles, 2.);
+
+    EXPECT_THAT(reduction.sums, ::testing::ElementsAre(2., 1. + 4., 3., 0.));
+}
+
+
+TEST_F(AHistogram, onlyCountsTheParticlesWithinItsBox)
+{
+    auto reduction = reduction_({"vx"}, {4}, {-2.}, {2.});
+    reduction.box  = std::make_pair(std::vector<double>{0.}, std::vector<double>{3.});
+    reduction.histogram(layout, particles, 1.);
+
+    EXPECT_THAT(reduction.sums, ::testing::ElementsAre(1., 2., 0., 4.));
+}
+
+
+TEST_F(AHistogram, isAveragedOverTheComputes)
+{
+    auto reduction = reduction_({"vx"}, {4}, {-2.}, {2.});
+    for (reduction.nbrComputes = 0; reduction.nbrComputes < 2; ++reduction.nbrComputes)
+        reduction.histogram(layout, particles, 1.);
+    reduction.average(reduction.sums, reduction.counts);
+
+    EXPECT_THAT(reduction.values, ::testing::ElementsAre(1., 2., 3., 4.));
+}
+
+
+
+
+// density(ix, iy) = ix + 10 * iy at the local indexes of two 2D patches side by side along x,
+// covering AMR cells [0, 3] x [0, 3] and [4, 5] x [0, 3], the domain being 8 cells wide
+class AFieldReduction : public ::testing::Test
+{
+protected:
+    static constexpr auto rho = HybridQuantity::Scalar::rho;
+
+    GridLayout2D layout0{{{.5, .5}}, {{4, 4}}, Point{0., 0.}, Box<int, 2>{{0, 0}, {3, 3}}};
+    GridLayout2D layout1{{{.5, .5}}, {{2, 4}}, Point{2., 0.}, Box<int, 2>{{4, 0}, {5, 3}}};
+    Field2D density0{"density", rho, layout0.allocSize(rho)};
+    Field2D density1{"density", rho, layout1.allocSize(rho)};
+
+    AFieldReduction()
+    {
+        for (auto* density : {&density0, &density1})
+            for (std::uint32_t ix = 0; ix < density->shape()[0]; ++ix)
+                for (std::uint32_t iy = 0; iy < density->shape()[1]; ++iy)
+                    (*density)(ix, iy) = ix + 10. * iy;
+    }
+
+    // value at the AMR cell of a patch, rho being primal its first node
+    static double valueAt(GridLayout2D const& layout, int amrX, int amrY)
+    {
+        auto const startX = layout.physicalStartIndex(rho, Direction::X);
+        auto const startY = layout.physicalStartIndex(rho, Direction::Y);
+        auto const& lower = layout.AMRBox().lower;
+        return (startX + amrX - lower[0]) + 10. * (startY + amrY - lower[1]);
+    }
+};
+
+
+TEST_F(AFieldReduction, boxAverageIsTheMeanOverTheCellsWithinTheBox)
+{
+    Reduction<2> reduction;
+    reduction.kind = "box_average";
+    reduction.box  = std::make_pair(std::vector<double>{0., 0.}, std::vector<double>{1., 1.});
+    reduction.sums.resize(1, 0);
+    reduction.counts.resize(1, 0);
+
+    reduction.fieldCells(layout0, density0);
+    reduction.fieldCells(layout1, density1); // out of the box
+    reduction.nbrComputes = 1;
+    reduction.average(reduction.sums, reduction.counts);
+
+    auto const expected
+        = (valueAt(layout0, 0, 0) + valueAt(layout0, 1, 0) + valueAt(layout0, 0, 1)
+           + valueAt(layout0, 1, 1))
+          / 4;
+    EXPECT_EQ(4., reduction.counts[0]);
+    EXPECT_DOUBLE_EQ(expected, reduction.values[0]);
+}
+
+
+TEST_F(AFieldReduction, lineCutHasTheValuesAlongTheLineAndNaNWhereNoPatchIs)
+{
+    Reduction<2> reduction;
+    reduction.kind     = "line_cut";
+    reduction.cutAxis  = 0;
+    reduction.position = {0., 1.25}; // center of the cells of AMR index 2 along y
+    reduction.sums.resize(8, 0);
+    reduction.counts.resize(8, 0);
+
+    reduction.fieldCells(layout0, density0);
+    reduction.fieldCells(layout1, density1);
+    reduction.nbrComputes = 1;
+    reduction.average(reduction.sums, reduction.counts);
+
+    for (int amrX = 0; amrX < 4; ++amrX)
+        EXPECT_DOUBLE_EQ(valueAt(layout0, amrX, 2), reduction.values[amrX]);
+    for (int amrX = 4; amrX < 6; ++amrX)
+        EXPECT_DOUBLE_EQ(valueAt(layout1, amrX, 2), reduction.values[amrX]);
+    EXPECT_TRUE(std::isnan(reduction.values[6]));
+    EXPECT_TRUE(std::isnan(reduction.values[7]));
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -246,6 +246,7 @@ void validateParticleDump(Simulator& sim, Hi5Diagnostic& hi5)
         auto vV      = hifile.template read_data_set_flat<float, 2>(path + "v");
         auto iCellV  = hifile.template read_data_set_flat<float, 2>(path + "iCell");
         auto deltaV  = hifile.template read_data_set_flat<float, 2>(path + "delta");
+        auto idV     = hifile.template read_data_set_flat<std::uint64_t, 2>(path + "id");
 
         core::ParticlePacker packer{particles};
 
@@ -267,6 +268,8 @@ void validateParticleDump(Simulator& sim, Hi5Diagnostic& hi5)
             for (std::size_t i = 0; i < vSize; i++)
                 EXPECT_FLOAT_EQ(vV[(part_idx * vSize) + i], std::get<4>(next)[i]);
 
+            EXPECT_EQ(idV[part_idx], std::get<5>(next));
+
             part_idx++;
         }
     };
@@ -0,0 +1,174 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "hdf5/detail/h5/h5_metadata.hpp"
+
+
+using PHARE::hdf5::h5::MetadataBatch;
+
+using AttributeValue
+    = std::variant<float, double, int, std::uint32_t, std::size_t, std::string, std::vector<float>,
+                   std::vector<double>, std::vector<int>, std::vector<std::uint32_t>,
+                   std::vector<std::size_t>, std::vector<std::string>>;
+
+struct UnpackedDataSet
+{
+    std::string path;
+    std::vector<std::size_t> shape;
+    MetadataBatch::Type type;
+};
+
+struct UnpackedAttribute
+{
+    std::string path, key;
+    AttributeValue value;
+};
+
+
+// records the descriptors in the order unpack visits them
+struct Unpacked
+{
+    Unpacked(MetadataBatch const& batch)
+    {
+        auto const& buffer = batch.buffer();
+        MetadataBatch::unpack(
+            buffer.data(), buffer.size(),
+            [&](auto const& path, auto const& shape, auto value) {
+                dataSets.push_back(
+                    {path, shape, MetadataBatch::type_for<decltype(value)>()});
+                order.push_back(MetadataBatch::Kind::dataset);
+            },
+            [&](auto const& path, auto const& key, auto const& value) {
+                attributes.push_back({path, key, AttributeValue{value}});
+                order.push_back(MetadataBatch::Kind::attribute);
+            });
+    }
+
+    std::vector<UnpackedDataSet> dataSets;
+    std::vector<UnpackedAttribute> attributes;
+    std::vector<MetadataBatch::Kind> order;
+};
+
+
+
+TEST(AMetadataBatch, isEmptyUntilSomethingIsAdded)
+{
+    MetadataBatch batch;
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(Unpacked{batch}.order.empty());
+
+    batch.add_data_set<double>("/t/p0/rho", 10);
+    EXPECT_FALSE(batch.empty());
+}
+
+
+
+TEST(AMetadataBatch, unpacksDataSetsOfEverySupportedTypeAndShape)
+{
+    using Type = MetadataBatch::Type;
+
+    MetadataBatch batch;
+    batch.add_data_set<float>("/float", 3);
+    batch.add_data_set<double>("/double", std::array<std::size_t, 2>{4, 5});
+    batch.add_data_set<int>("/int", std::vector<int>{6, 7, 8});
+    batch.add_data_set<std::uint32_t>("/uint32", std::size_t{0});
+    batch.add_data_set<std::size_t>("/size_t", std::vector<std::size_t>{9, 1});
+
+    Unpacked const unpacked{batch};
+    EXPECT_TRUE(unpacked.attributes.empty());
+    ASSERT_EQ(5u, unpacked.dataSets.size());
+
+    auto expect = [&](std::size_t i, std::string const& path,
+                      std::vector<std::size_t> const& shape, Type type) {
+        auto const& dataSet = unpacked.dataSets[i];
+        EXPECT_EQ(path, dataSet.path);
+        EXPECT_THAT(dataSet.shape, ::testing::ElementsAreArray(shape));
+        EXPECT_EQ(type, dataSet.type);
+    };
+    expect(0, "/float", {3}, Type::Float);
+    expect(1, "/double", {4, 5}, Type::Double);
+    expect(2, "/int", {6, 7, 8}, Type::Int);
+    expect(3, "/uint32", {0}, Type::UInt32);
+    expect(4, "/size_t", {9, 1}, Type::SizeT);
+}
+
+
+
+TEST(AMetadataBatch, unpacksAttributesOfEverySupportedType)
+{
+    std::vector<AttributeValue> const values{
+        1.5f,
+        std::numeric_limits<double>::min(),
+        -3,
+        std::numeric_limits<std::uint32_t>::max(),
+        std::numeric_limits<std::size_t>::max(),
+        std::string{"domain"},
+        std::vector<float>{0.25f, -1.f},
+        std::vector<double>{0.1, 0.2, 0.3},
+        std::vector<int>{-1, 0, 1},
+        std::vector<std::uint32_t>{2, 3},
+        std::vector<std::size_t>{},
+        std::vector<std::string>{"protons", "", "alpha"},
+    };
+
+    MetadataBatch batch;
+    for (std::size_t i = 0; i < values.size(); ++i)
+        std::visit(
+            [&](auto const& value) { batch.add_attribute("/", "key" + std::to_string(i), value); },
+            values[i]);
+
+    Unpacked const unpacked{batch};
+    EXPECT_TRUE(unpacked.dataSets.empty());
+    ASSERT_EQ(values.size(), unpacked.attributes.size());
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        auto const& attribute = unpacked.attributes[i];
+        EXPECT_EQ("/", attribute.path);
+        EXPECT_EQ("key" + std::to_string(i), attribute.key);
+        EXPECT_EQ(values[i].index(), attribute.value.index()) << "attribute " << i;
+        EXPECT_TRUE(values[i] == attribute.value) << "attribute " << i;
+    }
+}
+
+
+
+TEST(AMetadataBatch, keepsTheOrderOfInterleavedDescriptors)
+{
+    using Kind = MetadataBatch::Kind;
+
+    MetadataBatch batch;
+    batch.add_attribute("/t", "time", 0.5);
+    batch.add_data_set<float>("/t/p0/v", std::array<std::size_t, 2>{12, 3});
+    batch.add_attribute("/t/p0", "lower", std::vector<int>{0, 4});
+    batch.add_data_set<double>("/t/p0/w", 12);
+
+    Unpacked const unpacked{batch};
+    EXPECT_THAT(unpacked.order, ::testing::ElementsAre(Kind::attribute, Kind::dataset,
+                                                       Kind::attribute, Kind::dataset));
+
+    ASSERT_EQ(2u, unpacked.dataSets.size());
+    EXPECT_EQ("/t/p0/v", unpacked.dataSets[0].path);
+    EXPECT_EQ("/t/p0/w", unpacked.dataSets[1].path);
+
+    ASSERT_EQ(2u, unpacked.attributes.size());
+    EXPECT_EQ("/t/p0", unpacked.attributes[1].path);
+    EXPECT_EQ("lower", unpacked.attributes[1].key);
+    AttributeValue const lower = std::vector<int>{0, 4};
+    EXPECT_TRUE(lower == unpacked.attributes[1].value);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
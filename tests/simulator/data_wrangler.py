@@ -33,14 +33,62 @@ class DataWranglerTest(unittest.TestCase):
             print("\n", self.dw.lvl0PopFluxes())
             print("\n", self.dw.lvl0EM())
 
+            for patch in self.dw.getPatchLevel(0).getDensity():
+                self.assertTrue(isinstance(patch.data, np.ndarray))
+                self.assertFalse(patch.data.flags.writeable)
+            for patch in self.dw.getPatchLevel(0).getDensity(copy=True):
+                self.assertTrue(patch.data.flags.writeable)
+
+            # views show the live values of the fields
+            views = self.dw.getPatchLevel(0).getBx()
+            self.simulator.advance()
+            for view, copy in zip(views, self.dw.getPatchLevel(0).getBx(copy=True)):
+                np.testing.assert_array_equal(view.data, copy.data)
+
             for pop, particles in self.dw.getPatchLevel(0).getParticles().items():
                 for key, patches in particles.items():
                     for patch in patches:
                         self.assertTrue(isinstance(patch.lower, np.ndarray))
                         self.assertTrue(isinstance(patch.upper, np.ndarray))
 
+            level = self.dw.getPatchLevel(0)
+            contiguous = level.getParticles("protons")["protons"]["domain"]
+            arrays = level.getParticles("protons", "domain")
+            for patch, patch_arrays in zip(contiguous, arrays):
+                particles = patch_arrays.data
+                self.assertEqual(particles["weight"].size, patch.data.size())
+                self.assertEqual(particles["v"].shape, (patch.data.size(), 3))
+                np.testing.assert_array_equal(particles["iCell"].flatten(), patch.data.iCell)
+
+                lower = patch.lower.astype(int)
+                in_box = level.getParticles("protons", "domain", box=(lower, lower))
+                in_box = [p.data for p in in_box if p.patchID == patch.patchID][0]
+                self.assertTrue((in_box["iCell"] == lower[0]).all())
+                self.assertEqual(in_box["weight"].size, (particles["iCell"] == lower[0]).sum())
+                strided = level.getParticles("protons", "domain", stride=3)
+                strided = [p.data for p in strided if p.patchID == patch.patchID][0]
+                np.testing.assert_array_equal(strided["weight"], particles["weight"][::3])
+
             self.simulator = None
 
+    def test_2d_merge_on_root(self):
+
+        self.simulator = Simulator(populate_simulation(2, 1, cells=20))
+        self.simulator.initialize()
+        self.dw = self.simulator.data_wrangler()
+
+        density = self.dw.lvl0IonDensity(root=0)
+        Bx = self.dw.lvl0EM(root=0)["EM_B"]["EM_B_x"]
+        if cpp.mpi_rank() == 0:
+            self.assertEqual(density.shape, (21, 21))  # primal, primal
+            self.assertEqual(Bx.shape, (21, 20))  # primal, dual
+            self.assertFalse(np.isnan(density).any())
+        else:
+            self.assertEqual(density.size, 0)
+
+        # all ranks by default
+        np.testing.assert_array_equal(self.dw.lvl0IonDensity().shape, (21, 21))
+
     def tearDown(self):
         del self.dw
         if self.simulator is not None:
@@ -36,6 +36,10 @@ class SimulatorRefinedParticleNbr(unittest.TestCase):
         cellNbr = patch.upper - patch.lower + 1
         if dim == 2:
             return refined_particle_nbr * ((cellNbr[0] * 2 + (cellNbr[1] * 2)))
+        if dim == 3:
+            return refined_particle_nbr * 2 * (
+                cellNbr[0] * cellNbr[1] + cellNbr[1] * cellNbr[2] + cellNbr[0] * cellNbr[2]
+            )
         raise ValueError("Unhandled dimension for function")
 
 
@@ -117,6 +121,24 @@ class SimulatorRefinedParticleNbr(unittest.TestCase):
         This = type(self)
         self._do_dim(2, This.PREVIOUS_ITERATION_MIN_DIFF_2d, This.PREVIOUS_ITERATION_MAX_DIFF_2d)
 
+    """ 3d
+      refine the 6x6x6 coarse cells of the box [3, 8]^3, ppc 100,
+      each coarse particle being split into 8, then 27 particles
+        6 * 6 * 6 * ppc * 8  = 172800
+        6 * 6 * 6 * ppc * 27 = 583200, 583200 / 172800 = 27 / 8 = 3.375
+      MIN_DIFF: the count of the level grows as the number of refined particles, less the
+        particles split out of the patches, see _less_per_dim
+      MAX_DIFF: the count stays below 3.375 * dim * MAX_DIFF = 15.19 times the previous one,
+        as in 1d and 2d, a loose bound only catching a runaway split as the ghost particles
+        of the level are counted too, and 27 particles split further than 8 into them
+    """
+    PREVIOUS_ITERATION_MIN_DIFF_3d = 3.375
+    PREVIOUS_ITERATION_MAX_DIFF_3d = 1.50
+
+    def test_3d(self):
+        This = type(self)
+        self._do_dim(3, This.PREVIOUS_ITERATION_MIN_DIFF_3d, This.PREVIOUS_ITERATION_MAX_DIFF_3d)
+
     def tearDown(self):
         # needed in case exception is raised in test and Simulator
         # not reset properly
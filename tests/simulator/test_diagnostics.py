@@ -214,5 +214,205 @@ class DiagnosticsTest(unittest.TestCase):
         self.assertRaises(RuntimeError, dump_all_diags, model.populations)
 
 
+    def test_compression_options(self):
+        simulation = ph.Simulation(**simArgs.copy())
+        timestamps = np.arange(0, simulation.final_time, 100*simulation.time_step)
+        diag_args = {"write_timestamps": timestamps, "compute_timestamps": timestamps}
+
+        fluid = ph.FluidDiagnostics(quantity="density", **diag_args,
+                    compression={"chunk_size": 64, "deflate": 4, "shuffle": True})
+        self.assertEqual(fluid.compression["deflate"], 4)
+
+        em = ph.ElectromagDiagnostics(quantity="B", **diag_args, coarsen_ratio=4)
+        self.assertEqual(em.coarsen_ratio, 4)
+        self.assertRaises(RuntimeError, ph.ElectromagDiagnostics, quantity="E", **diag_args,
+                          coarsen_ratio=0)
+
+        for invalid in [{"level": 4}, {"deflate": 12}, {"lossy": "sz", "lossy_tolerance": 1e-3},
+                        {"lossy": "zfp"}]:
+            self.assertRaises(RuntimeError, ph.ElectromagDiagnostics, quantity="E",
+                              **diag_args, compression=invalid)
+
+
+    def test_compressed_dump_reads_back(self):
+        compression = {"chunk_size": 16, "deflate": 4, "shuffle": True}
+
+        def dump(local_out, format, **kwargs):
+            simInput = simArgs.copy()
+            simInput["diag_options"] = {"format": format,
+                                        "options": {"dir": local_out, "mode": "overwrite"}}
+            simulation = ph.Simulation(**simInput)
+            setup_model(ppc=10)
+            timestamps = np.asarray([0.])
+            ph.FluidDiagnostics(quantity="density", write_timestamps=timestamps,
+                                compute_timestamps=timestamps, **kwargs)
+            self.simulator = Simulator(simulation)
+            # HDF5 only writes compressed datasets collectively, the per patch format does not
+            if format == "phareh5" and "compression" in kwargs and cpp.mpi_size() > 1:
+                self.assertRaises(ValueError, self.simulator.setup)
+                self.simulator = None
+                ph.global_vars.sim = None
+                return None
+            self.simulator.initialize().reset()
+            self.simulator = None
+            ph.global_vars.sim = None
+            return h5py.File(os.path.join(local_out, "ions_density.h5"), "r")
+
+        for format in ["phareh5", "phareh5_aggregated"]:
+            local_out = f"{out}_{format}_mpi_n_{cpp.mpi_size()}"
+            plain = dump(f"{local_out}_plain", format)
+            compressed = dump(f"{local_out}_compressed", format, compression=compression)
+            if compressed is None:
+                continue
+
+            datasets = []
+            compressed.visititems(lambda path, obj: datasets.append(path)
+                                  if isinstance(obj, h5py.Dataset) else None)
+            self.assertGreater(len(datasets), 0)
+            for path in datasets:
+                if compressed[path].size == 0:
+                    continue # empty datasets are not chunked
+                self.assertEqual(compressed[path].compression, "gzip")
+                self.assertTrue(compressed[path].shuffle)
+                np.testing.assert_array_equal(compressed[path][:], plain[path][:])
+        ph.global_vars.sim = None
+
+
+    def test_coarsened_fields_read_back(self):
+        coarsen_ratio = 2
+
+        def dump(local_out, format, **kwargs):
+            simInput = simArgs.copy()
+            simInput["diag_options"] = {"format": format,
+                                        "options": {"dir": local_out, "mode": "overwrite"}}
+            simulation = ph.Simulation(**simInput)
+            setup_model(ppc=10)
+            timestamps = np.asarray([0.])
+            for quantity, options in kwargs.items():
+                ph.ElectromagDiagnostics(quantity=quantity, write_timestamps=timestamps,
+                                         compute_timestamps=timestamps, **options)
+            Simulator(simulation).initialize().reset()
+            ph.global_vars.sim = None
+            return [hierarchy_from(h5_filename=os.path.join(local_out, f"EM_{quantity}.h5"))
+                    for quantity in kwargs]
+
+        for format in ["phareh5", "phareh5_aggregated"]:
+            local_out = f"{out}_coarsened_{format}_mpi_n_{cpp.mpi_size()}"
+            E, B = dump(f"{local_out}_plain", format, E={},
+                        B={"coarsen_ratio": coarsen_ratio})
+            physical_E, = dump(f"{local_out}_physical", format, E={"write_ghosts": False})
+
+            for patch in B.level(0).patches:
+                np.testing.assert_allclose(patch.dl, np.asarray([simArgs["dl"]]) * coarsen_ratio)
+                Bx = patch.patch_datas["Bx"]
+                self.assertEqual(Bx.ghosts_nbr[0], 0)
+                self.assertEqual(len(Bx.x), Bx.dataset.shape[0])
+                self.assertAlmostEqual(Bx.x[0], patch.origin[0])
+                np.testing.assert_allclose(Bx.dataset[:], 1.) # bx is uniform
+
+            patches = {str(patch.box): patch for patch in E.level(0).patches}
+            for patch in physical_E.level(0).patches:
+                for name, pdata in patch.patch_datas.items():
+                    self.assertEqual(pdata.ghosts_nbr[0], 0)
+                    self.assertEqual(len(pdata.x), pdata.dataset.shape[0])
+                    ghosted = patches[str(patch.box)].patch_datas[name]
+                    ghosts = ghosted.ghosts_nbr[0]
+                    np.testing.assert_allclose(pdata.x, ghosted.x[ghosts:-ghosts])
+                    np.testing.assert_array_equal(pdata.dataset[:],
+                                                  ghosted.dataset[ghosts:-ghosts])
+
+
+    def test_reduced_diagnostics_options(self):
+        simulation = ph.Simulation(**simArgs.copy())
+        setup_model()
+        timestamps = np.arange(0, simulation.final_time, 100*simulation.time_step)
+        diag_args = {"write_timestamps": timestamps, "compute_timestamps": timestamps}
+
+        vdf = ph.ReducedDiagnostics(quantity="histogram", population_name="protons",
+                    axes=["vx", "energy"], bins=[32, 16], ranges=[(-1, 1), (0, 2)], **diag_args)
+        self.assertEqual(vdf.quantity, "/reduced/histogram0")
+        self.assertEqual(vdf.to_dict()["axes"], "vx,energy")
+        self.assertEqual(vdf.to_dict()["bins_1"], 16)
+
+        cut = ph.ReducedDiagnostics(quantity="line_cut", label="Bx_cut", field="EM_B_x",
+                    cut_axis=0, position=[5.], **diag_args)
+        self.assertEqual(cut.quantity, "/reduced/Bx_cut")
+        self.assertEqual(cut.to_dict()["position_0"], 5.)
+
+        self.assertRaises(RuntimeError, ph.ReducedDiagnostics, quantity="histogram",
+                          bin_count=4, **diag_args)
+        self.assertRaises(RuntimeError, ph.FluidDiagnostics, quantity="density", bins=[4],
+                          **diag_args)
+        ph.global_vars.sim = None
+
+
+    def test_particle_selection_options(self):
+        simulation = ph.Simulation(**simArgs.copy())
+        setup_model()
+        timestamps = np.arange(0, simulation.final_time, 100*simulation.time_step)
+        diag_args = {"write_timestamps": timestamps, "compute_timestamps": timestamps,
+                     "population_name": "protons"}
+
+        tracers = ph.ParticleDiagnostics(quantity="domain", **diag_args,
+                    selection={"fraction": .01, "boxes": [((1.,), (3.,))], "min_energy": .1})
+        self.assertEqual(tracers.selection["fraction"], .01)
+
+        for invalid in [{"every": 4}, {"stride": 0}, {"fraction": 2.},
+                        {"boxes": [((1., 1.), (3., 3.))]}]:
+            self.assertRaises(RuntimeError, ph.ParticleDiagnostics, quantity="levelGhost",
+                              **diag_args, selection=invalid)
+
+        # selections are for particles, coarsening and ghosts for fields
+        self.assertRaises(RuntimeError, ph.FluidDiagnostics, quantity="density", **diag_args,
+                          selection={"stride": 2})
+        self.assertRaises(RuntimeError, ph.ParticleDiagnostics, quantity="patchGhost",
+                          **diag_args, coarsen_ratio=2)
+        self.assertRaises(RuntimeError, ph.ParticleDiagnostics, quantity="patchGhost",
+                          **diag_args, write_ghosts=False)
+        ph.global_vars.sim = None
+
+
+    def test_particle_selection_is_stable_across_dumps(self):
+        fraction = .25
+
+        def dump(local_out, **kwargs):
+            simInput = simArgs.copy()
+            simInput.update({"time_step_nbr": 10, "final_time": .1})
+            simInput["diag_options"] = {"format": "phareh5",
+                                        "options": {"dir": local_out, "mode": "overwrite"}}
+            simulation = ph.Simulation(**simInput)
+            setup_model(ppc=10)
+            timestamps = np.asarray([0., simulation.final_time])
+            ph.ParticleDiagnostics(quantity="domain", population_name="protons",
+                                   write_timestamps=timestamps, compute_timestamps=timestamps,
+                                   **kwargs)
+            Simulator(simulation).run().reset()
+            ph.global_vars.sim = None
+
+            ids = {}
+            with h5py.File(os.path.join(local_out, "ions_pop_protons_domain.h5"), "r") as h5:
+                for time, group in h5[h5_time_grp_key].items():
+                    datasets = []
+                    group.visititems(lambda path, obj: datasets.append(obj[:].ravel())
+                                     if isinstance(obj, h5py.Dataset) and path.endswith("/id")
+                                     else None)
+                    ids[float(time)] = np.concatenate(datasets)
+            return [ids[time] for time in sorted(ids)]
+
+        local_out = f"{out}_selection_mpi_n_{cpp.mpi_size()}"
+        every = dump(f"{local_out}_every")
+        selected = dump(f"{local_out}_selected", selection={"fraction": fraction})
+
+        # a single periodic level: no particle is created or lost between the dumps
+        for ids in every + selected:
+            self.assertEqual(len(np.unique(ids)), len(ids))
+        self.assertEqual(set(every[0]), set(every[1]))
+
+        # the particles selected are the same at every dump, whatever their motion
+        self.assertEqual(set(selected[0]), set(selected[1]))
+        self.assertTrue(set(selected[0]) < set(every[0]))
+        self.assertLess(abs(len(selected[0]) / len(every[0]) - fraction), .1)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -6,7 +6,7 @@ import numpy as np
 
 from ddt import ddt, data, unpack
 
-from pyphare.cpp import cpp_lib
+from pyphare.cpp import cpp_lib, cpp_etc_lib
 cpp = cpp_lib()
 
 import pyphare.pharein as ph
@@ -76,6 +76,14 @@ def dup(dic):
     dic.update(copy.deepcopy(simArgs))
     return dic
 
+def native(dic):
+    dic["restart_options"]["format"] = "phareh5"
+    return dic
+
+def asynchronous(dic):
+    dic["restart_options"]["async"] = True
+    return dic
+
 
 @ddt
 class RestartsTest(SimulatorTest):
@@ -103,6 +111,8 @@ class RestartsTest(SimulatorTest):
           refinement="tagging",
       )), expected_num_levels=3),
       *permute(dup(dict()), expected_num_levels=2), # refinement boxes set later
+      *permute(native(dup(dict())), expected_num_levels=2),
+      *permute(asynchronous(native(dup(dict()))), expected_num_levels=2),
     )
     @unpack
     def test_restarts(self, dim, interp, simInput, expected_num_levels):
@@ -243,6 +253,150 @@ class RestartsTest(SimulatorTest):
 
 
 
+    @data(dup(dict()), asynchronous(native(dup(dict()))))
+    def test_keep(self, simput, dim = 1):
+        print(f"test_keep dim:{dim}")
+        import os
+
+        for key in ["cells", "dl", "boundary_types"]:
+            simput[key] = [simput[key]] * dim
+
+        local_out = f"{out}/keep/{dim}/mpi_n/{cpp.mpi_size()}/id{self.ddt_test_id()}"
+        self.register_diag_dir_for_cleanup(local_out)
+
+        timestamps = [timestep * i for i in range(1, 5)]
+        simput["restart_options"].update(dir=local_out, timestamps=timestamps, keep=2)
+        ph.global_vars.sim = ph.Simulation(**simput)
+        model = setup_model()
+        Simulator(ph.global_vars.sim).run().reset()
+
+        # asynchronous restarts are pruned as well once the simulator drains at its end
+        for time in timestamps:
+            restart_dir = cpp_etc_lib().restart_path_for_time(local_out, time)
+            self.assertEqual(os.path.exists(restart_dir), time in timestamps[-2:])
+
+
+
+    @data(
+      ({"elapsed_interval": 1e-6}, [timestep * i for i in range(6)]), # each dump is late
+      ({"time_limit": 1e-6}, [0.]),  # a single restart, at the first dump
+      ({"time_limit": 1e6}, []),     # the limit is never close
+    )
+    @unpack
+    def test_wall_clock_triggers(self, trigger, expected, dim = 1):
+        print(f"test_wall_clock_triggers {trigger}")
+        import os
+
+        simput = dup(dict())
+        for key in ["cells", "dl", "boundary_types"]:
+            simput[key] = [simput[key]] * dim
+
+        local_out = f"{out}/wall_clock/{dim}/mpi_n/{cpp.mpi_size()}/id{self.ddt_test_id()}"
+        self.register_diag_dir_for_cleanup(local_out)
+
+        simput["restart_options"] = dict(dir=local_out, mode="overwrite", **trigger)
+        ph.global_vars.sim = ph.Simulation(**simput)
+        self.assertEqual(len(ph.global_vars.sim.restart_options["timestamps"]), 0)
+        model = setup_model()
+        Simulator(ph.global_vars.sim).run().reset()
+
+        for time in [timestep * i for i in range(6)]:
+            restart_dir = cpp_etc_lib().restart_path_for_time(local_out, time)
+            self.assertEqual(os.path.exists(restart_dir), time in expected)
+
+
+
+    # the native format is read whatever the number of ranks that wrote it, see CMakeLists.txt
+    #  where the first test is run with N ranks and the second one with M, on the same directory
+    #  run together, as part of this file, both have the same number of ranks
+    n_to_m_out = f"{out}/n_to_m"
+
+    def n_to_m_simput(self, dim = 1):
+        simput = native(dup(dict()))
+        for key in ["cells", "dl", "boundary_types"]:
+            simput[key] = [simput[key]] * dim
+        simput["refinement_boxes"] = {"L0": {"B0": [[10] * dim, [19] * dim]}}
+        return simput
+
+
+    def test_native_n_to_m_1_write(self):
+        print(f"test_native_n_to_m_1_write mpi_n:{cpp.mpi_size()}")
+
+        simput = self.n_to_m_simput()
+        local_out = f"{self.n_to_m_out}/write"
+        simput["restart_options"]["dir"] = self.n_to_m_out
+        simput["diag_options"]["options"]["dir"] = local_out
+        ph.global_vars.sim = ph.Simulation(**simput)
+        model = setup_model()
+        dump_all_diags(model.populations, timestamps=np.array([timestep * 4, timestep * 5]))
+        Simulator(ph.global_vars.sim).run().reset()
+
+
+    def test_native_n_to_m_2_read(self):
+        print(f"test_native_n_to_m_2_read mpi_n:{cpp.mpi_size()}")
+
+        simput = self.n_to_m_simput()
+        diag_dir0 = f"{self.n_to_m_out}/write"
+        diag_dir1 = f"{self.n_to_m_out}/read/mpi_n/{cpp.mpi_size()}"
+        self.register_diag_dir_for_cleanup(diag_dir1)
+
+        simput["restart_options"].update(dir=self.n_to_m_out, restart_time=timestep * 4)
+        simput["restart_options"].pop("timestamps") # others may read the same restart concurrently
+        simput["diag_options"]["options"]["dir"] = diag_dir1
+        ph.global_vars.sim = ph.Simulation(**simput)
+        model = setup_model()
+        dump_all_diags(model.populations, timestamps=np.array([timestep * 4, timestep * 5]))
+        Simulator(ph.global_vars.sim).run().reset()
+
+        # patches differ with the number of ranks, values are compared per level and AMR index
+        def field_values(hier):
+            values = {}
+            for ilvl, lvl in hier.patch_levels.items():
+                for patch in lvl.patches:
+                    for key, pd in patch.patch_datas.items():
+                        data = np.asarray(pd[patch.box])
+                        for i, value in enumerate(data):
+                            values[(ilvl, key, patch.box.lower[0] + i)] = value
+            return values
+
+        def particle_values(hier):
+            values = {}
+            for ilvl, lvl in hier.patch_levels.items():
+                for patch in lvl.patches:
+                    for key, pd in patch.patch_datas.items():
+                        p = pd.dataset
+                        columns = [p.iCells, p.deltas, p.v, p.weights[:, None]]
+                        values.setdefault((ilvl, key), []).append(np.hstack(columns))
+            for key, arrays in values.items():
+                array = np.concatenate(arrays)
+                values[key] = array[np.lexsort(array.T[::-1])]
+            return values
+
+        def check(values0, values1, checker):
+            self.assertGreater(len(values0), 0)
+            self.assertEqual(sorted(values0.keys()), sorted(values1.keys()))
+            for key, value0 in values0.items():
+                checker(value0, values1[key])
+
+        pops = model.populations
+        run0, run1 = Run(diag_dir0), Run(diag_dir1)
+
+        # the restarted state is the saved one, the next step only differs in summation order
+        for time, checker in [
+            (timestep * 4, np.testing.assert_equal),
+            (timestep * 5, lambda v0, v1: np.testing.assert_allclose(v0, v1, rtol=1e-10, atol=1e-12)),
+        ]:
+            for getter in [run0.GetB, run0.GetE, run0.GetNi, run0.GetVi]:
+                other = getattr(run1, getter.__name__)
+                check(field_values(getter(time)), field_values(other(time)), checker)
+            check(
+                particle_values(run0.GetParticles(time, pops)),
+                particle_values(run1.GetParticles(time, pops)),
+                checker,
+            )
+
+
+
 
 
 
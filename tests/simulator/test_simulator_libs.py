@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+
+# -DsimulatorLibs=ON, the modules cpp_<dim>_<interp> can be imported together
+
+import unittest
+import importlib
+
+from pyphare.cpp import cpp_lib, cpp_etc_lib
+import pyphare.pharein as ph
+
+
+def built_simulator_libs():
+    libs = []
+    for dim in [1, 2, 3]:
+        for interp in [1, 2, 3]:
+            try:
+                libs.append(importlib.import_module(f"pybindlibs.cpp_{dim}_{interp}"))
+            except ModuleNotFoundError:
+                pass
+    return libs
+
+
+class SimulatorLibsTest(unittest.TestCase):
+
+    def test_simulator_libs_share_the_essential_types(self):
+        libs = built_simulator_libs()
+        self.assertGreater(len(libs), 0)
+        etc = cpp_etc_lib()
+        for lib in libs:
+            for name in ["SamraiLifeCycle", "AMRHierarchy", "ContiguousParticles_1", "mpi_rank"]:
+                self.assertIs(getattr(lib, name), getattr(etc, name))
+            self.assertEqual(lib.mpi_rank(), etc.mpi_rank())
+
+    def test_cpp_lib_is_the_module_of_the_simulation(self):
+        for lib in built_simulator_libs():
+            dim, interp = [int(i) for i in lib.__name__.split("_")[-2:]]
+            ph.global_vars.sim = None
+            ph.Simulation(time_step_nbr=1, final_time=.1, boundary_types=["periodic"] * dim,
+                          cells=[20] * dim, dl=[.1] * dim, interp_order=interp)
+            self.assertIs(cpp_lib(), lib)
+        ph.global_vars.sim = None
+
+
+if __name__ == "__main__":
+    unittest.main()
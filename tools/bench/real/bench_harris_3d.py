@@ -0,0 +1,60 @@
+# the module cpp_sim_3_1_8 is only built with single precision particles, -DparticleFloats=ON,
+#  which halves the memory of the deltas and velocities of the 3D particles
+
+import numpy as np
+from pyphare.cpp import cpp_lib # must be first
+try:
+    cpp_lib("pybindlibs.cpp_sim_3_1_8")
+except ModuleNotFoundError as err:
+    raise RuntimeError("bench_harris_3d needs PHARE built with -DparticleFloats=ON") from err
+import pyphare.pharein as ph
+from pyphare.pharein import profiles
+
+# profiles are evaluated in C++, initializing the patches of 3D domains needs no python callback
+seed = 133333333337
+cells, dl = 40, .5
+patch_sizes = [20,40]
+diag_outputs="tools/bench/real/harris_3d/outputs"
+L = cells * dl
+centers = [L * 0.3, L * 0.7]
+
+density = profiles.harris(axis=1, centers=centers, width=0.5, background=0.2)
+bx = profiles.harris(axis=1, centers=centers, width=0.5, kind="field", background=-1)
+zero = profiles.uniform(0.)
+vth = profiles.uniform(np.sqrt(.5))
+
+def config():
+    ph.Simulation(# strict=True,
+        smallest_patch_size=patch_sizes[0], largest_patch_size=patch_sizes[1],
+        time_step_nbr=10, time_step=0.001,
+        cells=[cells] * 3, dl=[dl] * 3,
+        resistivity=0.001, hyper_resistivity=0.001,
+        diag_options={"format": "phareh5", "options": {"dir": diag_outputs, "mode":"overwrite"}},
+        refinement_boxes={},
+    )
+    ph.MaxwellianFluidModel( bx=bx, by=zero, bz=zero,
+        protons={"charge": 1, "density": density, "init":{"seed": seed},
+          **{ "nbr_part_per_cell":100,
+            "vbulkx": zero, "vbulky": zero, "vbulkz": zero,
+            "vthx": vth, "vthy": vth, "vthz": vth,
+          }
+        },
+    )
+    ph.ElectronModel(closure="isothermal", Te=0.0)
+
+    from tests.diagnostic import all_timestamps
+    timestamps = all_timestamps(ph.global_vars.sim)
+    timestamps = np.asarray([timestamps[0], timestamps[-1]])
+    for quantity in ["E", "B"]:
+        ph.ElectromagDiagnostics(
+            quantity=quantity,
+            write_timestamps=timestamps,
+            compute_timestamps=timestamps,
+        )
+
+if ph.PHARE_EXE or __name__=="__main__":
+    config()
+
+if __name__=="__main__":
+    from pyphare.simulator.simulator import Simulator
+    Simulator(ph.global_vars.sim).run()
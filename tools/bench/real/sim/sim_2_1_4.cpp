@@ -10,7 +10,7 @@ PYBIND11_MODULE(cpp_sim_2_1_4, m)
     using interp       = std::integral_constant<std::size_t, 1>;
     using nbRefinePart = std::integral_constant<std::size_t, 4>;
 
-    declare_essential(m);
+    import_essential(m);
     declare_sim<dim, interp, nbRefinePart>(m);
 }
 } // namespace PHARE::pydata
@@ -0,0 +1,17 @@
+
+
+
+#include "python3/cpp_simulator.hpp"
+
+namespace PHARE::pydata
+{
+PYBIND11_MODULE(cpp_sim_3_1_8, m)
+{
+    using dim          = std::integral_constant<std::size_t, 3>;
+    using interp       = std::integral_constant<std::size_t, 1>;
+    using nbRefinePart = std::integral_constant<std::size_t, 8>;
+
+    import_essential(m);
+    declare_sim<dim, interp, nbRefinePart>(m);
+}
+} // namespace PHARE::pydata